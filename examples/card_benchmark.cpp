@@ -0,0 +1,121 @@
+/**
+ * @file card_benchmark.cpp
+ * @brief Measures copying and querying a 100k-card inventory
+ *
+ * Compares Card's inline AttributeSet with the previous
+ * unordered_map<AttributeType, float> layout (reproduced as MapCard).
+ */
+
+#include "Core/Card.h"
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+// Previous card layout: attributes in a hash map
+struct MapCard {
+    std::string name;
+    int rarity;
+    int quantity;
+    CardType type;
+    std::unordered_map<AttributeType, float> attributes;
+
+    float getAttribute(AttributeType attrType) const {
+        auto it = attributes.find(attrType);
+        return (it != attributes.end()) ? it->second : 0.0f;
+    }
+
+    bool hasAttribute(AttributeType attrType) const {
+        return attributes.find(attrType) != attributes.end();
+    }
+};
+
+const size_t CARD_COUNT = 100000;
+const int ITERATIONS = 10;
+
+double timeMs(const std::function<void()>& fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+// Four attributes per card, matching the typical CardFactory materials
+const AttributeType SAMPLE_ATTRIBUTES[] = {
+    AttributeType::WEIGHT, AttributeType::DURABILITY,
+    AttributeType::CRAFTING_VALUE, AttributeType::TRADE_VALUE
+};
+
+template <typename CardT>
+float queryAll(const std::vector<CardT>& cards) {
+    float total = 0.0f;
+    for (const auto& card : cards) {
+        total += card.getAttribute(AttributeType::WEIGHT) * card.quantity;
+        if (card.hasAttribute(AttributeType::BURN_VALUE)) {
+            total += card.getAttribute(AttributeType::BURN_VALUE);
+        }
+    }
+    return total;
+}
+
+template <typename CardT>
+void runSuite(const std::string& label, const std::vector<CardT>& cards) {
+    size_t copiedSize = 0;
+    double copyMs = timeMs([&]() {
+        for (int i = 0; i < ITERATIONS; ++i) {
+            std::vector<CardT> copy = cards;
+            copiedSize += copy.size();
+        }
+    }) / ITERATIONS;
+
+    volatile float sink = 0.0f;
+    double queryMs = timeMs([&]() {
+        for (int i = 0; i < ITERATIONS; ++i) {
+            sink = sink + queryAll(cards);
+        }
+    }) / ITERATIONS;
+
+    std::cout << std::left << std::setw(16) << label
+              << std::right << std::setw(10) << sizeof(CardT)
+              << std::setw(14) << std::fixed << std::setprecision(3) << copyMs
+              << std::setw(14) << queryMs
+              << std::setw(10) << (copiedSize == cards.size() * ITERATIONS ? "ok" : "?") << std::endl;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Card Copy/Query Benchmark (" << CARD_COUNT << " cards) ===" << std::endl;
+
+    std::vector<Card> cards;
+    std::vector<MapCard> mapCards;
+    cards.reserve(CARD_COUNT);
+    mapCards.reserve(CARD_COUNT);
+    for (size_t i = 0; i < CARD_COUNT; ++i) {
+        std::string name = "Mat" + std::to_string(i % 1000);
+        Card card(name, static_cast<int>(i % 3) + 1, static_cast<CardType>(i % 9), 3);
+        MapCard mapCard{name, card.rarity, card.quantity, card.type, {}};
+        for (AttributeType attr : SAMPLE_ATTRIBUTES) {
+            float value = static_cast<float>(i % 17) + 0.5f;
+            card.setAttribute(attr, value);
+            mapCard.attributes[attr] = value;
+        }
+        cards.push_back(card);
+        mapCards.push_back(mapCard);
+    }
+
+    std::cout << std::left << std::setw(16) << "layout"
+              << std::right << std::setw(10) << "bytes"
+              << std::setw(14) << "copy ms"
+              << std::setw(14) << "query ms"
+              << std::setw(10) << "check" << std::endl;
+    runSuite("unordered_map", mapCards);
+    runSuite("AttributeSet", cards);
+
+    return 0;
+}
@@ -0,0 +1,40 @@
+/**
+ * @file compile_data_pack.cpp
+ * @brief Compiles the JSON game data into the binary pack loaded at startup
+ *
+ * Parses and validates game_config, materials, recipes and events from the
+ * data directory (default data/) and writes game_data.pack next to them.
+ * Run it after editing the JSON; until then the game notices the stale pack
+ * and reads the JSON instead. An up-to-date pack is verified against its
+ * payload hash, which the game skips at startup, and rebuilt if damaged.
+ */
+
+#include "Systems/DataManager.h"
+#include "Systems/DataPack.h"
+#include <iostream>
+#include <string>
+
+int main(int argc, char* argv[]) {
+    std::string dataDirectory = argc >= 2 ? argv[1] : "data/";
+    if (!dataDirectory.empty() && dataDirectory.back() != '/') {
+        dataDirectory += '/';
+    }
+
+    // Startup skips the payload hash, so a damaged pack is caught here
+    std::string packPath = dataDirectory + DataPack::FILE_NAME;
+    {
+        DataPack existing;
+        std::string error;
+        if (existing.open(packPath, error)) {
+            if (!existing.verify(error)) {
+                std::cerr << error << ", rebuilding it" << std::endl;
+            } else if (existing.isCurrent(dataDirectory)) {
+                std::cout << packPath << " is up to date" << std::endl;
+                return 0;
+            }
+        }
+    }
+
+    // Parses and validates the JSON itself, and refuses data that fails
+    return DataManagement::GameDataManager::compileDataPack(dataDirectory) ? 0 : 1;
+}
@@ -0,0 +1,152 @@
+/**
+ * @file crafting_benchmark.cpp
+ * @brief Measures checking every recipe of a synthetic 10k-recipe set for availability
+ *
+ * Compares the previous per-recipe check (one InventoryBatch validated
+ * against the inventory per recipe) with the compiled bulk pass over a
+ * per-material count vector, and with CraftingSystem's cached state after
+ * a single inventory change.
+ */
+
+#include "Systems/CraftingSystem.h"
+#include "Systems/CompiledRecipes.h"
+#include "Core/Inventory.h"
+#include "Core/Card.h"
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+const size_t MATERIAL_COUNT = 500;
+const int RARITIES = 3;
+const int ITERATIONS = 20;
+
+double timeUs(const std::function<void()>& fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count();
+}
+
+std::string materialName(size_t index) {
+    return "Material_" + std::to_string(index);
+}
+
+std::vector<Recipe> makeRecipes(size_t count, std::mt19937& gen) {
+    std::uniform_int_distribution<size_t> materialDist(0, MATERIAL_COUNT - 1);
+    std::uniform_int_distribution<int> ingredientDist(1, 4);
+    std::uniform_int_distribution<int> quantityDist(1, 6);
+    std::uniform_int_distribution<int> rarityDist(1, RARITIES);
+
+    std::vector<Recipe> recipes;
+    recipes.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        std::vector<std::pair<Card, int>> ingredients;
+        int ingredientCount = ingredientDist(gen);
+        for (int j = 0; j < ingredientCount; ++j) {
+            ingredients.push_back({Card(materialName(materialDist(gen)), rarityDist(gen), CardType::MISC),
+                                   quantityDist(gen)});
+        }
+        recipes.emplace_back("recipe_" + std::to_string(i), "Recipe " + std::to_string(i), "",
+                             ingredients, Card("Product_" + std::to_string(i), 1, CardType::MISC));
+    }
+    return recipes;
+}
+
+void fillInventory(Inventory& inventory, std::mt19937& gen) {
+    std::uniform_int_distribution<int> quantityDist(0, 8);
+    for (size_t m = 0; m < MATERIAL_COUNT; ++m) {
+        for (int rarity = 1; rarity <= RARITIES; ++rarity) {
+            int quantity = quantityDist(gen);
+            if (quantity > 0) {
+                inventory.addCard(Card(materialName(m), rarity, CardType::MISC, quantity));
+            }
+        }
+    }
+}
+
+// Previous check: one batch validated against the inventory per recipe
+size_t countByBatch(const std::vector<Recipe>& recipes, const Inventory& inventory) {
+    size_t craftable = 0;
+    for (const auto& recipe : recipes) {
+        InventoryBatch batch;
+        for (const auto& ingredient : recipe.ingredients) {
+            batch.removeAnyRarity(ingredient.first.materialId, ingredient.second, ingredient.first.rarity);
+        }
+        craftable += inventory.canApply(batch);
+    }
+    return craftable;
+}
+
+void printRow(const std::string& label, double totalUs, size_t craftable) {
+    std::cout << std::left << std::setw(30) << label
+              << std::right << std::setw(14) << std::fixed << std::setprecision(1) << totalUs / ITERATIONS
+              << std::setw(12) << craftable << std::endl;
+}
+
+} // namespace
+
+int main() {
+    std::mt19937 gen(42);
+    Inventory inventory;
+    fillInventory(inventory, gen);
+
+    std::cout << "=== Crafting Benchmark ===" << std::endl;
+    for (size_t recipeCount = 1000; recipeCount <= 10000; recipeCount *= 10) {
+        std::vector<Recipe> recipes = makeRecipes(recipeCount, gen);
+        std::cout << std::endl << recipeCount << " recipes, " << inventory.getCards().size() << " stacks" << std::endl;
+        std::cout << std::left << std::setw(30) << "check"
+                  << std::right << std::setw(14) << "us/sweep"
+                  << std::setw(12) << "craftable" << std::endl;
+
+        size_t craftable = 0;
+        double total = timeUs([&]() {
+            for (int i = 0; i < ITERATIONS; ++i) craftable = countByBatch(recipes, inventory);
+        });
+        printRow("batch per recipe", total, craftable);
+
+        CompiledRecipes compiled;
+        compiled.compile(recipes);
+        std::vector<int32_t> counts(compiled.materialSlots(), 0);
+        for (const auto& card : inventory.getCards()) {
+            if (card.materialId < counts.size()) counts[card.materialId] += card.quantity;
+        }
+        std::vector<uint8_t> flags;
+        total = timeUs([&]() {
+            for (int i = 0; i < ITERATIONS; ++i) compiled.canCraftAll(counts, flags);
+        });
+        craftable = 0;
+        for (uint8_t flag : flags) craftable += flag;
+        printRow("compiled canCraftAll", total, craftable);
+
+        std::vector<int32_t> maxCrafts;
+        total = timeUs([&]() {
+            for (int i = 0; i < ITERATIONS; ++i) compiled.maxCraftsAll(counts, maxCrafts);
+        });
+        printRow("compiled maxCraftsAll", total, craftable);
+
+        // Cached: each sweep follows one inventory change, then reads every flag
+        CraftingSystem craftingSystem;
+        craftingSystem.clearRecipes();
+        for (const auto& recipe : recipes) craftingSystem.addRecipe(recipe);
+        craftingSystem.getAvailableRecipes(inventory);
+        Card extra(materialName(0), 1, CardType::MISC, 1);
+        total = timeUs([&]() {
+            for (int i = 0; i < ITERATIONS; ++i) {
+                inventory.addCard(extra);
+                craftable = 0;
+                for (size_t r = 0; r < recipes.size(); ++r) {
+                    craftable += craftingSystem.isCraftable(r, inventory);
+                }
+            }
+        });
+        printRow("cached, one change per sweep", total, craftable);
+    }
+
+    return 0;
+}
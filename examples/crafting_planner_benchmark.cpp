@@ -0,0 +1,143 @@
+/**
+ * @file crafting_planner_benchmark.cpp
+ * @brief Measures the crafting planner on a synthetic 10k-recipe producer graph
+ *
+ * Products are built from raw materials and earlier products, several layers
+ * deep; one recipe in ten is an alternative that makes an earlier product from
+ * a later one, which closes cycles. Times building the producer graph, planning
+ * deep recipes against a fresh inventory version, and re-planning from cache.
+ */
+
+#include "Systems/CraftingPlanner.h"
+#include "Systems/CraftingSystem.h"
+#include "Core/Inventory.h"
+#include "Core/Card.h"
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+const size_t RAW_COUNT = 200;
+const size_t PLANS = 200;
+const int ITERATIONS = 10;
+
+double timeUs(const std::function<void()>& fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count();
+}
+
+Card rawCard(size_t index, int quantity = 1) {
+    return Card("Raw_" + std::to_string(index), 1, CardType::MISC, quantity);
+}
+
+Card productCard(size_t index, int quantity = 1) {
+    return Card("Product_" + std::to_string(index), 1, CardType::MISC, quantity);
+}
+
+void addRecipes(CraftingSystem& craftingSystem, size_t count, std::mt19937& gen) {
+    std::uniform_int_distribution<int> ingredientDist(1, 4);
+    std::uniform_int_distribution<int> quantityDist(1, 3);
+    std::uniform_int_distribution<size_t> rawDist(0, RAW_COUNT - 1);
+    std::uniform_real_distribution<float> rateDist(0.5f, 1.0f);
+
+    size_t products = 0;
+    for (size_t i = 0; i < count; ++i) {
+        std::vector<std::pair<Card, int>> ingredients;
+        int ingredientCount = ingredientDist(gen);
+        bool alternative = products > 10 && i % 10 == 9;
+        for (int j = 0; j < ingredientCount; ++j) {
+            // Mostly recent products, so chains run many layers deep
+            bool useProduct = products > 0 && gen() % 3 != 0;
+            if (useProduct) {
+                size_t window = std::min<size_t>(products, 50);
+                size_t product = products - 1 - gen() % window;
+                ingredients.push_back({productCard(product), quantityDist(gen)});
+            } else {
+                ingredients.push_back({rawCard(rawDist(gen)), quantityDist(gen)});
+            }
+        }
+
+        // Alternatives make an older product from newer ones: a cycle
+        size_t output = alternative ? gen() % (products / 2) : products++;
+        craftingSystem.addRecipe(Recipe("recipe_" + std::to_string(i), "Recipe " + std::to_string(i), "",
+                                        ingredients, productCard(output, 1 + static_cast<int>(gen() % 2)),
+                                        rateDist(gen)));
+    }
+}
+
+void printRow(const std::string& label, double totalUs, size_t operations) {
+    std::cout << std::left << std::setw(32) << label
+              << std::right << std::setw(14) << std::fixed << std::setprecision(2) << totalUs / operations
+              << std::endl;
+}
+
+} // namespace
+
+int main() {
+    std::mt19937 gen(42);
+    std::cout << "=== Crafting Planner Benchmark ===" << std::endl;
+
+    for (size_t recipeCount = 1000; recipeCount <= 10000; recipeCount *= 10) {
+        CraftingSystem craftingSystem;
+        craftingSystem.clearRecipes();
+        addRecipes(craftingSystem, recipeCount, gen);
+        Inventory inventory;
+        for (size_t m = 0; m < RAW_COUNT; m += 2) {
+            inventory.addCard(rawCard(m, 20));
+        }
+
+        std::vector<std::string> targets;
+        for (size_t i = 0; i < PLANS; ++i) {
+            targets.push_back("recipe_" + std::to_string(recipeCount - 1 - i * (recipeCount / PLANS)));
+        }
+
+        std::cout << std::endl << recipeCount << " recipes" << std::endl;
+        std::cout << std::left << std::setw(32) << "operation"
+                  << std::right << std::setw(14) << "us/op" << std::endl;
+
+        double total = timeUs([&]() {
+            for (int i = 0; i < ITERATIONS; ++i) {
+                CraftingPlanner planner(craftingSystem);
+                planner.unitCost(0);
+            }
+        });
+        printRow("build producer graph", total, ITERATIONS);
+
+        CraftingPlanner planner(craftingSystem);
+        size_t steps = 0;
+        size_t feasible = 0;
+        total = timeUs([&]() {
+            for (int i = 0; i < ITERATIONS; ++i) {
+                // Each round starts from a new inventory version
+                inventory.addCard(rawCard(1));
+                for (const auto& target : targets) {
+                    const CraftingPlan& plan = planner.plan(target, 5, inventory);
+                    steps += plan.steps.size();
+                    feasible += plan.feasible;
+                }
+            }
+        });
+        printRow("plan, inventory changed", total, ITERATIONS * PLANS);
+
+        total = timeUs([&]() {
+            for (int i = 0; i < ITERATIONS; ++i) {
+                for (const auto& target : targets) {
+                    steps += planner.plan(target, 5, inventory).steps.size();
+                }
+            }
+        });
+        printRow("plan, cached", total, ITERATIONS * PLANS);
+
+        std::cout << "average steps per plan: " << steps / (2 * ITERATIONS * PLANS)
+                  << ", feasible: " << feasible / ITERATIONS << "/" << PLANS << std::endl;
+    }
+
+    return 0;
+}
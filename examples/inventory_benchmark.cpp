@@ -0,0 +1,129 @@
+/**
+ * @file inventory_benchmark.cpp
+ * @brief Measures Inventory insert/merge/lookup/remove cost from 10 to 1M stacks
+ *
+ * A copy of the previous linear-scan inventory is timed alongside for the
+ * sizes where it still finishes in reasonable time.
+ */
+
+#include "Core/Inventory.h"
+#include "Core/Card.h"
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Previous implementation: linear scan with string compares
+class LinearInventory {
+public:
+    void addCard(const Card& card) {
+        for (auto& c : cards) {
+            if (c.name == card.name && c.rarity == card.rarity) {
+                c.quantity += card.quantity;
+                return;
+            }
+        }
+        cards.push_back(card);
+    }
+
+    void removeCard(const std::string& name, int rarity) {
+        for (auto it = cards.begin(); it != cards.end(); ++it) {
+            if (it->name == name && it->rarity == rarity) {
+                if (it->quantity > 1) {
+                    it->quantity--;
+                } else {
+                    cards.erase(it);
+                }
+                return;
+            }
+        }
+    }
+
+private:
+    std::vector<Card> cards;
+};
+
+const size_t LINEAR_LIMIT = 10000;
+
+double timeMs(const std::function<void()>& fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+std::vector<Card> makeCards(size_t count) {
+    std::vector<Card> cards;
+    cards.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        cards.emplace_back("Material_" + std::to_string(i / 5), static_cast<int>(i % 5) + 1,
+                           static_cast<CardType>(i % 9), 2);
+    }
+    return cards;
+}
+
+template <typename InventoryT>
+void runSuite(const std::vector<Card>& cards, double results[4]) {
+    InventoryT inventory;
+    results[0] = timeMs([&]() {
+        for (const auto& card : cards) inventory.addCard(card);
+    });
+    results[1] = timeMs([&]() {
+        for (const auto& card : cards) inventory.addCard(card);
+    });
+    // Three decrements per stack: 4 -> 3 -> 2 -> 1
+    results[2] = timeMs([&]() {
+        for (int pass = 0; pass < 3; ++pass) {
+            for (const auto& card : cards) inventory.removeCard(card.name, card.rarity);
+        }
+    });
+    // Remove the last stack first so both implementations erase from the tail
+    results[3] = timeMs([&]() {
+        for (auto it = cards.rbegin(); it != cards.rend(); ++it) {
+            inventory.removeCard(it->name, it->rarity);
+        }
+    });
+}
+
+void printRow(const std::string& label, size_t stacks, const double results[4]) {
+    double perOp = (results[0] + results[1] + results[2] + results[3]) * 1e6 / (stacks * 6.0);
+    std::cout << std::left << std::setw(8) << label
+              << std::right << std::setw(10) << stacks
+              << std::setw(14) << std::fixed << std::setprecision(3) << results[0]
+              << std::setw(14) << results[1]
+              << std::setw(14) << results[2]
+              << std::setw(14) << results[3]
+              << std::setw(14) << std::setprecision(1) << perOp << std::endl;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Inventory Benchmark ===" << std::endl;
+    std::cout << std::left << std::setw(8) << "impl"
+              << std::right << std::setw(10) << "stacks"
+              << std::setw(14) << "insert ms"
+              << std::setw(14) << "merge ms"
+              << std::setw(14) << "decrement ms"
+              << std::setw(14) << "erase ms"
+              << std::setw(14) << "ns/op" << std::endl;
+
+    for (size_t stacks = 10; stacks <= 1000000; stacks *= 10) {
+        std::vector<Card> cards = makeCards(stacks);
+        double results[4];
+
+        runSuite<Inventory>(cards, results);
+        printRow("hashed", stacks, results);
+
+        if (stacks <= LINEAR_LIMIT) {
+            runSuite<LinearInventory>(cards, results);
+            printRow("linear", stacks, results);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,115 @@
+/**
+ * @file loot_benchmark.cpp
+ * @brief Measures exploration rolls as a balancing simulation runs them
+ *
+ * Compares the previous exploration roll (a cumulative-probability walk over
+ * Event copies with Card rewards) with the compiled alias tables, both one
+ * sample() per roll and sampleN() adding up totals, for event lists of
+ * growing size.
+ */
+
+#include "Systems/LootTables.h"
+#include "Core/Inventory.h"
+#include "Core/Random.h"
+#include "Core/Event.h"
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+const size_t ROLLS = 200000;
+
+double timeUs(const std::function<void()>& fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count();
+}
+
+std::vector<Event> makeEvents(size_t count, Rng& rng) {
+    std::vector<Event> events;
+    float total = 0.0f;
+    std::vector<float> weights;
+    for (size_t i = 0; i < count; ++i) {
+        weights.push_back(0.1f + rng.nextFloat());
+        total += weights.back();
+    }
+    for (size_t i = 0; i < count; ++i) {
+        std::vector<Card> rewards;
+        for (int r = 0; r < 2; ++r) {
+            rewards.push_back(Card("Loot_" + std::to_string(rng.nextInt(0, 99)), 1, CardType::MISC, rng.nextInt(1, 3)));
+        }
+        events.emplace_back("Event " + std::to_string(i), rewards, std::vector<Card>{}, weights[i] / total);
+    }
+    return events;
+}
+
+// Previous roll: walk cumulative probabilities and copy the event's cards
+size_t rollByWalk(const std::vector<Event>& events, Rng& rng) {
+    size_t units = 0;
+    for (size_t i = 0; i < ROLLS; ++i) {
+        float roll = rng.nextFloat();
+        float cumulative = 0.0f;
+        for (const auto& event : events) {
+            cumulative += event.probability;
+            if (roll <= cumulative) {
+                std::vector<Card> rewards = event.rewards;
+                for (const auto& card : rewards) units += card.quantity;
+                break;
+            }
+        }
+    }
+    return units;
+}
+
+void printRow(const std::string& label, double totalUs, size_t units) {
+    std::cout << std::left << std::setw(24) << label
+              << std::right << std::setw(14) << std::fixed << std::setprecision(1) << totalUs * 1000.0 / ROLLS
+              << std::setw(12) << units << std::endl;
+}
+
+} // namespace
+
+int main() {
+    Rng rng(42);
+    Inventory inventory;
+
+    std::cout << "=== Loot Benchmark ===" << std::endl;
+    for (size_t eventCount = 10; eventCount <= 1000; eventCount *= 10) {
+        std::vector<Event> events = makeEvents(eventCount, rng);
+        LootTables loot;
+        loot.compileEvents(events);
+        uint32_t exploration = loot.findTable(LootTables::EXPLORATION);
+
+        std::cout << std::endl << eventCount << " events, " << ROLLS << " rolls" << std::endl;
+        std::cout << std::left << std::setw(24) << "roll"
+                  << std::right << std::setw(14) << "ns/roll"
+                  << std::setw(12) << "units" << std::endl;
+
+        size_t units = 0;
+        double total = timeUs([&]() { units = rollByWalk(events, rng); });
+        printRow("cumulative walk", total, units);
+
+        LootResult result;
+        total = timeUs([&]() {
+            units = 0;
+            for (size_t i = 0; i < ROLLS; ++i) {
+                result.clear();
+                loot.sample(exploration, rng, inventory, result);
+                for (const auto& drop : result.gained) units += drop.quantity;
+            }
+        });
+        printRow("alias sample", total, units);
+
+        LootTotals totals;
+        total = timeUs([&]() { loot.sampleN(exploration, ROLLS, rng, inventory, totals); });
+        units = 0;
+        for (int64_t gained : totals.gained) units += gained;
+        printRow("alias sampleN", total, units);
+    }
+    return 0;
+}
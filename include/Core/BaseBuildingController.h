@@ -2,8 +2,9 @@
 #include "Core/BaseManager.h"
 #include "Core/Inventory.h"
 #include "Core/Card.h"
+#include "Core/GameEvents.h"
+#include "Core/TimerWheel.h"
 #include <mutex>
-#include <thread>
 #include <atomic>
 #include <chrono>
 #include <functional>
@@ -12,7 +13,11 @@
  * Controller for base building operations
  * Handles drag-and-drop logic for cards to base area
  * Manages building placement validation and grid calculations
- * Implements background durability decay system with thread safety
+ * Durability decay is a recurring game-clock timer that runs each pass as
+ * a job, every DURABILITY_DECAY_INTERVAL_MS
+ *
+ * With an event bus set, notifications and decay passes are published to it
+ * instead of calling back, so the decay job never runs UI code.
  */
 class BaseBuildingController {
 public:
@@ -31,8 +36,9 @@ public:
     // Building placement execution
     bool placeBuildingFromCard(const Card* card, int gridX, int gridY);
     
-    // Background durability management
-    void startDurabilityDecay();
+    // Background durability management; timers must outlive the decay, and
+    // stop waits for a pass in flight
+    void startDurabilityDecay(TimerWheel& timers);
     void stopDurabilityDecay();
     
     // Building dependency rules (strategy depth)
@@ -56,6 +62,9 @@ public:
     
     // Callback for UI notifications (e.g., log messages or UI feedback)
     void setNotificationCallback(std::function<void(const std::string&)> callback);
+    // Takes precedence over the callback; must outlive the decay timer and
+    // any decay job it has started
+    void setEventBus(EventBus* eventBus) { eventBus_ = eventBus; }
 
 private:
     BaseManager& baseManager_;
@@ -63,17 +72,19 @@ private:
     
     // Thread safety for background operations
     std::mutex durabilityMutex_;
-    std::atomic<bool> durabilityThreadActive_;
-    std::thread durabilityThread_;
+    std::atomic<bool> durabilityDecayActive_;
+    TimerWheel* timers_ = nullptr;
+    TimerWheel::TimerId durabilityTimer_ = TimerWheel::NONE;
     
     // Error tracking
     mutable PlacementError lastError_;
     
     // Notification system
     std::function<void(const std::string&)> notificationCallback_;
+    EventBus* eventBus_ = nullptr;
     
-    // Background durability decay worker
-    void durabilityDecayWorker();
+    // One durability decay pass; runs as a job
+    void applyDurabilityDecay();
     
     // Helper methods
     bool consumeCardFromInventory(const Card* card);
@@ -44,6 +44,7 @@ public:
     int getMaxTotalDurability() const;
     float getBaseHealthPercentage() const;
     bool hasBuilding(BuildingType type) const;
+    int countOperationalBuildings(BuildingType type) const;
 
     // Event handling (for future expansion)
     void takeDamageFromEvent(int totalDamage);  // Distribute damage across buildings
@@ -84,8 +85,7 @@ private:
     void initializeGrid();
     void initializeDefaultUnlockedSlots();
     BuildingType getRequiredBuildingType(const std::string& cardName) const;
-    bool hasRequiredResources(const std::string& cardName, const Inventory& inventory) const;
-    void consumeResources(const std::string& cardName, Inventory& inventory);
+    bool consumeResources(const std::string& cardName, Inventory& inventory);
     
     // Grid expansion logic
     bool meetsExpansionRequirements() const;
@@ -94,12 +94,14 @@ private:
 
 // Building conversion mappings
 namespace BuildingConversion {
-    // Map card names to building types
+    // Map card materials to building types
+    BuildingType cardToBuildingType(MaterialId material);
     BuildingType cardToBuildingType(const std::string& cardName);
     
     // Get required resources for building types
     std::vector<std::string> getRequiredCards(BuildingType type);
     
     // Check if card can be used for building
+    bool isCardBuildable(MaterialId material);
     bool isCardBuildable(const std::string& cardName);
 }
@@ -1,6 +1,11 @@
 #pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
 #include <string>
-#include <unordered_map>
+#include <utility>
+#include "Core/CardId.h"
 #include "Interface/ui/TooltipData.h"
 #include "Interface/ui/CardDisplayData.h"
 
@@ -17,6 +22,8 @@ enum class CardType {
     MISC        // Miscellaneous
 };
 
+constexpr size_t CARD_TYPE_COUNT = static_cast<size_t>(CardType::MISC) + 1;
+
 // Attribute type enumeration
 enum class AttributeType {
     WEIGHT,
@@ -30,41 +37,167 @@ enum class AttributeType {
     TRADE_VALUE
 };
 
+constexpr size_t ATTRIBUTE_TYPE_COUNT = static_cast<size_t>(AttributeType::TRADE_VALUE) + 1;
+
+/**
+ * Inline attribute storage: one float slot per AttributeType plus a presence bitmask.
+ * Copying never allocates. Iteration yields the present (type, value) pairs in enum
+ * order, so existing map-style loops over attr.first/attr.second keep working.
+ * Unknown attribute types (e.g. from newer data files) are dropped.
+ */
+class AttributeSet {
+public:
+    using value_type = std::pair<AttributeType, float>;
+
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = AttributeSet::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = value_type;
+
+        const_iterator(const AttributeSet* set, size_t index) : set(set), index(index) {
+            skipAbsent();
+        }
+
+        value_type operator*() const {
+            return {static_cast<AttributeType>(index), set->values[index]};
+        }
+
+        const_iterator& operator++() {
+            ++index;
+            skipAbsent();
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator previous = *this;
+            ++(*this);
+            return previous;
+        }
+
+        bool operator==(const const_iterator& other) const { return index == other.index; }
+        bool operator!=(const const_iterator& other) const { return index != other.index; }
+
+    private:
+        void skipAbsent() {
+            while (index < ATTRIBUTE_TYPE_COUNT && !(set->presentMask & (1u << index))) {
+                ++index;
+            }
+        }
+
+        const AttributeSet* set;
+        size_t index;
+    };
+
+    void set(AttributeType type, float value) {
+        size_t index = static_cast<size_t>(type);
+        if (index < ATTRIBUTE_TYPE_COUNT) {
+            values[index] = value;
+            presentMask |= static_cast<uint16_t>(1u << index);
+        }
+    }
+
+    bool contains(AttributeType type) const {
+        size_t index = static_cast<size_t>(type);
+        return index < ATTRIBUTE_TYPE_COUNT && (presentMask & (1u << index));
+    }
+
+    float get(AttributeType type, float defaultValue = 0.0f) const {
+        return contains(type) ? values[static_cast<size_t>(type)] : defaultValue;
+    }
+
+    void erase(AttributeType type) {
+        size_t index = static_cast<size_t>(type);
+        if (index < ATTRIBUTE_TYPE_COUNT) {
+            presentMask &= static_cast<uint16_t>(~(1u << index));
+            values[index] = 0.0f;
+        }
+    }
+
+    // Map-style access: marks the attribute present (value 0 if it was absent)
+    float& operator[](AttributeType type) {
+        size_t index = static_cast<size_t>(type);
+        if (index >= ATTRIBUTE_TYPE_COUNT) {
+            thread_local float discarded;
+            return discarded = 0.0f;
+        }
+        if (!(presentMask & (1u << index))) {
+            values[index] = 0.0f;
+            presentMask |= static_cast<uint16_t>(1u << index);
+        }
+        return values[index];
+    }
+
+    size_t size() const {
+        size_t count = 0;
+        for (uint16_t mask = presentMask; mask; mask &= mask - 1) {
+            ++count;
+        }
+        return count;
+    }
+
+    bool empty() const { return presentMask == 0; }
+
+    void clear() {
+        presentMask = 0;
+        values.fill(0.0f);
+    }
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, ATTRIBUTE_TYPE_COUNT); }
+
+    bool operator==(const AttributeSet& other) const {
+        return presentMask == other.presentMask && values == other.values;
+    }
+    bool operator!=(const AttributeSet& other) const { return !(*this == other); }
+
+private:
+    // Absent slots are kept at 0 so operator== can compare the arrays directly
+    std::array<float, ATTRIBUTE_TYPE_COUNT> values{};
+    uint16_t presentMask = 0;
+};
+
 struct Card : public ITooltipProvider, public ICardDisplayProvider, public ICardComparable {
-    std::string name;
+    std::string name;       // Display and serialization only; compare materialId instead
+    MaterialId materialId;  // Interned from name at construction
     int rarity; // 1=Common, 2=Rare, 3=Legendary
     int quantity;
     CardType type;
-    std::unordered_map<AttributeType, float> attributes;
+    AttributeSet attributes;
 
     // Basic constructor
     Card(const std::string& n, int r, CardType t, int q = 1) 
-        : name(n), rarity(r), quantity(q), type(t) {}
+        : name(n), materialId(MaterialRegistry::instance().intern(n)), rarity(r), quantity(q), type(t) {}
     
     // Backward compatible constructor (temporarily retained)
     Card(const std::string& n, int r, int q = 1) 
-        : name(n), rarity(r), quantity(q), type(CardType::MISC) {}
+        : name(n), materialId(MaterialRegistry::instance().intern(n)), rarity(r), quantity(q), type(CardType::MISC) {}
+
+    // Stack identity used for inventory and recipe lookups
+    CardId getId() const {
+        return CardId{materialId, rarity};
+    }
 
     // Set attribute value
     void setAttribute(AttributeType attrType, float value) {
-        attributes[attrType] = value;
+        attributes.set(attrType, value);
     }
 
     // Get attribute value
     float getAttribute(AttributeType attrType) const {
-        auto it = attributes.find(attrType);
-        return (it != attributes.end()) ? it->second : 0.0f;
+        return attributes.get(attrType);
     }
 
     // Get attribute value with custom default
     float getAttribute(AttributeType attrType, float defaultValue) const {
-        auto it = attributes.find(attrType);
-        return (it != attributes.end()) ? it->second : defaultValue;
+        return attributes.get(attrType, defaultValue);
     }
 
     // Check if attribute exists
     bool hasAttribute(AttributeType attrType) const {
-        return attributes.find(attrType) != attributes.end();
+        return attributes.contains(attrType);
     }
 
     // Get type string
@@ -130,7 +263,7 @@ struct Card : public ITooltipProvider, public ICardDisplayProvider, public ICard
     }
 
     bool compare(const Card& other) const {
-        return (name == other.name &&
+        return (materialId == other.materialId &&
                 rarity == other.rarity &&
                 quantity == other.quantity);
     }
@@ -0,0 +1,59 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Compact integer identity of a material name, shared by every card with that name
+using MaterialId = uint32_t;
+constexpr MaterialId INVALID_MATERIAL_ID = UINT32_MAX;
+
+/**
+ * Process-wide material name interning table.
+ * Each distinct name gets a dense MaterialId the first time it is seen; ids are
+ * never reused, so they can be compared, hashed and used as array indices.
+ * Strings are only needed again for display and serialization.
+ */
+class MaterialRegistry {
+public:
+    static MaterialRegistry& instance();
+
+    // Return the id for name, registering it if needed
+    MaterialId intern(const std::string& name);
+
+    // Return the id for name, or INVALID_MATERIAL_ID if it was never interned
+    MaterialId find(const std::string& name) const;
+
+    const std::string& getName(MaterialId id) const;
+    size_t size() const;
+
+private:
+    MaterialRegistry() = default;
+
+    std::unordered_map<std::string, MaterialId> ids;
+    std::vector<const std::string*> names;  // Points at keys in ids (node-stable)
+    mutable std::shared_mutex mutex;
+};
+
+// Identity of a card stack: interned material plus rarity
+struct CardId {
+    MaterialId material = INVALID_MATERIAL_ID;
+    int rarity = 0;
+
+    bool operator==(const CardId& other) const {
+        return material == other.material && rarity == other.rarity;
+    }
+    bool operator!=(const CardId& other) const { return !(*this == other); }
+};
+
+namespace std {
+template <>
+struct hash<CardId> {
+    size_t operator()(const CardId& id) const {
+        return std::hash<uint64_t>()((static_cast<uint64_t>(id.material) << 32) ^
+                                     static_cast<uint32_t>(id.rarity));
+    }
+};
+}
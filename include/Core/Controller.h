@@ -1,6 +1,5 @@
 #pragma once
 #include <mutex>
-#include <random>
 #include <functional>
 #include <memory>
 #include "Core/Inventory.h"
@@ -8,7 +7,13 @@
 #include "Core/Event.h"
 #include "Core/BaseManager.h"
 #include "Core/BaseBuildingController.h"
+#include "Core/EventBus.h"
+#include "Core/JobSystem.h"
+#include "Core/TimerWheel.h"
+#include "Core/Random.h"
 #include "Systems/CraftingSystem.h"
+#include "Systems/CraftingQueue.h"
+#include "Systems/LootTables.h"
 #include "Interface/GameInputHandler.h"
 
 /**
@@ -20,23 +25,39 @@
 class Controller {
 public:
     Controller(Inventory& inv, View& v, CraftingSystem& crafting, BaseManager& baseManager);
+    // Waits for background jobs that still refer to this controller
+    ~Controller();
     
     // Main game loop operations
     void handleEvents();
     void handleEvent(SDL_Event& event);
     bool isRunning() const;
     void updateView();
+    // Advance timed systems (the crafting queue and the game clock driving
+    // every timer) by the given simulated time, then deliver events
+    // published since the last frame
+    void update(float deltaSeconds);
+    // One organizer pass; a timer runs it as a job every ORGANIZE_INTERVAL
     void organizeInventory();
     
     // Game operation callbacks
     void setSaveCallback(std::function<bool()> saveCallback);
     void setLoadCallback(std::function<bool()> loadCallback);
     
-    // Editor mode control for organizeInventory
-    void pauseOrganizeInventory();
-    void resumeOrganizeInventory();
+    // Editor mode freezes the game clock, so no periodic system fires
+    void setTimersPaused(bool paused);
+    // Cancels the organizer timer and waits for a pass in flight
     void stopOrganizeInventory();
     
+    CraftingQueue& getCraftingQueue() { return craftingQueue_; }
+    // Drained once per frame by update(); publish from any thread
+    EventBus& getEventBus() { return eventBus_; }
+    // Game clock for periodic systems; main thread only
+    TimerWheel& getTimers() { return timers_; }
+    
+    // Replace the exploration outcomes (built from Constants by default)
+    void setLootTables(const LootTables& lootTables);
+    
     // Safe card removal that clears selection state
     void safeRemoveCard(const std::string& name, int rarity);
 
@@ -45,14 +66,23 @@ private:
     View& view_;
     CraftingSystem& craftingSystem_;
     BaseManager& baseManager_;
+    CraftingQueue craftingQueue_;
+    LootTables lootTables_;
+    uint32_t explorationTable_ = LootTables::NONE;
+    LootResult exploreResult_;  // Reused between explorations
+    // Before baseBuildingController_, so both outlive its decay jobs
+    EventBus eventBus_;
+    TimerWheel timers_;
     
     // Input handling delegation
     std::unique_ptr<GameInputHandler> inputHandler_;
     std::shared_ptr<BaseBuildingController> baseBuildingController_;
     
     // Game state
-    bool organizeInventoryEnabled_ = true;
     std::mutex mutex_;
+    TimerWheel::TimerId organizeTimer_ = TimerWheel::NONE;
+    Rng organizerRng_;          // Only touched by the organizer job
+    uint64_t organizerGeneration_;  // RandomService generation it was derived in
     
     // Save/load callback functions
     std::function<bool()> saveCallback_;
@@ -0,0 +1,227 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Bounded multi-producer, single-consumer ring buffer (Vyukov's sequence
+ * scheme). Every slot carries a sequence number that says whether it is
+ * free for the producer at that position or filled for the consumer, so
+ * producers only contend on one fetch position and never lock. All slots
+ * are allocated up front; tryPush() never allocates.
+ */
+template <typename T>
+class MpscQueue {
+public:
+    // Rounded up to a power of two
+    explicit MpscQueue(size_t capacity) {
+        size_t size = 2;
+        while (size < capacity) size <<= 1;
+        mask = size - 1;
+        cells.reset(new Cell[size]);
+        for (size_t i = 0; i < size; ++i) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    size_t capacity() const { return mask + 1; }
+
+    // Any thread; false if the queue is full
+    bool tryPush(const T& value) {
+        size_t position = enqueuePosition.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells[position & mask];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+            if (diff == 0) {
+                if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    cell.value = value;
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                position = enqueuePosition.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Consumer thread only; false if the queue is empty
+    bool tryPop(T& out) {
+        Cell& cell = cells[dequeuePosition & mask];
+        size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        if (static_cast<intptr_t>(sequence) - static_cast<intptr_t>(dequeuePosition + 1) < 0) {
+            return false;
+        }
+        out = cell.value;
+        cell.sequence.store(dequeuePosition + mask + 1, std::memory_order_release);
+        ++dequeuePosition;
+        return true;
+    }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    std::unique_ptr<Cell[]> cells;
+    size_t mask = 0;
+    alignas(64) std::atomic<size_t> enqueuePosition{0};
+    alignas(64) size_t dequeuePosition = 0;
+};
+
+// Fixed-capacity text for event payloads, so publishing never allocates.
+// Longer text is cut off.
+template <size_t N>
+struct FixedString {
+    char text[N] = {};
+
+    FixedString() = default;
+    FixedString(const std::string& s) { assign(s.data(), s.size()); }
+    FixedString(const char* s) { assign(s, std::strlen(s)); }
+
+    void assign(const char* s, size_t length) {
+        length = length < N - 1 ? length : N - 1;
+        std::memcpy(text, s, length);
+        text[length] = '\0';
+    }
+    const char* c_str() const { return text; }
+    std::string str() const { return text; }
+};
+
+/**
+ * Typed publish/subscribe between any thread and the main loop.
+ *
+ * Each subscription owns a bounded MpscQueue of its event type. publish()
+ * copies the event into the queue of every subscriber of that type and
+ * returns; handlers only run in drain(), which the main loop calls once per
+ * frame. Background threads therefore never call into UI code, and events
+ * of one type reach each handler in publish order (per producer thread).
+ *
+ * Events must be trivially copyable (use FixedString for text), so
+ * publish() never allocates and never locks. If a subscriber's queue is
+ * full the event is dropped for it and counted in getDroppedCount().
+ *
+ * subscribe() and unsubscribe() are main-thread only. A queue that has been
+ * unsubscribed stays allocated until the bus is destroyed, because a
+ * producer may still be writing to it.
+ */
+class EventBus {
+public:
+    using SubscriptionId = uint32_t;
+    static constexpr size_t DEFAULT_CAPACITY = 256;
+    static constexpr size_t MAX_EVENT_TYPES = 64;
+    static constexpr size_t MAX_SUBSCRIBERS = 8;    // Per event type
+
+    EventBus();
+    ~EventBus();
+    EventBus(const EventBus&) = delete;
+    EventBus& operator=(const EventBus&) = delete;
+
+    // Returns 0 if the event type already has MAX_SUBSCRIBERS
+    template <typename T>
+    SubscriptionId subscribe(std::function<void(const T&)> handler, size_t capacity = DEFAULT_CAPACITY);
+    void unsubscribe(SubscriptionId id);
+
+    // Any thread
+    template <typename T>
+    void publish(const T& event);
+
+    // Main thread; runs handlers for queued events and returns how many were
+    // delivered. Each subscriber gets at most one queue's worth per drain, so
+    // handlers that publish cannot keep it running.
+    size_t drain();
+
+    uint64_t getDroppedCount() const { return dropped.load(std::memory_order_relaxed); }
+
+private:
+    struct SubscriptionBase {
+        SubscriptionId id = 0;
+        std::atomic<bool> active{true};
+        virtual ~SubscriptionBase() = default;
+        // Deliver at most limit queued events
+        virtual size_t deliver(size_t limit) = 0;
+        virtual size_t capacity() const = 0;
+    };
+
+    template <typename T>
+    struct Subscription : SubscriptionBase {
+        MpscQueue<T> queue;
+        std::function<void(const T&)> handler;
+
+        Subscription(std::function<void(const T&)> h, size_t capacity) : queue(capacity), handler(std::move(h)) {}
+        size_t deliver(size_t limit) override {
+            size_t delivered = 0;
+            T event;
+            while (delivered < limit && queue.tryPop(event)) {
+                ++delivered;
+                if (active.load(std::memory_order_relaxed)) {
+                    handler(event);
+                }
+            }
+            return delivered;
+        }
+        size_t capacity() const override { return queue.capacity(); }
+    };
+
+    // Subscribers of one event type; slots are filled once and never reused
+    struct Channel {
+        std::atomic<SubscriptionBase*> slots[MAX_SUBSCRIBERS] = {};
+    };
+
+    std::atomic<Channel*> channels[MAX_EVENT_TYPES] = {};
+    std::vector<std::unique_ptr<SubscriptionBase>> subscriptions;   // Drain order
+    std::vector<std::unique_ptr<Channel>> ownedChannels;
+    SubscriptionId nextId = 1;
+    std::atomic<uint64_t> dropped{0};
+
+    // Dense index per event type, shared by every bus
+    static size_t nextTypeIndex();
+    template <typename T>
+    static size_t typeIndex() {
+        static const size_t index = nextTypeIndex();
+        return index;
+    }
+
+    Channel* channelFor(size_t type);
+    SubscriptionId addSubscription(size_t type, std::unique_ptr<SubscriptionBase> subscription);
+};
+
+template <typename T>
+EventBus::SubscriptionId EventBus::subscribe(std::function<void(const T&)> handler, size_t capacity) {
+    static_assert(std::is_trivially_copyable<T>::value, "events must be trivially copyable");
+    return addSubscription(typeIndex<T>(), std::make_unique<Subscription<T>>(std::move(handler), capacity));
+}
+
+template <typename T>
+void EventBus::publish(const T& event) {
+    static_assert(std::is_trivially_copyable<T>::value, "events must be trivially copyable");
+    size_t type = typeIndex<T>();
+    if (type >= MAX_EVENT_TYPES) {
+        return;
+    }
+    Channel* channel = channels[type].load(std::memory_order_acquire);
+    if (!channel) {
+        return;
+    }
+    for (auto& slot : channel->slots) {
+        SubscriptionBase* subscription = slot.load(std::memory_order_acquire);
+        if (!subscription) {
+            break;
+        }
+        if (!subscription->active.load(std::memory_order_relaxed)) {
+            continue;
+        }
+        if (!static_cast<Subscription<T>*>(subscription)->queue.tryPush(event)) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
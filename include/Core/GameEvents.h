@@ -0,0 +1,24 @@
+#pragma once
+#include "Core/EventBus.h"
+#include "Core/Building.h"
+
+// Event types carried on the EventBus. They stay trivially copyable, so
+// publishing one from a worker thread never allocates.
+
+// Message meant for the player (log line or toast)
+struct NotificationEvent {
+    enum class Source : uint8_t { General, BaseBuilding };
+    Source source = Source::General;
+    FixedString<128> message;
+};
+
+struct BuildingPlacedEvent {
+    int x = 0;
+    int y = 0;
+    BuildingType type = BuildingType::NONE;
+};
+
+// One durability decay pass of the base
+struct BuildingsDecayedEvent {
+    int damagedBuildings = 0;
+};
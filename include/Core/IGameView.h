@@ -15,7 +15,7 @@ public:
     
     // Pure rendering operations
     virtual void render(const Inventory& inventory, 
-                       const Card* selectedCard, 
+                       CardHandle selectedCard, 
                        int mouseX, 
                        int mouseY, 
                        bool showCraftingPanel, 
@@ -25,6 +25,7 @@ public:
     
     // UI state queries - no business logic
     virtual const Card* getHoveredCard(const Inventory& inventory, int mouseX, int mouseY, int scrollOffset = 0) const = 0;
+    virtual CardHandle getHoveredCardHandle(int mouseX, int mouseY, int scrollOffset = 0) const = 0;
     virtual bool isPointInUIArea(int x, int y, const std::string& areaName) const = 0;
     virtual int getClickedRecipeIndex(int mouseX, int mouseY, int scrollOffset = 0) const = 0;
     
@@ -33,7 +34,7 @@ public:
     virtual bool isCraftingPanelHovered(int mouseX, int mouseY) const = 0;
     
     // UICard selection management
-    virtual void setCardSelection(const Card* selectedCard) = 0;
+    virtual void setCardSelection(CardHandle selectedCard) = 0;
 };
 
 /**
@@ -1,16 +1,228 @@
 #pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
 #include <vector>
 #include <mutex>
+#include <string>
+#include <unordered_map>
 #include "Core/Card.h"
 
+// Stable reference to one stack. Survives reordering, reallocation and
+// snapshots; once the stack is removed, the handle stops resolving.
+struct CardHandle {
+    uint32_t index = UINT32_MAX;
+    uint32_t generation = 0;
+
+    explicit operator bool() const { return index != UINT32_MAX; }
+    bool operator==(const CardHandle& other) const {
+        return index == other.index && generation == other.generation;
+    }
+    bool operator!=(const CardHandle& other) const { return !(*this == other); }
+};
+
+// Handle table entry; the generation is bumped whenever its stack is removed
+struct CardHandleSlot {
+    uint32_t generation = 0;
+    uint32_t position = 0;  // Index into cards while the stack exists
+};
+
+// Immutable copy of the inventory contents at one version
+struct InventoryState {
+    uint64_t version = 0;
+    std::vector<Card> cards;
+    std::vector<CardHandle> handles;      // Parallel to cards
+    std::vector<CardHandleSlot> slots;
+
+    // O(1); nullptr if the handle's stack is not part of this snapshot
+    const Card* resolve(CardHandle handle) const {
+        if (handle.index >= slots.size() || slots[handle.index].generation != handle.generation) {
+            return nullptr;
+        }
+        return &cards[slots[handle.index].position];
+    }
+};
+
+// Ref-counted, read-only snapshot; stays valid however the inventory changes afterwards
+using InventorySnapshot = std::shared_ptr<const InventoryState>;
+
+// One stack quantity change; newQuantity 0 means the stack was removed
+struct InventoryDelta {
+    CardId id;
+    int oldQuantity;
+    int newQuantity;
+    uint64_t version;  // Inventory version the change produced
+};
+
+/**
+ * A list of stack changes that Inventory::apply() performs atomically.
+ * Operations are resolved in the order they were added, so a removal can
+ * consume units added earlier in the same batch.
+ */
+class InventoryBatch {
+public:
+    // Adds card.quantity units to the card's stack, creating it if needed;
+    // a negative quantity is rejected
+    void add(const Card& card);
+    // Removes units from one exact stack; fails the batch if it holds fewer.
+    // Removing zero units is a no-op and a negative quantity is rejected.
+    void remove(const CardId& id, int quantity = 1);
+    // Removes units of a material, starting with preferredRarity and then
+    // other rarities in inventory order; fails the batch if there are too few
+    void removeAnyRarity(MaterialId material, int quantity, int preferredRarity);
+
+    bool empty() const { return ops.empty(); }
+    size_t size() const { return ops.size(); }
+    void clear();
+
+private:
+    friend class Inventory;
+
+    enum class OpType { ADD, REMOVE, REMOVE_ANY_RARITY };
+    struct Op {
+        OpType type;
+        CardId id;          // For REMOVE_ANY_RARITY, the rarity is the preferred one
+        int quantity;
+        size_t cardIndex;   // Into addedCards, for ADD
+    };
+
+    std::vector<Op> ops;
+    std::vector<Card> addedCards;
+};
+
+/**
+ * Inventory of card stacks, one stack per CardId (material, rarity).
+ * Cards are kept contiguously in insertion order; a hash index maps each
+ * CardId to its slot so lookups, merges and removals are O(1).
+ *
+ * Each stack also gets a generational CardHandle from a slot map. UI code
+ * should hold handles rather than Card pointers: a handle is checked in O(1)
+ * and keeps pointing at its stack when the organizer reorders the cards.
+ *
+ * Per-material and per-type secondary indices (lists of handles in inventory
+ * order) and a running total weight back the read-only query functions.
+ *
+ * Every modification bumps the version. Readers on other threads (render,
+ * organizer) should use snapshot(), which never waits on a writer: the
+ * snapshot for the current version is built at most once and shared.
+ * Saves use consistentSnapshot(), which waits so it never misses a change.
+ *
+ * The version doubles as a generation counter for change tracking: each
+ * quantity change is also appended to a bounded delta log, so a consumer
+ * that remembers the last version it saw can fetch only what changed
+ * since then with changesSince() instead of re-scanning every stack.
+ */
 class Inventory {
 public:
     void addCard(const Card& card);
     void removeCard(const std::string& name, int rarity);
+    void removeCard(const CardId& id);
+    // Replaces all cards; stacks sharing (name, rarity) are merged into the first one
     void updateCards(const std::vector<Card>& newCards);
+    // Same, but only if nothing changed since expectedVersion; returns false otherwise
+    bool updateCards(const std::vector<Card>& newCards, uint64_t expectedVersion);
+    // Validates every operation first and applies all or none of them under one
+    // lock. A stack removed down to zero is erased. Returns false if rejected.
+    bool apply(const InventoryBatch& batch);
+    // Same, and appends the resulting quantity changes to applied
+    bool apply(const InventoryBatch& batch, std::vector<InventoryDelta>& applied);
+    // Whether apply() would currently accept the batch
+    bool canApply(const InventoryBatch& batch) const;
+    // Live storage; only safe on the thread that modifies the inventory
     const std::vector<Card>& getCards() const;
 
+    // Latest published snapshot; if a writer holds the lock, the previous one
+    InventorySnapshot snapshot() const;
+    // Snapshot of the current version, waiting for a writer if needed; for
+    // readers that must not miss recent changes, such as saves
+    InventorySnapshot consistentSnapshot() const;
+    uint64_t getVersion() const { return version.load(std::memory_order_acquire); }
+    // Unique per Inventory object, so caches keyed on (instance, version) never
+    // mistake a new inventory for one they have already seen
+    uint64_t getInstanceId() const { return instanceId; }
+
+    // Appends every delta newer than sinceVersion to out, oldest first. Returns
+    // false if the log no longer reaches back that far; the caller must rescan.
+    bool changesSince(uint64_t sinceVersion, std::vector<InventoryDelta>& out) const;
+
+    // Deltas kept before the oldest are dropped
+    static constexpr size_t MAX_DELTA_LOG = 1024;
+
+    // O(1) lookup; the pointer is valid until the next modification
+    const Card* findCard(const std::string& name, int rarity) const;
+    const Card* findCard(const CardId& id) const;
+
+    // Read-only queries; they run under the lock and never copy the inventory
+    int countOf(const CardId& id) const;
+    int countOfAnyRarity(MaterialId material) const;
+    int countOfAnyRarity(const std::string& name) const;
+    bool contains(const CardId& id) const;
+    // Visit matching stacks in inventory order. The callback runs under the
+    // lock, so it must not modify the inventory.
+    void forEachOfType(CardType type, const std::function<void(const Card&)>& fn) const;
+    void forEachOfMaterial(MaterialId material, const std::function<void(const Card&)>& fn) const;
+    // Sum of WEIGHT x quantity over all stacks
+    float totalWeight() const;
+
+    // Handle of the stack with this id, or a null handle
+    CardHandle handleOf(const CardId& id) const;
+    bool isValid(CardHandle handle) const;
+    // Same lifetime rules as findCard; prefer snapshot()->resolve() off the owning thread
+    const Card* resolve(CardHandle handle) const;
+
 private:
+    // Net effect of a batch on one stack
+    struct StackChange {
+        CardId id;
+        int oldQuantity;
+        int newQuantity;
+        const Card* addedCard;  // Template for a stack the batch creates
+        bool drained;           // A removal took it to zero or below
+    };
+
+    bool resolveBatchLocked(const InventoryBatch& batch, std::vector<StackChange>& changes) const;
+    // Builds and publishes the snapshot for the current version if missing
+    InventorySnapshot publishLocked() const;
+    // New stacks take the given handle if set, otherwise a fresh one
+    size_t addCardLocked(const Card& card, CardHandle handle = CardHandle{});
+    CardHandle acquireHandleLocked();
+    // Keep the secondary indices and totals in step with cards
+    void indexStackLocked(size_t slot);
+    void unindexStackLocked(size_t slot);
+    void adjustTotalsLocked(const Card& card, int quantityDelta);
+    void clearIndicesLocked();
+    void releaseHandleLocked(CardHandle handle);
+    void eraseSlot(size_t slot);
+    // Removes every flagged slot in one order-preserving pass
+    void eraseSlots(const std::vector<bool>& erase);
+    void replaceCardsLocked(const std::vector<Card>& newCards);
+    void bumpVersionLocked() { version.fetch_add(1, std::memory_order_release); }
+    // Call after bumpVersionLocked(); tags the delta with the new version
+    void recordDeltaLocked(const CardId& id, int oldQuantity, int newQuantity);
+
     std::vector<Card> cards;
-    std::mutex mutex;
-};
\ No newline at end of file
+    std::unordered_map<CardId, size_t> index;
+    // Parallel to cards: points at the index entry holding each card's slot,
+    // so shifting cards after an erase does not need to re-hash their keys
+    std::vector<size_t*> slotRefs;
+    std::vector<CardHandle> handles;          // Parallel to cards
+    std::vector<CardHandleSlot> handleSlots;
+    std::vector<uint32_t> freeHandles;
+
+    std::unordered_map<MaterialId, std::vector<CardHandle>> materialStacks;
+    std::array<std::vector<CardHandle>, CARD_TYPE_COUNT> typeStacks;
+    double weightTotal = 0.0;
+    mutable std::mutex mutex;
+
+    static inline std::atomic<uint64_t> nextInstanceId{1};
+    const uint64_t instanceId = nextInstanceId.fetch_add(1, std::memory_order_relaxed);
+    std::atomic<uint64_t> version{0};
+    std::deque<InventoryDelta> deltaLog;
+    // Every change after this version is still in deltaLog
+    uint64_t deltaLogStart = 0;
+    // Accessed only through std::atomic_load/atomic_store
+    mutable InventorySnapshot published = std::make_shared<const InventoryState>();
+};
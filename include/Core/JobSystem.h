@@ -0,0 +1,117 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct Job;
+
+// Shared view of one submitted job; copyable, empty when default-constructed
+class JobHandle {
+public:
+    JobHandle() = default;
+
+    bool valid() const { return job != nullptr; }
+    // True once the job has run (an empty handle counts as done)
+    bool isDone() const;
+
+private:
+    friend class JobSystem;
+    explicit JobHandle(std::shared_ptr<Job> j) : job(std::move(j)) {}
+    std::shared_ptr<Job> job;
+};
+
+/**
+ * Fixed-size work-stealing thread pool shared by every system.
+ *
+ * Each worker owns a deque: it pushes and pops its own jobs at the back
+ * (newest first, still warm in cache) and, when that runs dry, steals the
+ * oldest job from the front of another worker's deque. Jobs submitted from
+ * outside the pool are dealt round-robin. Idle workers sleep on a
+ * condition variable instead of spinning.
+ *
+ * A job may depend on other jobs; it is queued only when the last of them
+ * has finished, so a chain or graph of jobs never blocks a worker. wait()
+ * runs queued jobs while it waits, so the main thread helps instead of
+ * idling. An exception thrown by a job is logged and the job counts as done.
+ *
+ * instance() sizes the pool to the core count minus one, leaving a core for
+ * the main thread.
+ */
+class JobSystem {
+public:
+    static JobSystem& instance();
+
+    explicit JobSystem(size_t workerCount);
+    // Runs everything still queued, then joins the workers
+    ~JobSystem();
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    size_t getWorkerCount() const { return workers.size(); }
+
+    JobHandle submit(std::function<void()> fn);
+    // Queued once every dependency is done; empty handles are ignored
+    JobHandle submit(std::function<void()> fn, const std::vector<JobHandle>& dependencies);
+
+    // Runs other queued jobs until the handle is done
+    void wait(const JobHandle& handle);
+    void waitAll(const std::vector<JobHandle>& handles);
+    // Blocks without helping; false if the job is still running after timeout
+    bool waitFor(const JobHandle& handle, std::chrono::milliseconds timeout);
+
+    // Calls fn(begin, end) over [0, count) in chunks of at most batch items,
+    // spread over the pool, and returns when all of them are done
+    void parallelFor(size_t count, size_t batch, const std::function<void(size_t, size_t)>& fn);
+
+private:
+    struct Worker {
+        std::mutex mutex;
+        std::deque<std::shared_ptr<Job>> jobs;
+        std::thread thread;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::atomic<bool> stopping{false};
+    std::atomic<long> queued{0};            // Jobs sitting in some deque
+    std::atomic<size_t> nextWorker{0};      // Round-robin target for outside submits
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+
+    void enqueue(std::shared_ptr<Job> job);
+    // Own deque first (if called from a worker), then steal from the others
+    std::shared_ptr<Job> take();
+    void execute(const std::shared_ptr<Job>& job);
+    void workerLoop(size_t index);
+};
+
+/**
+ * A reusable set of jobs with ordering constraints, e.g. one frame's work.
+ * Nodes may only depend on nodes added before them, so every graph is
+ * acyclic by construction. run() submits the whole graph and waits for it.
+ */
+class TaskGraph {
+public:
+    using Node = size_t;
+
+    Node add(std::function<void()> fn, const std::vector<Node>& after = {});
+    void clear() { nodes.clear(); }
+    size_t size() const { return nodes.size(); }
+
+    void run(JobSystem& jobs);
+
+private:
+    struct Entry {
+        std::function<void()> fn;
+        std::vector<Node> after;
+    };
+
+    std::vector<Entry> nodes;
+    std::vector<JobHandle> handles;     // Reused between runs
+};
@@ -0,0 +1,38 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * Read-only memory mapping of a whole file.
+ *
+ * Pages are loaded on first touch and belong to the page cache, so reading
+ * a large file this way costs no heap and no copy. An empty file opens
+ * successfully with size() 0 and a null data().
+ *
+ * Uses mmap on POSIX and MapViewOfFile on Windows. Elsewhere the file is
+ * read into a heap buffer, which keeps the same interface at the cost of
+ * a copy.
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return opened; }
+
+    const char* data() const { return bytes; }
+    size_t size() const { return length; }
+    const char* begin() const { return bytes; }
+    const char* end() const { return bytes + length; }
+
+private:
+    const char* bytes = nullptr;
+    size_t length = 0;
+    bool opened = false;
+    std::vector<char> buffer;   // Holds the file where mapping is unavailable
+};
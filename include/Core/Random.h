@@ -0,0 +1,83 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * xoshiro256** generator: 32 bytes of state, a few cycles per number.
+ * Satisfies UniformRandomBitGenerator, but game code should prefer the
+ * helpers below: std distributions differ between standard libraries,
+ * so only these give the same sequence on every platform.
+ */
+class Rng {
+public:
+    using result_type = uint64_t;
+    using State = std::array<uint64_t, 4>;
+
+    explicit Rng(uint64_t seed = 0) { reseed(seed); }
+    // Expands seed with splitmix64, so nearby seeds give unrelated sequences
+    void reseed(uint64_t seed);
+    // Raw state, for saving a stream and resuming it where it left off
+    const State& getState() const { return state; }
+    // False, leaving the generator unchanged, for the all-zero state
+    bool setState(const State& newState);
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT64_MAX; }
+    result_type operator()();
+
+    // Uniform in [0, 1)
+    float nextFloat();
+    // Uniform in [lo, hi], both inclusive
+    int nextInt(int lo, int hi);
+
+private:
+    State state;
+};
+
+// Independent random stream per subsystem, so extra draws in one never shift another
+enum class RngStream : uint32_t {
+    Crafting,
+    Exploration,
+    Inventory,   // Background inventory organizer
+    Cards,       // Debug card spawning
+    Count
+};
+
+/**
+ * Process-wide source of seeded random streams.
+ *
+ * Every stream is derived from one master seed, so recording that seed
+ * and calling reseed() replays crafting and exploration results exactly
+ * from the start. SaveManager also records each stream's state, so a
+ * loaded game continues the sequences from the save point. The master
+ * seed comes from std::random_device once at startup.
+ *
+ * stream() hands out the shared generator of a subsystem and must only be
+ * used from the main thread. Background workers take their own generator
+ * with forThread() and derive it again when getGeneration() changes.
+ */
+class RandomService {
+public:
+    static RandomService& instance();
+
+    // Restart every stream from a new master seed
+    void reseed(uint64_t seed);
+    uint64_t getSeed() const { return seed.load(std::memory_order_acquire); }
+    // Bumped by every reseed(), including one to the same seed (loading a
+    // save), so holders of forThread() generators know to derive them again
+    uint64_t getGeneration() const { return generation.load(std::memory_order_acquire); }
+
+    Rng& stream(RngStream id) { return streams[static_cast<size_t>(id)]; }
+    // Generator for one worker of a subsystem; the same (seed, id, worker)
+    // always gives the same sequence
+    Rng forThread(RngStream id, uint32_t worker) const;
+
+private:
+    RandomService();
+
+    std::atomic<uint64_t> seed{0};
+    std::atomic<uint64_t> generation{0};
+    std::array<Rng, static_cast<size_t>(RngStream::Count)> streams;
+};
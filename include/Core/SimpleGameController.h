@@ -13,14 +13,11 @@
 #include "Interface/editor/GameEditor.h"
 #include "Interface/editor/GameData.h"
 #include "Systems/DataManager.h"
+#include "Core/JobSystem.h"
 #include "Constants.h"
 #include <memory>
-#include <thread>
 #include <iostream>
 #include <chrono>
-#include <mutex>
-#include <condition_variable>
-#include <future>
 
 // Forward declarations
 namespace DataManagement {
@@ -57,7 +54,7 @@ private:
     // Game state
     bool running_;
     bool shutdown_;
-    std::unique_ptr<std::thread> organizerThread_;
+    Uint32 lastFrameTicks_ = 0;  // For the simulated time passed to timed systems
     
 public:
     /**
@@ -96,8 +93,8 @@ public:
     void run() {
         if (!running_) return;
         
-        startBackgroundProcesses();
-        
+        // Background work (inventory organizer, durability decay) runs as
+        // jobs fired by the game clock that controller_->update() advances
         while (running_ && controller_->isRunning()) {
             processFrame();
             
@@ -150,6 +147,12 @@ public:
             imguiManager_->endFrame();
         }
         
+        // Advance timed systems by the real time since the last frame
+        Uint32 now = SDL_GetTicks();
+        float deltaSeconds = lastFrameTicks_ ? (now - lastFrameTicks_) / 1000.0f : 0.0f;
+        lastFrameTicks_ = now;
+        controller_->update(deltaSeconds);
+        
         controller_->updateView();
         
         // Render ImGui overlay
@@ -314,6 +317,7 @@ private:
         techTreeSystem_ = std::make_unique<TechTreeSystem>(*sdlManager_, 
                                                            globalDataManager_.get(), 
                                                            craftingSystem_.get());
+        techTreeSystem_->setTimerWheel(&controller_->getTimers());
         std::cout << "Tech tree system initialized" << std::endl;
         
         return true;
@@ -332,13 +336,9 @@ private:
             imguiManager_->setDataManager(globalDataManager_.get());
             // Note: setGameInstance creates circular dependency, skip for now
             
-            // Set callback for editor mode changes to control organizeInventory
+            // Editor mode freezes the game clock, and with it every periodic system
             imguiManager_->setEditorModeCallback([this](bool editorMode) {
-                if (editorMode) {
-                    controller_->pauseOrganizeInventory();
-                } else {
-                    controller_->resumeOrganizeInventory();
-                }
+                controller_->setTimersPaused(editorMode);
             });
             
             gameEditor_ = std::make_unique<GameEditor>();
@@ -361,16 +361,6 @@ private:
         }
     }
     
-    /**
-     * Start background processes
-     * Follows Single Responsibility Principle (SRP)
-     */
-    void startBackgroundProcesses() {
-        organizerThread_ = std::make_unique<std::thread>([this]() { 
-            controller_->organizeInventory(); 
-        });
-    }
-    
     /**
      * Shutdown game systems
      * Follows Single Responsibility Principle (SRP)
@@ -381,29 +371,25 @@ private:
         
         std::cout << "Starting graceful shutdown..." << std::endl;
         
-        // Stop background processes first with immediate effect
+        // Stop background jobs first; this waits for a pass in flight
         if (controller_) {
             controller_->stopOrganizeInventory();
         }
         
-        // Automatically save when the game ends (with timeout protection)
+        // Automatically save when the game ends, serialized on the job system
         std::cout << "Game ended, saving..." << std::endl;
-        try {
-            auto future = std::async(std::launch::async, [this]() {
-                return saveGame();
-            });
-            
-            // Wait for save with shorter timeout
-            if (future.wait_for(std::chrono::milliseconds(800)) == std::future_status::timeout) {
-                std::cout << "Save operation timed out, continuing shutdown..." << std::endl;
+        JobSystem& jobs = JobSystem::instance();
+        JobHandle save = jobs.submit([this]() {
+            if (!saveGame()) {
+                std::cout << "Save failed, continuing shutdown..." << std::endl;
             }
-        } catch (const std::exception& e) {
-            std::cout << "Save error: " << e.what() << ", continuing shutdown..." << std::endl;
+        });
+        if (!jobs.waitFor(save, std::chrono::milliseconds(800))) {
+            // The save still refers to the inventory, so it must finish first
+            std::cout << "Save is taking longer than expected, waiting..." << std::endl;
+            jobs.wait(save);
         }
         
-        // Cleanup background threads
-        cleanup();
-        
         // Shutdown services
         if (imguiManager_) {
             imguiManager_->shutdown();
@@ -412,47 +398,6 @@ private:
         
         std::cout << "Shutdown complete." << std::endl;
     }
-    
-    /**
-     * Cleanup resources
-     * Follows Single Responsibility Principle (SRP)
-     */
-    void cleanup() {
-        if (organizerThread_ && organizerThread_->joinable()) {
-            std::cout << "Waiting for background thread to finish..." << std::endl;
-            
-            // Simple approach: wait for a reasonable time then detach if needed
-            bool threadFinished = false;
-            std::mutex timeoutMutex;
-            std::condition_variable timeoutCv;
-            
-            std::thread timeoutChecker([&]() {
-                if (organizerThread_->joinable()) {
-                    organizerThread_->join();
-                    std::lock_guard<std::mutex> lock(timeoutMutex);
-                    threadFinished = true;
-                    timeoutCv.notify_one();
-                }
-            });
-            
-            // Wait with timeout - reduce to 300ms for much faster response
-            std::unique_lock<std::mutex> lock(timeoutMutex);
-            if (timeoutCv.wait_for(lock, std::chrono::milliseconds(300), [&] { return threadFinished; })) {
-                std::cout << "Background thread finished normally." << std::endl;
-            } else {
-                std::cout << "Background thread did not finish in time, detaching..." << std::endl;
-                if (organizerThread_->joinable()) {
-                    organizerThread_->detach();
-                }
-            }
-            
-            if (timeoutChecker.joinable()) {
-                timeoutChecker.detach();
-            }
-            
-            organizerThread_.reset();
-        }
-    }
 };
 
 /**
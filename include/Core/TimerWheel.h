@@ -0,0 +1,104 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "Core/JobSystem.h"
+
+/**
+ * Hierarchical timer wheel driven by the game clock.
+ *
+ * Systems register one-shot or recurring timers in game seconds instead of
+ * sleeping on a thread or accumulating frame deltas themselves. The clock
+ * only moves when advance() is called from the main loop, so pausing it
+ * (editor mode) holds every timer where it is, and a paused game uses no
+ * thread at all.
+ *
+ * Time is cut into ticks of a fixed length. Four levels of 256 slots cover
+ * 2^32 ticks: a timer sits in the finest level whose range reaches its
+ * expiry, and a coarser slot is cascaded down once, when the finer level
+ * wraps around. Scheduling, cancelling and firing are O(1) per timer. An
+ * occupancy bitmap of the finest level lets advance() jump over ticks with
+ * no timers, stopping only at occupied slots and at wraps, which cascade.
+ *
+ * A timer fires either on the main thread, inside advance(), or as a job
+ * on the JobSystem. A recurring job timer whose previous job is still
+ * running skips that expiry instead of stacking up jobs.
+ *
+ * Not thread-safe: schedule, cancel and advance from the main thread only.
+ * Callbacks may schedule and cancel timers, including their own.
+ */
+class TimerWheel {
+public:
+    using TimerId = uint64_t;
+    static constexpr TimerId NONE = 0;
+
+    enum class Dispatch { MainThread, Job };
+
+    explicit TimerWheel(double tickSeconds = 0.01);
+
+    // Fires once, delaySeconds of game time from now
+    TimerId schedule(double delaySeconds, std::function<void()> fn, Dispatch dispatch = Dispatch::MainThread);
+    // Fires every intervalSeconds, the first time one interval from now
+    TimerId scheduleEvery(double intervalSeconds, std::function<void()> fn, Dispatch dispatch = Dispatch::MainThread);
+    // Stops the timer. A job it already started keeps running; the returned
+    // handle lets the caller wait for it. Unknown or stale ids are ignored.
+    JobHandle cancel(TimerId id);
+    bool isScheduled(TimerId id) const;
+
+    // Moves the game clock forward and fires what expired, in expiry order
+    void advance(double deltaSeconds);
+    void setPaused(bool paused) { this->paused = paused; }
+    bool isPaused() const { return paused; }
+
+    // Game seconds advanced so far, excluding pauses
+    double now() const { return tick * tickSeconds; }
+    size_t activeCount() const { return active; }
+
+private:
+    static constexpr uint32_t NIL = UINT32_MAX;
+    static constexpr int LEVELS = 4;
+    static constexpr int SLOT_BITS = 8;
+    static constexpr uint32_t SLOTS = 1u << SLOT_BITS;
+    static constexpr uint32_t SLOT_MASK = SLOTS - 1;
+
+    struct Timer {
+        std::function<void()> fn;
+        uint64_t expires = 0;           // Tick
+        uint64_t interval = 0;          // Ticks; 0 for one-shot
+        uint32_t generation = 0;
+        uint32_t prev = NIL;
+        uint32_t next = NIL;
+        uint32_t slot = NIL;            // Level * SLOTS + index while linked
+        Dispatch dispatch = Dispatch::MainThread;
+        bool scheduled = false;
+        JobHandle job;                  // Last job started, for Dispatch::Job
+    };
+
+    double tickSeconds;
+    double carry = 0.0;                 // Fraction of a tick not yet advanced
+    uint64_t tick = 0;                  // Next tick to process
+    bool paused = false;
+    bool firing = false;                // Inside processTick()
+    size_t active = 0;
+
+    std::vector<Timer> timers;
+    std::vector<uint32_t> freeTimers;
+    std::array<uint32_t, LEVELS * SLOTS> heads;
+    std::array<uint32_t, LEVELS * SLOTS> tails;
+    std::array<uint64_t, SLOTS / 64> occupied{};    // Non-empty level-0 slots
+
+    TimerId add(double delaySeconds, double intervalSeconds, std::function<void()> fn, Dispatch dispatch);
+    uint64_t toTicks(double seconds) const;
+    Timer* find(TimerId id);
+    const Timer* find(TimerId id) const;
+    void link(uint32_t index);
+    void unlink(uint32_t index);
+    void release(uint32_t index);
+    // Re-link every timer of one coarse slot; returns the slot index
+    uint32_t cascade(int level);
+    // Ticks from now with nothing to fire or cascade, up to the next wrap
+    uint64_t idleTicks() const;
+    void processTick();
+    void fire(uint32_t index);
+};
@@ -26,7 +26,7 @@ public:
 
     // IGameView interface implementation - pure presentation
     void render(const Inventory& inventory, 
-               const Card* selectedCard, 
+               CardHandle selectedCard, 
                int mouseX, 
                int mouseY, 
                bool showCraftingPanel, 
@@ -36,7 +36,7 @@ public:
     
     // Extended render method with drag support
     void render(const Inventory& inventory, 
-               const Card* selectedCard, 
+               CardHandle selectedCard, 
                int mouseX, 
                int mouseY, 
                bool showCraftingPanel, 
@@ -44,16 +44,17 @@ public:
                int inventoryScrollOffset,
                int craftingScrollOffset,
                bool isDragging,
-               const Card* draggedCard);
+               CardHandle draggedCard);
     
     const Card* getHoveredCard(const Inventory& inventory, int mouseX, int mouseY, int scrollOffset = 0) const override;
+    CardHandle getHoveredCardHandle(int mouseX, int mouseY, int scrollOffset = 0) const override;
     bool isPointInUIArea(int x, int y, const std::string& areaName) const override;
     int getClickedRecipeIndex(int mouseX, int mouseY, int scrollOffset = 0) const override;
     bool isButtonHovered(const std::string& buttonName, int mouseX, int mouseY) const override;
     bool isCraftingPanelHovered(int mouseX, int mouseY) const override;
     
     // UICard selection management
-    void setCardSelection(const Card* selectedCard) override;
+    void setCardSelection(CardHandle selectedCard) override;
 
 private:
     SDLManager& sdlManager_;
@@ -77,7 +78,7 @@ private:
     void renderInventoryBackground();
     void renderHints();
     void updateTooltip(const Inventory& inventory, 
-                      const Card* selectedCard, 
+                      CardHandle selectedCard, 
                       bool showCraftingPanel, 
                       int mouseX, 
                       int mouseY,
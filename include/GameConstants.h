@@ -2,8 +2,8 @@
 #include <chrono>
 #include <vector>
 #include <string>
-#include <random>
 #include "Core/Card.h"
+#include "Core/Random.h"
 #include "Core/Event.h"
 
 namespace GameConstants {
@@ -25,6 +25,10 @@ constexpr int INITIAL_UNLOCKED_SLOTS = 5; // Starting available slots
 constexpr int DURABILITY_DECAY_INTERVAL_MS = 60000; // 1 minute in milliseconds
 constexpr float DURABILITY_DECAY_RATE = 0.01f;      // 1% per interval
 
+// Crafting Queue
+constexpr float CRAFT_TIME_SECONDS = 3.0f;  // Time one crafting station spends per item
+constexpr int CRAFT_BATCH_SIZE = 10;        // Items queued by a Shift+click on a recipe
+
 // Card Factory - Create default cards with attributes
 class CardFactory {
 public:
@@ -116,12 +120,8 @@ public:
 // Random Card Generator
 class RandomCardGenerator {
 public:
-    static Card generateRandomCard() {
-        static std::random_device rd;
-        static std::mt19937 gen(rd());
-        static std::uniform_int_distribution<> cardTypeDist(0, 9);
-        
-        int cardType = cardTypeDist(gen);
+    static Card generateRandomCard(Rng& rng) {
+        int cardType = rng.nextInt(0, 9);
         switch (cardType) {
             case 0: return CardFactory::createWood();
             case 1: return CardFactory::createMetal();
@@ -137,8 +137,8 @@ public:
         }
     }
     
-    static Card generateRandomCardByRarity(int rarity) {
-        Card card = generateRandomCard();
+    static Card generateRandomCardByRarity(int rarity, Rng& rng) {
+        Card card = generateRandomCard(rng);
         card.rarity = rarity;
         return card;
     }
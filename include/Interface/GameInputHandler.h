@@ -2,6 +2,7 @@
 #include "Core/IGameView.h"
 #include "Core/Inventory.h"
 #include "Systems/CraftingSystem.h"
+#include "Systems/CraftingPlanner.h"
 #include "Core/BaseBuildingController.h"
 #include <functional>
 #include <memory>
@@ -45,7 +46,7 @@ public:
     
     // Game state accessors
     bool isRunning() const { return running_; }
-    const Card* getSelectedCard() const { return selectedCard_; }
+    CardHandle getSelectedCard() const { return selectedCard_; }
     bool isShowingCraftingPanel() const { return showCraftingPanel_; }
     int getMouseX() const { return mouseX_; }
     int getMouseY() const { return mouseY_; }
@@ -54,7 +55,7 @@ public:
     
     // Drag and drop state
     bool isDragging() const { return isDragging_; }
-    const Card* getDraggedCard() const { return draggedCard_; }
+    CardHandle getDraggedCard() const { return draggedCard_; }
     int getDragStartX() const { return dragStartX_; }
     int getDragStartY() const { return dragStartY_; }
     
@@ -70,31 +71,33 @@ public:
     void setSaveCallback(std::function<bool()> callback) { saveCallback_ = callback; }
     void setLoadCallback(std::function<bool()> callback) { loadCallback_ = callback; }
     void setExploreCallback(std::function<void()> callback) { exploreCallback_ = callback; }
+    void setQueueCraftCallback(std::function<bool(const std::string&, int)> callback) { queueCraftCallback_ = callback; }
     
     // Focus management callbacks
     void setFocusNextCallback(std::function<void()> callback) { focusNextCallback_ = callback; }
     void setFocusPreviousCallback(std::function<void()> callback) { focusPreviousCallback_ = callback; }
     void setClearFocusCallback(std::function<void()> callback) { clearFocusCallback_ = callback; }
     
-    // Pointer validation - clear invalid card pointers
-    void validateCardPointers();
+    // Handle validation - clear handles whose stack is gone (O(1) each)
+    void validateCardHandles();
 
 private:
     IGameView& view_;
     Inventory& inventory_;
     CraftingSystem& craftingSystem_;
+    CraftingPlanner planner_;
     std::shared_ptr<BaseBuildingController> baseBuildingController_;
     
     // Game state
     bool running_;
-    Card* selectedCard_;
-    Card* previousSelectedCard_;  // Track previously selected card for UICard state management
+    CardHandle selectedCard_;
+    CardHandle previousSelectedCard_;  // Track previously selected card for UICard state management
     bool showCraftingPanel_;
     int mouseX_, mouseY_;
     
     // Drag and drop state
     bool isDragging_;
-    Card* draggedCard_;
+    CardHandle draggedCard_;
     int dragStartX_, dragStartY_;
     static constexpr int DRAG_THRESHOLD = 5; // Minimum pixels to start dragging
     
@@ -106,6 +109,7 @@ private:
     std::function<bool()> saveCallback_;
     std::function<bool()> loadCallback_;
     std::function<void()> exploreCallback_;
+    std::function<bool(const std::string&, int)> queueCraftCallback_;  // (recipe id, count)
     
     // Focus management callbacks
     std::function<void()> focusNextCallback_;
@@ -114,19 +118,22 @@ private:
     
     // Input handling helpers
     void handleButtonClick(const std::string& buttonName);
-    void handleCardClick(const Card* card);
+    void handleCardClick(CardHandle card);
     void handleRecipeClick(int recipeIndex);
     void handleScrollWheel(int x, int y, int deltaY);
     void addRandomCard();
     void removeFirstCard();
     void toggleCraftingPanel();
+    // Print how to reach a recipe through intermediate crafts, or what is still missing
+    void printCraftingPlan(const Recipe& recipe);
     void craftRecipe(int recipeIndex);
     
     // Drag and drop helpers
-    void startDrag(Card* card, int startX, int startY);
+    void startDrag(CardHandle card, int startX, int startY);
     void updateDrag(int currentX, int currentY);
     void endDrag(int endX, int endY);
     bool shouldStartDrag(int currentX, int currentY) const;
+    bool isSelectedCardBuildable() const;
     
     // Force exit protection for consistent shutdown behavior
     void forceExitIfNeeded(const std::string& source);
@@ -164,11 +164,14 @@ private:
         std::string name = ui_->getUserInput("Material name to edit");
         int rarity = ui_->getUserChoice("Material rarity", 1, 5);
         
-        auto* material = dataService_->findMaterial(name, rarity);
-        if (!material) {
+        const auto* existing = dataService_->findMaterial(name, rarity);
+        if (!existing) {
             ui_->displayError("Material not found: " + name + " (rarity " + std::to_string(rarity) + ")");
             return;
         }
+        // Edit a copy; name and rarity are lookup keys, so the service applies it
+        DataManagement::MaterialData edited = *existing;
+        auto* material = &edited;
         
         ui_->displayMessage("\nEditing material: " + material->name);
         ui_->displayMessage("1. Change name");
@@ -192,7 +195,11 @@ private:
             case 0: return;
         }
         
-        ui_->displaySuccess("Material updated successfully!");
+        if (dataService_->updateMaterial(name, rarity, edited)) {
+            ui_->displaySuccess("Material updated successfully!");
+        } else {
+            ui_->displayError("Failed to update material");
+        }
     }
     
     void deleteMaterial() {
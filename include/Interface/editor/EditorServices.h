@@ -140,35 +140,17 @@ public:
     }
     
     bool addMaterial(const DataManagement::MaterialData& material) override {
-        auto materials = dataManager_.getMaterials();
-        materials.push_back(material);
-        dataManager_.setMaterials(materials);
+        dataManager_.addMaterial(material);
         return true;
     }
     
     bool updateMaterial(const std::string& name, int rarity, 
                        const DataManagement::MaterialData& material) override {
-        auto* existingMaterial = findMaterial(name, rarity);
-        if (existingMaterial) {
-            *existingMaterial = material;
-            return true;
-        }
-        return false;
+        return dataManager_.updateMaterial(name, rarity, material);
     }
     
     bool removeMaterial(const std::string& name, int rarity) override {
-        auto materials = dataManager_.getMaterials();
-        auto it = std::find_if(materials.begin(), materials.end(),
-                              [&](const DataManagement::MaterialData& m) {
-                                  return m.name == name && m.rarity == rarity;
-                              });
-        
-        if (it != materials.end()) {
-            materials.erase(it);
-            dataManager_.setMaterials(materials);
-            return true;
-        }
-        return false;
+        return dataManager_.removeMaterial(name, rarity);
     }
     
     // Recipe operations
@@ -181,34 +163,16 @@ public:
     }
     
     bool addRecipe(const DataManagement::RecipeData& recipe) override {
-        auto recipes = dataManager_.getRecipes();
-        recipes.push_back(recipe);
-        dataManager_.setRecipes(recipes);
+        dataManager_.addRecipe(recipe);
         return true;
     }
     
     bool updateRecipe(const std::string& id, const DataManagement::RecipeData& recipe) override {
-        auto* existingRecipe = findRecipe(id);
-        if (existingRecipe) {
-            *existingRecipe = recipe;
-            return true;
-        }
-        return false;
+        return dataManager_.updateRecipe(id, recipe);
     }
     
     bool removeRecipe(const std::string& id) override {
-        auto recipes = dataManager_.getRecipes();
-        auto it = std::find_if(recipes.begin(), recipes.end(),
-                              [&](const DataManagement::RecipeData& r) {
-                                  return r.id == id;
-                              });
-        
-        if (it != recipes.end()) {
-            recipes.erase(it);
-            dataManager_.setRecipes(recipes);
-            return true;
-        }
-        return false;
+        return dataManager_.removeRecipe(id);
     }
     
     // Event operations
@@ -298,9 +262,9 @@ public:
         if (!gameInstance_) return items;
         
         const auto& inventory = gameInstance_->getInventory();
-        auto cards = inventory.getCards();
+        InventorySnapshot snapshot = inventory.snapshot();
         
-        for (const auto& card : cards) {
+        for (const auto& card : snapshot->cards) {
             items.push_back(card.name + " x" + std::to_string(card.quantity));
         }
         
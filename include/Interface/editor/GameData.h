@@ -3,6 +3,7 @@
 
 #include "Core/Card.h"
 #include "Systems/CraftingSystem.h"
+#include "Systems/CompiledEvents.h"
 #include <vector>
 #include <map>
 #include <string>
@@ -55,7 +56,7 @@ struct EventCondition {
     float value;           // Threshold, amount, percentage
     std::string operator_; // ">=", "==", "<", etc.
     
-    bool evaluate() const; // Evaluate if condition is met
+    bool evaluate(const EventState& state, Rng& rng) const; // Evaluate if condition is met
 };
 
 // Event effect
@@ -77,8 +78,8 @@ struct EventTemplate {
     bool isRepeatable;
     int priority;
     
-    bool canTrigger() const; // Check if all conditions are met
-    void trigger() const;    // Execute all effects
+    bool canTrigger(const EventState& state, Rng& rng) const; // Check if all conditions are met
+    void trigger(const EventState& state, Rng& rng) const;    // Execute all effects
 };
 
 /**
@@ -131,6 +132,8 @@ public:
     void updateEvent(const std::string& id, const EventTemplate& event);
     EventTemplate* getEvent(const std::string& id);
     const std::vector<EventTemplate>& getAllEvents() const { return events_; }
+    // Conditions of getAllEvents(), same order; recompiled after edits
+    const CompiledEvents& getCompiledEvents() const;
     
     // Data validation
     struct ValidationResult {
@@ -158,6 +161,8 @@ private:
     std::vector<MaterialTemplate> materials_;
     std::vector<Recipe> recipes_;
     std::vector<EventTemplate> events_;
+    mutable CompiledEvents compiledEvents_;
+    mutable bool eventsDirty_ = true;
     
     // Game instance reference for live data
     Game* gameInstance_;
@@ -15,8 +15,9 @@ public:
                  std::function<void(const Recipe&)> onRecipeClick = nullptr);
     
     void render() override;
-    void update(const Recipe& recipe, bool canCraft);
+    void update(const Recipe& recipe, bool canCraft, int maxCrafts, const std::string& bottleneck = "");
     void handleClick(int mouseX, int mouseY);
+    const std::string& getRecipeId() const { return recipe_.id; }
     
     // Layout management for recipe content
     void updateLayout();
@@ -24,6 +25,8 @@ public:
 private:
     Recipe recipe_;
     bool canCraft_;
+    int maxCrafts_;  // Shown next to the name while craftable
+    std::string bottleneck_;  // Limiting ingredient, shown while not craftable
     std::function<void(const Recipe&)> onRecipeClick_;
     
     void renderIngredientsList(int x, int y);
@@ -64,6 +67,12 @@ private:
     std::vector<std::unique_ptr<UIRecipeItem>> recipeItems_;
     std::function<void(const Recipe&)> onRecipeClick_;
     
+    // State last shown per recipe item, so unchanged items are not rebuilt
+    bool evaluated_ = false;
+    std::vector<bool> recipeUnlocked_;
+    std::vector<int> recipeMaxCrafts_;
+    std::vector<MaterialId> recipeBottlenecks_;
+    
     void createRecipeItems(const std::vector<Recipe>& recipes);
     void renderOverlay();
     void renderPanelBackground();
@@ -2,7 +2,6 @@
 #include "../../../extracted_libs/ui_framework/include/Interface/ui/ContainerCompat.h"
 #include "Core/Inventory.h"
 #include "Core/Card.h"
-#include <unordered_map>
 #include <functional>
 
 // Forward declaration
@@ -24,16 +23,17 @@ public:
     // Update scroll position and refresh visible cards (more efficient than full inventory update)
     void updateScroll(int scrollOffset);
     
-    // Check if inventory content has changed and needs updating
+    // Check if inventory content has changed (any add, remove or reorder) and needs updating
     bool needsInventoryUpdate(const Inventory& inventory) const;
     
     // Get card at specific position (for hover detection)
     const Card* getCardAtPosition(int x, int y) const;
     const Card* getCardAtPosition(int x, int y, int scrollOffset) const;
+    CardHandle getHandleAtPosition(int x, int y, int scrollOffset) const;
     
     // Selection management
-    void setSelectedCard(const Card* card);
-    const Card* getSelectedCard() const { return selectedCard_; }
+    void setSelectedCard(CardHandle card);
+    CardHandle getSelectedCard() const { return selectedCard_; }
     
     // Callback for card clicks
     void setOnCardClick(std::function<void(const Card&)> callback) { onCardClick_ = callback; }
@@ -47,16 +47,13 @@ public:
 
 private:
     // Current inventory data
-    std::vector<Card> inventoryCards_;
-    size_t lastInventorySize_ = 0;  // Track inventory size changes
-    const Card* selectedCard_ = nullptr;
+    InventorySnapshot inventorySnapshot_ = std::make_shared<const InventoryState>();
+    CardHandle selectedCard_;
     
     // Card pool for reuse - simple approach
     std::vector<std::unique_ptr<UICard>> cardPool_;
     size_t usedCards_ = 0;  // How many cards from pool are currently in use
-    
-    // Selection state persistence 
-    std::unordered_map<std::string, bool> selectionState_;
+    std::vector<CardHandle> poolHandles_;  // Stack shown by each pooled UICard
     
     // Click callback
     std::function<void(const Card&)> onCardClick_;
@@ -66,12 +63,12 @@ private:
     static constexpr int BUFFER_CARDS = 2;  // Render N extra cards above/below visible area
     
     // Helper methods
+    const std::vector<Card>& inventoryCards() const { return inventorySnapshot_->cards; }
     void calculateVisibleRange(int& startIndex, int& endIndex) const;
-    UICard* getCardFromPool();
+    int getCardIndexAtPosition(int x, int y, int scrollOffset) const;
+    UICard* getCardFromPool(CardHandle handle);
     void resetPool();
-    std::string getCardKey(const Card& card) const;
-    void saveSelectionState();
-    void restoreSelectionState(UICard* uiCard, const Card& card);
+    void showCard(size_t inventoryIndex, int cardY);
     int getCardYPosition(int cardIndex) const;
     bool isCardVisible(int cardY) const;
 };
@@ -0,0 +1,107 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Core/CardId.h"
+
+struct EventTemplate;
+struct EventCondition;
+struct InventoryState;
+class Rng;
+
+/**
+ * Everything event conditions read. Fill it once per tick and share it
+ * across every event; readInventory() turns a snapshot into per-material
+ * counts so inventory conditions become array lookups.
+ */
+struct EventState {
+    std::vector<int32_t> counts;    // Indexed by MaterialId, any rarity
+    int turn = 0;
+    float playerHealth = 100.0f;
+    std::string location;
+
+    void readInventory(const InventoryState& inventory);
+};
+
+/**
+ * Event templates compiled into flat predicate lists for bulk checks.
+ *
+ * Compiling resolves what evaluating would otherwise redo on every check:
+ * material names become MaterialIds, locations become small integers,
+ * operators are parsed once, and RANDOM_CHANCE values become probabilities.
+ * Conditions of one event are reordered cheapest first, with random
+ * chances last, so a failing check returns early and never draws a random
+ * number it does not need.
+ *
+ * Events whose conditions can never hold (an unknown operator, a zero
+ * chance) are flagged at compile time and rejected without evaluation.
+ *
+ * Compiling also indexes which events read which input (a material count,
+ * the turn, health, location or a random chance), so EventTriggers can
+ * re-check only the events an input change can affect.
+ */
+class CompiledEvents {
+public:
+    enum class Input : uint8_t { Turn, Health, Location, Chance, Count };
+
+    void compile(const std::vector<EventTemplate>& events);
+    void clear();
+
+    size_t eventCount() const { return never.size(); }
+    // Problems found while compiling, one line each
+    const std::vector<std::string>& getErrors() const { return errors; }
+
+    // Whether every condition of the event holds; may draw from rng
+    bool canTrigger(size_t event, const EventState& state, Rng& rng) const;
+    // out[i] is 1 if event i can trigger
+    void canTriggerAll(const EventState& state, Rng& rng, std::vector<uint8_t>& out) const;
+
+    // Same as canTriggerAll, but only sets out[event] for the listed events
+    void canTriggerSome(const std::vector<uint32_t>& events, const EventState& state, Rng& rng,
+                        std::vector<uint8_t>& out) const;
+
+    // Events with a condition on the input, ascending, each listed once.
+    // Events that can never trigger are left out.
+    const std::vector<uint32_t>& eventsReading(Input input) const {
+        return inputEvents[static_cast<size_t>(input)];
+    }
+    // Same for the count of one material; appends to out
+    void eventsReadingMaterial(MaterialId material, std::vector<uint32_t>& out) const;
+    // Every event reading any material count
+    const std::vector<uint32_t>& eventsReadingInventory() const { return inventoryEvents; }
+
+    // One condition compiled on its own, for single checks outside a compiled set
+    static bool evaluate(const EventCondition& condition, const EventState& state, Rng& rng);
+
+private:
+    enum class Kind : uint8_t { Location, Time, Health, InventoryCount, Chance };
+    enum class Compare : uint8_t { Less, LessEqual, Equal, NotEqual, GreaterEqual, Greater };
+
+    struct Predicate {
+        Kind kind;
+        Compare compare;
+        uint32_t key;       // MaterialId or location index
+        float value;
+    };
+
+    std::vector<uint32_t> predicateBegin;   // eventCount() + 1 offsets
+    std::vector<Predicate> predicates;
+    std::vector<uint8_t> never;
+    std::unordered_map<std::string, uint32_t> locations;
+    std::vector<std::string> errors;
+
+    // Reverse index: materialEvents[materialBegin[id], materialBegin[id + 1])
+    std::vector<uint32_t> materialBegin;
+    std::vector<uint32_t> materialEvents;
+    std::vector<uint32_t> inventoryEvents;
+    std::vector<uint32_t> inputEvents[static_cast<size_t>(Input::Count)];
+
+    void buildIndex();
+    bool eventHolds(size_t event, const EventState& state, uint32_t location, Rng& rng) const;
+    uint32_t locationKey(const std::string& location) const;
+    bool holds(const Predicate& predicate, const EventState& state, uint32_t location, Rng& rng) const;
+    // False if the condition can never hold (error says why, if it is a data
+    // problem); always is set instead of out when it always holds
+    bool compileCondition(const EventCondition& condition, Predicate& out, bool& always, std::string& error);
+};
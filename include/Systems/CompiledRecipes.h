@@ -0,0 +1,82 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Core/CardId.h"
+
+struct Recipe;
+
+/**
+ * Recipes compiled into flat, structure-of-arrays form for bulk matching.
+ *
+ * Only what availability checks read is kept here (the hot fields): for every
+ * ingredient the material, the total quantity and the preferred rarity.
+ * Names, descriptions and result cards stay in Recipe (the cold fields).
+ * Ingredients of recipe i occupy [needBegin[i], needBegin[i + 1]) of the
+ * need arrays, and repeated materials within one recipe are merged.
+ *
+ * Rarity policy: an ingredient accepts its material at any rarity and
+ * consumes the preferred rarity first, so availability only depends on the
+ * total count per material. Counts are passed as a dense vector indexed by
+ * MaterialId (see materialSlots()).
+ */
+class CompiledRecipes {
+public:
+    void compile(const std::vector<Recipe>& recipes);
+    void clear();
+
+    size_t recipeCount() const { return needBegin.empty() ? 0 : needBegin.size() - 1; }
+    size_t needCount() const { return needMaterial.size(); }
+    // Size a count vector needs so every material a recipe uses has a slot
+    size_t materialSlots() const { return slots; }
+
+    // Needs of one recipe, as index ranges into the arrays below
+    uint32_t firstNeed(size_t recipe) const { return needBegin[recipe]; }
+    uint32_t endNeed(size_t recipe) const { return needBegin[recipe + 1]; }
+    MaterialId needMaterialAt(uint32_t need) const { return needMaterial[need]; }
+    int32_t needQuantityAt(uint32_t need) const { return needQuantity[need]; }
+    int32_t needRarityAt(uint32_t need) const { return needRarity[need]; }
+
+    // Recipes with at least one need on material, in recipe order
+    const uint32_t* recipesUsingBegin(MaterialId material) const;
+    const uint32_t* recipesUsingEnd(MaterialId material) const;
+
+    static constexpr uint32_t NO_NEED = UINT32_MAX;
+
+    // Whether every need of the recipe is met; counts must have materialSlots() entries
+    bool canCraft(size_t recipe, const std::vector<int32_t>& counts) const;
+    // How many times the recipe can be made; INT32_MAX if it has no needs
+    int32_t maxCrafts(size_t recipe, const std::vector<int32_t>& counts) const;
+    // The need whose stock covers the fewest crafts; it alone decides
+    // maxCrafts. NO_NEED if the recipe has no needs.
+    uint32_t bottleneckNeed(size_t recipe, const std::vector<int32_t>& counts) const;
+    // Whether need covers fewer crafts than other, compared exactly (not floored);
+    // ties go to the earlier need, so the bottleneck is the same however it was found
+    bool limitsMore(uint32_t need, uint32_t other, const std::vector<int32_t>& counts) const {
+        int64_t lhs = static_cast<int64_t>(counts[needMaterial[need]]) * needQuantity[other];
+        int64_t rhs = static_cast<int64_t>(counts[needMaterial[other]]) * needQuantity[need];
+        return lhs < rhs || (lhs == rhs && need < other);
+    }
+
+    // Evaluate all recipes at once. out[i] is 1 if recipe i can be crafted.
+    void canCraftAll(const std::vector<int32_t>& counts, std::vector<uint8_t>& out) const;
+    void maxCraftsAll(const std::vector<int32_t>& counts, std::vector<int32_t>& out) const;
+    // Same pass, also recording each recipe's bottleneck need
+    void maxCraftsAll(const std::vector<int32_t>& counts, std::vector<int32_t>& out,
+                      std::vector<uint32_t>& bottlenecks) const;
+
+private:
+    // Hot: one entry per merged need
+    std::vector<uint32_t> needBegin;      // recipeCount() + 1 offsets
+    std::vector<MaterialId> needMaterial;
+    std::vector<int32_t> needQuantity;
+    std::vector<uint32_t> needRecipe;     // Owning recipe, so bulk passes need no inner loop
+    // Only read when consuming, so kept out of the matching loops
+    std::vector<int32_t> needRarity;
+
+    // Reverse index, same layout: recipes using material m are
+    // usingRecipes[usingBegin[m], usingBegin[m + 1])
+    std::vector<uint32_t> usingBegin;
+    std::vector<uint32_t> usingRecipes;
+
+    size_t slots = 0;
+};
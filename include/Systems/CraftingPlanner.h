@@ -0,0 +1,72 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Core/CardId.h"
+#include "Systems/CompiledRecipes.h"
+
+class CraftingSystem;
+class Inventory;
+struct InventoryState;
+
+// One step of a plan: craft a recipe this many times
+struct CraftingPlanStep {
+    std::string recipeId;
+    int crafts = 0;
+};
+
+struct CraftingPlan {
+    bool feasible = false;                  // Every input is in stock or can be crafted
+    std::vector<CraftingPlanStep> steps;    // Execution order; the requested recipe is last
+    std::vector<std::pair<MaterialId, int>> missing;  // Uncraftable materials still lacking
+    int totalCrafts = 0;
+};
+
+/**
+ * Plans how to craft a recipe from what the inventory holds, crafting
+ * intermediate ingredients along the way.
+ *
+ * Unlocked recipes form a producer graph (material -> recipes that make it).
+ * For every material the planner memoizes the cheapest way to make it: the
+ * expected number of crafts per unit, where a craft that fails as often as
+ * it succeeds counts double. Materials nothing produces cost one unit each.
+ * Costs are settled smallest first, and a recipe is only considered once all
+ * its inputs are settled, so cycles in the graph cannot recurse forever and
+ * the chosen recipes always form a DAG.
+ *
+ * A plan walks that DAG from the requested recipe, using stock first and
+ * crafting only the shortfall. The producer graph is rebuilt when the recipe
+ * generation changes; finished plans are cached until the inventory changes.
+ */
+class CraftingPlanner {
+public:
+    explicit CraftingPlanner(const CraftingSystem& craftingSystem);
+
+    // Plan for crafting the recipe count times. The reference stays valid until
+    // the next call.
+    const CraftingPlan& plan(const std::string& recipeId, int count, const Inventory& inventory);
+
+    // Expected crafts to make one unit of material from scratch; infinity if impossible
+    float unitCost(MaterialId material);
+
+private:
+    const CraftingSystem& craftingSystem;
+
+    // Producer graph over unlocked recipes, indexed like getAllRecipes()
+    uint64_t graphGeneration = UINT64_MAX;
+    CompiledRecipes compiled;
+    std::vector<MaterialId> resultMaterial;
+    std::vector<float> resultYield;         // Expected units per craft: quantity x success rate
+    std::vector<float> cost;                // Per material
+    std::vector<int32_t> bestRecipe;        // Per material; -1 for raw or unobtainable
+
+    // Plans for one inventory version, keyed by recipe id and count
+    uint64_t planInventory = 0;
+    uint64_t planVersion = 0;
+    std::unordered_map<std::string, CraftingPlan> plans;
+    CraftingPlan rejected;  // Returned for unknown or locked recipes
+
+    void syncGraph();
+    CraftingPlan expand(size_t recipeIndex, int count, const InventoryState& contents) const;
+};
@@ -0,0 +1,87 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <string>
+#include <vector>
+#include "Core/Card.h"
+
+class CraftingSystem;
+class Inventory;
+class BaseManager;
+
+// One queued request to craft a recipe several times
+struct CraftingJob {
+    uint32_t id = 0;
+    std::string recipeId;
+    Card result{"", 1, CardType::MISC};
+    int count = 0;                  // Items requested
+    int started = 0;                // Items handed to a station
+    int completed = 0;              // Items finished, successful or not
+    int succeeded = 0;
+    float successRate = 1.0f;       // Fixed when the materials are reserved
+    std::vector<std::pair<CardId, int>> needs;  // Per item: preferred stack and quantity
+    std::vector<Card> reserved;     // Materials held for the items not completed yet
+
+    bool isFinished() const { return completed >= count; }
+};
+
+/**
+ * Timed crafting queue.
+ *
+ * enqueue() takes the materials for every item of a job out of the inventory
+ * in a single batch, so crafting N items validates and consumes once instead
+ * of N times. update() advances simulated time: each crafting station works
+ * on one item at a time, and there is one station plus one per operational
+ * workshop. Items finished during an update() are added to the inventory in
+ * one batch. cancel() returns the materials of every item not yet completed.
+ *
+ * Not thread safe; drive it from the main loop.
+ */
+class CraftingQueue {
+public:
+    using ProgressCallback = std::function<void(const CraftingJob& job, float itemProgress)>;
+    using ItemCallback = std::function<void(const CraftingJob& job, bool success)>;
+    using JobCallback = std::function<void(const CraftingJob& job)>;
+
+    CraftingQueue(CraftingSystem& craftingSystem, Inventory& inventory, const BaseManager* baseManager = nullptr);
+
+    // Returns the new job's id, or 0 if the recipe is locked or unknown or materials are short
+    uint32_t enqueue(const std::string& recipeId, int count);
+    bool cancel(uint32_t jobId);
+    void update(float deltaSeconds);
+
+    int getStationCount() const;
+    const std::deque<CraftingJob>& getJobs() const { return jobs; }
+    const CraftingJob* getJob(uint32_t jobId) const;
+    bool isIdle() const { return jobs.empty(); }
+
+    // Progress of every busy station, reported once per update
+    void setOnProgress(ProgressCallback callback) { onProgress = callback; }
+    void setOnItemCompleted(ItemCallback callback) { onItemCompleted = callback; }
+    void setOnJobFinished(JobCallback callback) { onJobFinished = callback; }
+
+private:
+    struct Station {
+        uint32_t jobId = 0;     // 0 while idle
+        float elapsed = 0.0f;   // Seconds spent on the current item
+    };
+
+    CraftingSystem& craftingSystem;
+    Inventory& inventory;
+    const BaseManager* baseManager;
+
+    std::deque<CraftingJob> jobs;
+    std::vector<Station> stations;
+    uint32_t nextJobId = 1;
+
+    ProgressCallback onProgress;
+    ItemCallback onItemCompleted;
+    JobCallback onJobFinished;
+
+    CraftingJob* findJob(uint32_t jobId);
+    void resizeStations();
+    bool startNextItem(Station& station);
+    void finishItem(CraftingJob& job, class InventoryBatch& output);
+    void useReservedMaterials(CraftingJob& job);
+};
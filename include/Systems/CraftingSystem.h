@@ -3,6 +3,7 @@
 #include <string>
 #include <unordered_map>
 #include "Core/Card.h"
+#include "Systems/CompiledRecipes.h"
 
 // Forward declarations
 namespace DataManagement {
@@ -49,10 +50,26 @@ public:
     const std::vector<Recipe>& getAllRecipes() const;
     const std::vector<Recipe> getAvailableRecipes(const class Inventory& inventory) const;
     
+    // Cached per-recipe state, brought up to date from the inventory's delta log
+    // on each call; only recipes using a changed material are re-evaluated.
+    bool isCraftable(size_t recipeIndex, const class Inventory& inventory) const;
+    int getMaxCraftCount(size_t recipeIndex, const class Inventory& inventory) const;
+    // Ingredient limiting getMaxCraftCount: the one whose stock covers the fewest
+    // crafts. INVALID_MATERIAL_ID for unknown recipes or ones without ingredients.
+    MaterialId getBottleneckMaterial(size_t recipeIndex, const class Inventory& inventory) const;
+    
+    // Building blocks shared with CraftingQueue
+    void addIngredientRemovals(const Recipe& recipe, class InventoryBatch& batch, int times = 1) const;
+    float calculateActualSuccessRate(const Recipe& recipe, const class Inventory& inventory) const;
+    static Card createScrap();  // Consolation item for some failed crafts
+    
     // Recipe management
+    void addRecipe(const Recipe& recipe);
     void unlockRecipe(const std::string& recipeId);
     bool isRecipeUnlocked(const std::string& recipeId) const;
     const Recipe* getRecipe(const std::string& recipeId) const;
+    // Changes whenever recipes are added, removed, replaced or unlocked
+    uint64_t getRecipeGeneration() const { return recipeGeneration; }
     
     // Initialize recipes
     void initializeDefaultRecipes();
@@ -62,9 +79,22 @@ public:
 private:
     std::vector<Recipe> recipes;
     std::unordered_map<std::string, size_t> recipeIndexMap;  // Fast recipe lookup
+    uint64_t recipeGeneration = 0;
+    
+    // Hot ingredient data, recompiled on first use after the recipe list changes
+    mutable CompiledRecipes compiled;
+    mutable bool recipesCompiled = false;
+    
+    // Craftability cache, parallel to recipes
+    mutable std::vector<int32_t> materialCounts;   // Indexed by MaterialId, any rarity
+    mutable std::vector<uint32_t> bottleneckNeeds; // Compiled need index limiting each recipe
+    mutable std::vector<int32_t> maxCrafts;
+    mutable uint64_t availabilityInventory = 0;    // Instance id the counts belong to
+    mutable uint64_t availabilityVersion = 0;
     
     // Helper methods
-    bool hasEnoughMaterials(const Recipe& recipe, const class Inventory& inventory) const;
-    void consumeMaterials(const Recipe& recipe, class Inventory& inventory);
-    float calculateActualSuccessRate(const Recipe& recipe, const class Inventory& inventory) const;
+    void syncAvailability(const class Inventory& inventory) const;
+    void compileRecipes() const;
+    void recountAvailability(const class Inventory& inventory) const;
+    void evaluateAvailability(size_t recipeIndex) const;
 };
@@ -2,8 +2,11 @@
 #include <string>
 #include <vector>
 #include <unordered_map>
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include "Core/Card.h"
+#include "Core/CardId.h"
 #include "Core/Event.h"
 
 // Forward declarations
@@ -11,6 +14,7 @@ struct Recipe;
 class Inventory;
 class CraftingSystem;
 class Controller;
+class DataPack;
 
 /**
  * Version management and validation system for game data
@@ -49,7 +53,7 @@ namespace DataManagement {
         int rarity;
         CardType type;
         int baseQuantity = 1;
-        std::unordered_map<AttributeType, float> attributes;
+        AttributeSet attributes;
         
         // Convert to/from Card
         Card toCard() const;
@@ -70,6 +74,30 @@ namespace DataManagement {
         bool isUnlocked;
     };
 
+    /**
+     * One loot entry: a material stack, a nested table or, inside tables
+     * only, an event. An entry naming none of them yields nothing.
+     */
+    struct LootEntryData {
+        std::string material;
+        int rarity = 1;
+        std::string table;
+        std::string event;                             // Event ID
+        float weight = 1.0f;                           // Ignored in event rewards and penalties
+        int minQuantity = 1;                           // Units of a material, rolls of a table
+        int maxQuantity = 1;
+        std::string requiresMaterial;                  // Only applies while the inventory holds it
+        int requiresCount = 1;
+    };
+
+    /**
+     * Weighted loot table; entries are picked by weight
+     */
+    struct LootTableData {
+        std::string id;
+        std::vector<LootEntryData> entries;
+    };
+
     /**
      * Event data structure for JSON serialization
      */
@@ -85,6 +113,17 @@ namespace DataManagement {
         std::vector<std::string> rewardMaterials;      // Reward materials (legacy)
         std::vector<std::string> penaltyMaterials;     // Penalty materials (legacy)
         float probability;                             // Event probability (legacy)
+        std::vector<LootEntryData> rewards;            // Replace rewardMaterials when present
+        std::vector<LootEntryData> penalties;          // Replace penaltyMaterials when present
+    };
+
+    /**
+     * Wall time spent reading and parsing one data file
+     */
+    struct FileLoadTiming {
+        std::string file;
+        double milliseconds = 0.0;
+        bool loaded = false;
     };
 
     /**
@@ -114,6 +153,12 @@ namespace DataManagement {
 
     /**
      * Centralized data manager for loading, validating, and managing game data
+     *
+     * Materials are indexed by (name, rarity) and by name, recipes by id, so
+     * lookups are O(1). The indices are rebuilt whenever a whole list is
+     * replaced (loading, setMaterials/setRecipes) and kept up to date by the
+     * single-item add/update/remove functions the editor uses. With duplicate
+     * keys the first entry in the list wins, as with a linear search.
      */
     class GameDataManager {
     public:
@@ -126,9 +171,25 @@ namespace DataManagement {
         bool loadRecipes(const std::string& recipesPath = "data/recipes.json");
         bool loadEvents(const std::string& eventsPath = "data/events.json");
         
-        // Load all data files
+        // Load all data files: from the compiled pack when it matches the
+        // JSON, otherwise the four files are read and parsed in parallel,
+        // then validated together
         bool loadAllData(const std::string& dataDirectory = "data/");
         
+        // Compiled data pack (DataPack::FILE_NAME in the data directory).
+        // compileDataPack parses and validates the JSON now on disk and packs
+        // that, never a manager's in-memory lists; loadDataPack fails if the
+        // pack is missing, damaged or stale, and keeps it mapped for
+        // getDataPack() otherwise
+        static bool compileDataPack(const std::string& dataDirectory = "data/");
+        bool loadDataPack(const std::string& dataDirectory = "data/");
+        // The pack the data came from, or nullptr after a JSON load. It shows
+        // the data as compiled, without later edits. Loading a pack reads
+        // only the config; the lists are built from it on first access.
+        const DataPack* getDataPack() const { return dataPack.get(); }
+        // Per-file timings of the last loadAllData, in load order
+        const std::vector<FileLoadTiming>& getLoadTimings() const { return loadTimings; }
+        
         // Saving functions
         bool saveGameConfig(const std::string& configPath = "data/game_config.json") const;
         bool saveMaterials(const std::string& materialsPath = "data/materials.json") const;
@@ -150,20 +211,36 @@ namespace DataManagement {
 
         // Data access
         const GameConfig& getGameConfig() const { return gameConfig; }
-        const std::vector<MaterialData>& getMaterials() const { return materials; }
-        const std::vector<RecipeData>& getRecipes() const { return recipes; }
-        const std::vector<EventData>& getEvents() const { return events; }
+        const std::vector<MaterialData>& getMaterials() const;
+        const std::vector<RecipeData>& getRecipes() const;
+        const std::vector<EventData>& getEvents() const;
+        const std::vector<LootTableData>& getLootTables() const;
+        const Version& getMaterialsVersion() const { return materialsVersion; }
+        const Version& getRecipesVersion() const { return recipesVersion; }
+        const Version& getEventsVersion() const { return eventsVersion; }
 
         // Data modification
         void setGameConfig(const GameConfig& config) { gameConfig = config; }
-        void setMaterials(const std::vector<MaterialData>& mats) { materials = mats; }
-        void setRecipes(const std::vector<RecipeData>& recs) { recipes = recs; }
-        void setEvents(const std::vector<EventData>& evts) { events = evts; }
+        void setMaterials(const std::vector<MaterialData>& mats);
+        void setRecipes(const std::vector<RecipeData>& recs);
+        void setEvents(const std::vector<EventData>& evts);
+        void setLootTables(const std::vector<LootTableData>& tables);
+
+        // Single-item edits; these keep the lookup indices current
+        void addMaterial(const MaterialData& material);
+        bool updateMaterial(const std::string& name, int rarity, const MaterialData& material);
+        bool removeMaterial(const std::string& name, int rarity);
+        void addRecipe(const RecipeData& recipe);
+        bool updateRecipe(const std::string& id, const RecipeData& recipe);
+        bool removeRecipe(const std::string& id);
 
-        // Utility functions
+        // Utility functions. Pointers stay valid until the list changes; change
+        // a name, rarity or id through update*, not through a returned pointer.
         bool materialExists(const std::string& name, int rarity) const;
         MaterialData* findMaterial(const std::string& name, int rarity);
         const MaterialData* findMaterial(const std::string& name, int rarity) const;
+        // First material with this name, whatever its rarity
+        const MaterialData* findMaterialByName(const std::string& name) const;
         
         RecipeData* findRecipe(const std::string& id);
         const RecipeData* findRecipe(const std::string& id) const;
@@ -182,20 +259,34 @@ namespace DataManagement {
 
     private:
         GameConfig gameConfig;
-        std::vector<MaterialData> materials;
-        std::vector<RecipeData> recipes;
-        std::vector<EventData> events;
+        // Mutable because after a pack load they are built on first access,
+        // which may be a const one; everything else goes through ensureData()
+        mutable std::vector<MaterialData> materials;
+        mutable std::vector<RecipeData> recipes;
+        mutable std::vector<EventData> events;
+        mutable std::vector<LootTableData> lootTables; // Stored in events.json
+        std::vector<FileLoadTiming> loadTimings;
+        std::unique_ptr<DataPack> dataPack;
+        // Set while the lists above still have to be read from dataPack
+        mutable std::atomic<bool> packPending{false};
+        mutable std::mutex packMutex;
+
+        // Lookup indices into materials and recipes; index lists are ascending
+        mutable std::unordered_map<CardId, uint32_t> materialIndex;
+        mutable std::unordered_map<MaterialId, std::vector<uint32_t>> materialsByName;
+        mutable std::unordered_map<std::string, uint32_t> recipeIndex;
 
         // Version tracking for each file
         Version materialsVersion;
         Version recipesVersion;
         Version eventsVersion;
 
-        // Helper functions for JSON parsing
-        bool parseGameConfigJson(const std::string& jsonContent);
-        bool parseMaterialsJson(const std::string& jsonContent);
-        bool parseRecipesJson(const std::string& jsonContent);
-        bool parseEventsJson(const std::string& jsonContent);
+        // Streaming JSON parsing over a file's bytes; on error the current
+        // data is left as it was
+        bool parseGameConfigJson(const char* begin, const char* end);
+        bool parseMaterialsJson(const char* begin, const char* end);
+        bool parseRecipesJson(const char* begin, const char* end);
+        bool parseEventsJson(const char* begin, const char* end);
 
         // Helper functions for JSON generation
         std::string generateGameConfigJson() const;
@@ -203,8 +294,23 @@ namespace DataManagement {
         std::string generateRecipesJson() const;
         std::string generateEventsJson() const;
 
+        // The JSON half of loadAllData: parse the four files, then validate
+        bool loadJsonData(const std::string& dataDirectory);
+
+        // Reads the lists from a loaded pack if that has not happened yet;
+        // safe to call from several threads
+        void ensureData() const;
+
+        // Index maintenance
+        void rebuildMaterialIndex() const;
+        void rebuildRecipeIndex() const;
+        void indexMaterial(uint32_t index) const;
+        void unindexMaterial(uint32_t index);
+        void unindexRecipe(uint32_t index);
+        int findMaterialIndex(const std::string& name, int rarity) const;
+        int findRecipeIndex(const std::string& id) const;
+
         // File I/O helpers
-        bool readFileContent(const std::string& filePath, std::string& content) const;
         bool writeFileContent(const std::string& filePath, const std::string& content) const;
         bool ensureDirectoryExists(const std::string& dirPath) const;
     };
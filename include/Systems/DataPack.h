@@ -0,0 +1,100 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Core/MappedFile.h"
+#include "Systems/DataManager.h"
+
+/**
+ * Compiled, read-only form of the JSON data set (game config, materials,
+ * recipes, events and loot tables) in one binary file.
+ *
+ * The file is a fixed header followed by sections of fixed-layout records.
+ * Every string lives once in a shared string table and records refer to it
+ * by offset and length, so the pack is used straight from a read-only
+ * memory mapping without parsing. Materials by (name, rarity) and recipes
+ * by id have precomputed open-addressing hash tables.
+ *
+ * The header stores the size and modification time of each JSON source
+ * the pack was compiled from, plus a hash of their contents. isCurrent()
+ * only stats the files; it hashes them only when a stamp differs, so an
+ * edit that restores the same content keeps the pack. A stale pack is
+ * simply ignored in favour of the JSON. Records use host byte order; a
+ * pack from a machine with the other byte order fails to open.
+ *
+ * open() checks only the header and section bounds, so it does not touch
+ * the payload; every read is bounds-checked. The payload hash is checked
+ * by verify(), which the compiler runs on what it wrote.
+ */
+class DataPack {
+public:
+    static constexpr uint32_t FORMAT_VERSION = 2;
+    static constexpr const char* FILE_NAME = "game_data.pack";
+
+    // Size and modification time of one source file
+    struct SourceStamp {
+        uint64_t size;
+        int64_t modified;       // Ticks of the filesystem clock
+    };
+
+    // The JSON files a pack is compiled from, in hashing order
+    static const std::vector<std::string>& sourceFiles();
+    // FNV-1a over the source files in dataDirectory; false if one is missing
+    static bool hashSources(const std::string& dataDirectory, uint64_t& hash);
+    // One stamp per source file; false if one is missing
+    static bool stampSources(const std::string& dataDirectory, std::vector<SourceStamp>& stamps);
+
+    // Compiles data into a pack at path (written to a temporary file, then
+    // renamed). Take the stamps before hashing, so an edit in between makes
+    // the pack look stale rather than current.
+    static bool write(const DataManagement::GameDataManager& data, uint64_t sourceHash,
+                      const std::vector<SourceStamp>& stamps, const std::string& path, std::string& error);
+
+    DataPack() = default;
+    ~DataPack();
+    DataPack(const DataPack&) = delete;
+    DataPack& operator=(const DataPack&) = delete;
+
+    // Maps the file and checks its header and section bounds
+    bool open(const std::string& path, std::string& error);
+    void close();
+    bool isOpen() const { return base != nullptr; }
+    // Hashes the whole payload against the header; for tools, not startup
+    bool verify(std::string& error) const;
+    // True when the pack was compiled from the JSON now in dataDirectory
+    bool isCurrent(const std::string& dataDirectory) const;
+    uint64_t getSourceHash() const;
+
+    // Zero-copy views; valid while the pack stays open
+    size_t materialCount() const;
+    size_t recipeCount() const;
+    std::string_view materialName(size_t index) const;
+    int materialRarity(size_t index) const;
+    std::string_view recipeId(size_t index) const;
+    // Index lookups through the precomputed tables; -1 when absent
+    int findMaterial(std::string_view name, int rarity) const;
+    int findRecipe(std::string_view id) const;
+
+    // The game config and the materials, recipes and events versions
+    void readConfig(DataManagement::GameConfig& config, DataManagement::Version versions[3]) const;
+    // Copies the lists into the structures GameDataManager edits
+    void read(std::vector<DataManagement::MaterialData>& materials,
+              std::vector<DataManagement::RecipeData>& recipes,
+              std::vector<DataManagement::EventData>& events,
+              std::vector<DataManagement::LootTableData>& lootTables) const;
+
+private:
+    struct Header;
+
+    MappedFile file;
+    const unsigned char* base = nullptr;   // file.data() while open
+    size_t size = 0;
+
+    const Header& header() const;
+    template <typename T>
+    const T* section(int id) const;
+    size_t sectionCount(int id) const;
+    std::string_view text(uint32_t offset, uint32_t length) const;
+};
@@ -0,0 +1,59 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Core/CardId.h"
+#include "Core/Inventory.h"
+#include "Systems/CompiledEvents.h"
+
+class Rng;
+
+/**
+ * Keeps the triggerable flag of every compiled event current without
+ * polling them all each tick.
+ *
+ * Callers report which inputs changed (a material count, the turn, health,
+ * location) and update() re-checks only the events that read one of them,
+ * looked up in the CompiledEvents reverse index. syncInventory() turns the
+ * inventory's delta log into material changes and keeps the counts in the
+ * EventState in step, so no snapshot is rescanned unless the log has
+ * overflowed.
+ *
+ * Events with a random chance give a new answer every time they are
+ * checked, so they are re-checked on every update().
+ */
+class EventTriggers {
+public:
+    // Points at events, which must outlive this; everything is checked on the next update()
+    void reset(const CompiledEvents& events);
+
+    void materialChanged(MaterialId material);
+    void inputChanged(CompiledEvents::Input input);
+    void allChanged() { everything = true; }
+
+    // Applies inventory changes since the last sync to state.counts and marks
+    // the materials they touched. A new inventory or an overflowed delta log
+    // falls back to a full read.
+    void syncInventory(const Inventory& inventory, EventState& state);
+
+    // Re-checks the affected events; returns how many were checked
+    size_t update(const EventState& state, Rng& rng);
+
+    bool canTrigger(size_t event) const { return event < triggerable.size() && triggerable[event]; }
+    // triggerable[i] is 1 if event i could trigger at the last update()
+    const std::vector<uint8_t>& getTriggerable() const { return triggerable; }
+
+private:
+    const CompiledEvents* events = nullptr;
+    std::vector<uint8_t> triggerable;
+    std::vector<uint32_t> pending;      // Events to re-check, each once
+    std::vector<uint8_t> queued;        // Per event: already in pending
+    std::vector<uint32_t> scratch;
+    std::vector<InventoryDelta> deltas;
+    bool everything = true;
+
+    uint64_t inventoryInstance = 0;
+    uint64_t inventoryVersion = 0;
+    bool inventorySynced = false;
+
+    void queue(const std::vector<uint32_t>& affected);
+};
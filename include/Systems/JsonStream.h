@@ -0,0 +1,91 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+/**
+ * Base for streaming JSON readers on top of nlohmann's SAX interface.
+ *
+ * The parser reports keys, scalars and container boundaries as it reads,
+ * and a reader fills its target structs straight from those events: no
+ * DOM is built, so memory stays close to the size of the result. Input is
+ * a byte range, typically a MappedFile.
+ *
+ * The base tracks the position in the document. depth() counts the open
+ * containers (1 inside the root object), and name(level) is the key the
+ * container at that level sits under ("" for array elements and the root).
+ * Begin callbacks see the new container as the innermost one, end
+ * callbacks still see the closing one.
+ *
+ * Unknown keys and containers can simply be ignored. A callback returns
+ * false to stop the parse, after fail() or get() recorded why.
+ */
+class JsonStreamReader : public nlohmann::json_sax<nlohmann::json> {
+public:
+    // Parses [begin, end); false with getError() set on malformed or rejected input
+    bool parse(const char* begin, const char* end);
+    const std::string& getError() const { return error; }
+
+    // nlohmann::json_sax
+    bool null() override;
+    bool boolean(bool value) override;
+    bool number_integer(number_integer_t value) override;
+    bool number_unsigned(number_unsigned_t value) override;
+    bool number_float(number_float_t value, const string_t& text) override;
+    bool string(string_t& value) override;
+    bool binary(binary_t& value) override;
+    bool start_object(std::size_t elements) override;
+    bool key(string_t& value) override;
+    bool end_object() override;
+    bool start_array(std::size_t elements) override;
+    bool end_array() override;
+    bool parse_error(std::size_t position, const std::string& lastToken,
+                     const nlohmann::detail::exception& ex) override;
+
+protected:
+    // One scalar; strings are moved out of the parser by get()
+    struct Scalar {
+        enum class Type { Null, Boolean, Integer, Unsigned, Float, String };
+        Type type = Type::Null;
+        bool boolean = false;
+        int64_t integer = 0;
+        uint64_t unsignedValue = 0;
+        double number = 0.0;
+        std::string* text = nullptr;
+    };
+
+    virtual bool onValue(const std::string& key, Scalar& value) = 0;
+    virtual bool onBeginObject() { return true; }
+    virtual bool onEndObject() { return true; }
+    virtual bool onBeginArray() { return true; }
+    virtual bool onEndArray() { return true; }
+
+    size_t depth() const { return frames.size(); }
+    const std::string& name(size_t level) const;
+    bool isArray(size_t level) const;
+
+    // Convert a scalar, failing on the wrong type as the DOM accessors did;
+    // numbers convert between integer and floating point
+    bool get(Scalar& value, std::string& out);
+    bool get(Scalar& value, int& out);
+    bool get(Scalar& value, float& out);
+    bool get(Scalar& value, bool& out);
+    bool get(Scalar& value, uint64_t& out);
+    bool fail(const std::string& message);
+
+private:
+    struct Frame {
+        bool array;
+        std::string name;   // Key in the parent object
+        std::string key;    // Current key, for objects
+    };
+
+    std::vector<Frame> frames;
+    std::string error;
+
+    const std::string& currentKey() const;
+    bool scalar(Scalar& value);
+    bool wrongType(const char* expected);
+};
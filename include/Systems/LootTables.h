@@ -0,0 +1,135 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Core/Card.h"
+#include "Core/Event.h"
+
+class Inventory;
+class Rng;
+
+namespace DataManagement {
+    class GameDataManager;
+    struct ValidationResult;
+}
+
+// One resolved stack change; item indexes LootTables::getItem()
+struct LootDrop {
+    uint32_t item;
+    int quantity;
+};
+
+// Everything one or more rolls produced, in roll order
+struct LootResult {
+    std::vector<uint32_t> events;   // Events that fired, for messages
+    std::vector<LootDrop> gained;
+    std::vector<LootDrop> lost;
+
+    void clear() { events.clear(); gained.clear(); lost.clear(); }
+};
+
+// Running totals for simulations; vectors grow to the item and event counts
+struct LootTotals {
+    std::vector<int64_t> gained;    // Per item
+    std::vector<int64_t> lost;      // Per item
+    std::vector<uint32_t> events;   // Times each event fired
+    uint64_t rolls = 0;
+    uint64_t empty = 0;             // Rolls that produced nothing
+};
+
+/**
+ * Loot and exploration outcomes compiled for constant-time sampling.
+ *
+ * A table is a weighted list of entries. An entry yields nothing, a stack
+ * with a quantity drawn from [min, max], a roll of another table, or an
+ * event. An event applies all of its rewards and penalties, which may roll
+ * tables themselves. Tables are compiled into Vose alias tables, so a roll
+ * costs one random number and one comparison however many entries there
+ * are. Stacks are kept once as prototype cards and results refer to them by
+ * index, so rolling copies no Card.
+ *
+ * An entry may require a material in the inventory. The condition is checked
+ * after the entry is picked and a failed check yields nothing, so sampling
+ * stays O(1) and the chance of every other entry is unchanged.
+ *
+ * Built either from the legacy Constants::EXPLORATION_EVENTS or from the
+ * events and loot_tables of events.json. In both cases the "exploration"
+ * table picks one active event by probability; probabilities summing to less
+ * than one leave the rest as "nothing happens". events.json may define its
+ * own "exploration" table instead.
+ */
+class LootTables {
+public:
+    static constexpr uint32_t NONE = UINT32_MAX;
+    static constexpr const char* EXPLORATION = "exploration";
+
+    void clear();
+    void compileEvents(const std::vector<Event>& events);
+    // Unknown materials, tables or events and table cycles are reported as
+    // errors; the offending entries are dropped and the rest still compiles
+    DataManagement::ValidationResult compile(const DataManagement::GameDataManager& data);
+
+    uint32_t findTable(const std::string& id) const;
+    size_t tableCount() const { return tables.size(); }
+    size_t itemCount() const { return items.size(); }
+    size_t eventCount() const { return events.size(); }
+    const Card& getItem(uint32_t item) const { return items[item]; }
+    const std::string& getEventDescription(uint32_t event) const { return events[event].description; }
+
+    // Roll a table once, appending to result
+    void sample(uint32_t table, Rng& rng, const Inventory& inventory, LootResult& result) const;
+    // Roll a table n times, adding up what came out without keeping single rolls
+    void sampleN(uint32_t table, size_t n, Rng& rng, const Inventory& inventory, LootTotals& totals) const;
+    // Roll a table once into result (cleared first) and apply what it yields
+    // to the inventory as one batch, so rewards and penalties land together
+    // or not at all. Returns false if the inventory rejected the batch.
+    bool apply(uint32_t table, Rng& rng, Inventory& inventory, LootResult& result) const;
+
+private:
+    enum class Kind : uint8_t { Nothing, Item, Table, Event };
+
+    // Hot: read on every roll
+    struct Entry {
+        Kind kind = Kind::Nothing;
+        uint32_t target = NONE;             // Item, table or event index
+        int32_t minQuantity = 1;            // Units of an item, rolls of a table
+        int32_t maxQuantity = 1;
+        MaterialId requiredMaterial = INVALID_MATERIAL_ID;
+        int32_t requiredCount = 0;
+    };
+
+    struct Table {
+        uint32_t first = 0;                 // Entries and alias slots [first, first + size)
+        uint32_t size = 0;
+    };
+
+    struct CompiledEvent {
+        std::string description;
+        std::vector<Entry> rewards;         // Every entry applies
+        std::vector<Entry> penalties;
+    };
+
+    std::vector<Entry> entries;
+    std::vector<float> aliasChance;         // Chance to keep the slot's own entry
+    std::vector<uint32_t> aliasOther;       // Entry taken otherwise, relative to the table
+    std::vector<Table> tables;
+    std::unordered_map<std::string, uint32_t> tableIds;
+    std::vector<CompiledEvent> events;
+
+    std::vector<Card> items;                // Prototype stacks, quantity 1
+    std::unordered_map<CardId, uint32_t> itemIds;
+
+    uint32_t addItem(const Card& card);
+    void addTable(const std::string& id, const std::vector<Entry>& tableEntries, const std::vector<float>& weights);
+    // Exploration table over every event, by probability, plus the "nothing" remainder
+    void addExplorationTable(const std::vector<float>& probabilities);
+
+    // Cut every reference that leads back into a table or event being rolled
+    void breakCycles(DataManagement::ValidationResult& result);
+
+    template <typename Emit>
+    void roll(uint32_t table, bool gain, Rng& rng, const Inventory& inventory, Emit& emit) const;
+    template <typename Emit>
+    void apply(const Entry& entry, bool gain, Rng& rng, const Inventory& inventory, Emit& emit) const;
+};
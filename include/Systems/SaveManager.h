@@ -8,7 +8,9 @@
 /**
  * The SaveManager class handles game saving and loading functionality.
  * Uses RAII principles to manage file resources.
- * Stores game data in JSON format.
+ * Stores game data in JSON format, including the random seed and the state
+ * of every random stream, so a loaded save continues with the same random
+ * outcomes the game would have had at the save point.
  */
 class SaveManager {
 public:
@@ -47,9 +49,6 @@ private:
     nlohmann::json cardToJson(const Card& card) const;
     nlohmann::json inventoryToJson(const Inventory& inventory) const;
     
-    Card jsonToCard(const nlohmann::json& cardJson) const;
-    void jsonToInventory(const nlohmann::json& json, Inventory& inventory) const;
-    
     // Error handling
     void logError(const std::string& message) const;
 };
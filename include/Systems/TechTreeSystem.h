@@ -2,6 +2,7 @@
 #include "Interface/ui/TechTree.h"
 #include "Interface/ui/TechTreeUI.h"
 #include "Systems/DataManager.h"
+#include "Core/TimerWheel.h"
 #include <nlohmann/json.hpp>
 #include <memory>
 #include <functional>
@@ -31,7 +32,9 @@ private:
     std::function<bool(int)> onResourceConsume;                         ///< Resource consumption callback
     
     // Timer
-    float researchTimer = 0.0f;                                         ///< Research timer
+    float researchTimer = 0.0f;                                         ///< Research timer, without a timer wheel
+    TimerWheel* timers = nullptr;                                       ///< Game clock driving research, if set
+    TimerWheel::TimerId researchTick = TimerWheel::NONE;                ///< Recurring research timer
 
 public:
     /**
@@ -67,9 +70,16 @@ public:
     /**
      * @brief Update system (process automatic research progress)
      * @param deltaTime Time difference (seconds)
+     * Research only advances here when no timer wheel is attached
      */
     void update(float deltaTime);
     
+    /**
+     * @brief Drive research from a game-clock timer wheel instead of update()
+     * @param wheel Timer wheel that outlives research, or nullptr to detach
+     */
+    void setTimerWheel(TimerWheel* wheel);
+    
     /**
      * @brief Set research points
      * @param points Research points
@@ -193,6 +203,16 @@ private:
      */
     void initializeBasicTechs();
     
+    /**
+     * @brief Add one second worth of research progress to the current tech
+     */
+    void advanceResearch();
+    
+    /**
+     * @brief Cancel the recurring research timer, if any
+     */
+    void cancelResearchTick();
+    
     /**
      * @brief Load tech tree from JSON data
      * @param jsonData JSON data containing tech tree configuration
@@ -5,7 +5,7 @@
 
 BaseBuildingController::BaseBuildingController(BaseManager& baseManager, Inventory& inventory)
     : baseManager_(baseManager), inventory_(inventory), 
-      durabilityThreadActive_(false), lastError_(PlacementError::NONE) {
+      durabilityDecayActive_(false), lastError_(PlacementError::NONE) {
 }
 
 BaseBuildingController::~BaseBuildingController() {
@@ -119,6 +119,9 @@ bool BaseBuildingController::placeBuildingFromCard(const Card* card, int gridX,
     bool placementSuccess = baseManager_.placeBuilding(gridX, gridY, card->name, inventory_);
     
     if (placementSuccess) {
+        if (eventBus_) {
+            eventBus_->publish(BuildingPlacedEvent{gridX, gridY, getCardBuildingType(card)});
+        }
         notifyUser("Building placed successfully!");
         return true;
     } else {
@@ -127,22 +130,24 @@ bool BaseBuildingController::placeBuildingFromCard(const Card* card, int gridX,
     }
 }
 
-void BaseBuildingController::startDurabilityDecay() {
-    if (durabilityThreadActive_.load()) {
+void BaseBuildingController::startDurabilityDecay(TimerWheel& timers) {
+    if (durabilityDecayActive_.load()) {
         return; // Already running
     }
     
-    durabilityThreadActive_.store(true);
-    durabilityThread_ = std::thread(&BaseBuildingController::durabilityDecayWorker, this);
+    durabilityDecayActive_.store(true);
+    timers_ = &timers;
+    durabilityTimer_ = timers.scheduleEvery(Constants::DURABILITY_DECAY_INTERVAL_MS / 1000.0,
+                                            [this]() { applyDurabilityDecay(); },
+                                            TimerWheel::Dispatch::Job);
     notifyUser("Building durability decay system started");
 }
 
 void BaseBuildingController::stopDurabilityDecay() {
-    if (durabilityThreadActive_.load()) {
-        durabilityThreadActive_.store(false);
-        if (durabilityThread_.joinable()) {
-            durabilityThread_.join();
-        }
+    if (durabilityDecayActive_.load()) {
+        durabilityDecayActive_.store(false);
+        JobSystem::instance().wait(timers_->cancel(durabilityTimer_));
+        durabilityTimer_ = TimerWheel::NONE;
         notifyUser("Building durability decay system stopped");
     }
 }
@@ -243,42 +248,40 @@ void BaseBuildingController::setNotificationCallback(std::function<void(const st
     notificationCallback_ = callback;
 }
 
-void BaseBuildingController::durabilityDecayWorker() {
-    while (durabilityThreadActive_.load()) {
-        // Wait for decay interval
-        std::this_thread::sleep_for(
-            std::chrono::milliseconds(Constants::DURABILITY_DECAY_INTERVAL_MS));
-        
-        if (!durabilityThreadActive_.load()) break;
-        
-        // Apply durability decay to all buildings
-        {
-            std::lock_guard<std::mutex> lock(durabilityMutex_);
-            
-            int damagedBuildings = 0;
-            
-            // Iterate through all grid positions to find buildings
-            for (int x = 0; x < Constants::GRID_SIZE; x++) {
-                for (int y = 0; y < Constants::GRID_SIZE; y++) {
-                    Building* building = baseManager_.getBuildingAt(x, y);
-                    if (building && building->isOperational()) {
-                        int currentDurability = building->getDurability();
-                        int maxDurability = building->getMaxDurability();
-                        int decayAmount = static_cast<int>(maxDurability * Constants::DURABILITY_DECAY_RATE);
-                        decayAmount = std::max(1, decayAmount); // Minimum 1 point decay
-                        
-                        building->takeDamage(decayAmount);
-                        damagedBuildings++;
-                    }
-                }
-            }
-            
-            if (damagedBuildings > 0) {
-                notifyUser("Building maintenance: " + std::to_string(damagedBuildings) + 
-                          " buildings lost durability due to aging");
+void BaseBuildingController::applyDurabilityDecay() {
+    if (!durabilityDecayActive_.load()) {
+        return;
+    }
+    
+    std::lock_guard<std::mutex> lock(durabilityMutex_);
+    
+    int damagedBuildings = 0;
+    
+    // Iterate through all grid positions to find buildings
+    for (int x = 0; x < Constants::GRID_SIZE; x++) {
+        for (int y = 0; y < Constants::GRID_SIZE; y++) {
+            Building* building = baseManager_.getBuildingAt(x, y);
+            if (building && building->isOperational()) {
+                int currentDurability = building->getDurability();
+                int maxDurability = building->getMaxDurability();
+                int decayAmount = static_cast<int>(maxDurability * Constants::DURABILITY_DECAY_RATE);
+                decayAmount = std::max(1, decayAmount); // Minimum 1 point decay
+                
+                building->takeDamage(decayAmount);
+                damagedBuildings++;
             }
         }
     }
+    
+    if (eventBus_) {
+        // The main thread formats the message
+        if (damagedBuildings > 0) {
+            eventBus_->publish(BuildingsDecayedEvent{damagedBuildings});
+        }
+    } else if (damagedBuildings > 0) {
+        notifyUser("Building maintenance: " + std::to_string(damagedBuildings) + 
+                  " buildings lost durability due to aging");
+    }
 }
 
 bool BaseBuildingController::consumeCardFromInventory(const Card* card) {
@@ -287,18 +290,17 @@ bool BaseBuildingController::consumeCardFromInventory(const Card* card) {
     }
     
     // This should be handled by BaseManager::placeBuilding, but we can add validation here
-    auto cards = inventory_.getCards();
-    for (auto& inventoryCard : cards) {
-        if (inventoryCard.name == card->name && inventoryCard.rarity == card->rarity) {
-            return inventoryCard.quantity > 0;
-        }
-    }
-    
-    return false;
+    const Card* inventoryCard = inventory_.findCard(card->getId());
+    return inventoryCard && inventoryCard->quantity > 0;
 }
 
 void BaseBuildingController::notifyUser(const std::string& message) {
-    if (notificationCallback_) {
+    if (eventBus_) {
+        NotificationEvent event;
+        event.source = NotificationEvent::Source::BaseBuilding;
+        event.message = message;
+        eventBus_->publish(event);
+    } else if (notificationCallback_) {
         notificationCallback_(message);
     } else {
         // Fallback to console output
@@ -318,5 +320,5 @@ BuildingType BaseBuildingController::getCardBuildingType(const Card* card) const
     if (!card) return BuildingType::NONE;
     
     // Use existing conversion system from BaseManager
-    return BuildingConversion::cardToBuildingType(card->name);
+    return BuildingConversion::cardToBuildingType(card->materialId);
 }
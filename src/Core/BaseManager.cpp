@@ -2,6 +2,7 @@
 #include "Core/Building.h"
 #include <algorithm>
 #include <numeric>
+#include <unordered_map>
 
 BaseManager::BaseManager() : currentGridSize_(Constants::GRID_SIZE) {
     initializeGrid();
@@ -80,14 +81,11 @@ bool BaseManager::placeBuilding(int x, int y, const std::string& cardName, Inven
         return false;
     }
     
-    // Check if player has required resources
-    if (!hasRequiredResources(cardName, inventory)) {
+    // Check and consume required resources in one atomic inventory update
+    if (!consumeResources(cardName, inventory)) {
         return false;
     }
     
-    // Consume resources from inventory
-    consumeResources(cardName, inventory);
-    
     // Create and place building
     std::string buildingName = BuildingTypeHelper::getTypeName(buildingType);
     int durability = BuildingTypeHelper::getDefaultDurability(buildingType);
@@ -194,6 +192,16 @@ bool BaseManager::hasBuilding(BuildingType type) const {
     return false;
 }
 
+int BaseManager::countOperationalBuildings(BuildingType type) const {
+    int count = 0;
+    for (const auto* building : getAllBuildings()) {
+        if (building->getType() == type && building->isOperational()) {
+            count++;
+        }
+    }
+    return count;
+}
+
 int BaseManager::getUnlockedSlotCount() const {
     int count = 0;
     for (int x = 0; x < currentGridSize_; ++x) {
@@ -214,18 +222,16 @@ BuildingType BaseManager::getRequiredBuildingType(const std::string& cardName) c
     return BuildingConversion::cardToBuildingType(cardName);
 }
 
-bool BaseManager::hasRequiredResources(const std::string& cardName, const Inventory& inventory) const {
-    // For now, just check if the card exists in inventory
-    // This can be expanded for multi-card requirements
-    auto cards = inventory.getCards();
-    return std::any_of(cards.begin(), cards.end(), 
-                      [&cardName](const Card& card) { return card.name == cardName; });
-}
-
-void BaseManager::consumeResources(const std::string& cardName, Inventory& inventory) {
-    // Remove one instance of the required card
-    // For now, assume rarity 1 - this can be enhanced later
-    inventory.removeCard(cardName, 1);
+bool BaseManager::consumeResources(const std::string& cardName, Inventory& inventory) {
+    // Remove one instance of the required card, preferring rarity 1 but accepting
+    // any rarity; fails without touching the inventory if there is none
+    MaterialId material = MaterialRegistry::instance().find(cardName);
+    if (material == INVALID_MATERIAL_ID) {
+        return false;
+    }
+    InventoryBatch batch;
+    batch.removeAnyRarity(material, 1, 1);
+    return inventory.apply(batch);
 }
 
 nlohmann::json BaseManager::toJson() const {
@@ -284,13 +290,31 @@ void BaseManager::fromJson(const nlohmann::json& json) {
 
 // BuildingConversion namespace implementation
 namespace BuildingConversion {
+    // Building materials keyed by interned id; interning here also guarantees
+    // the names are registered before any string lookup below
+    static const std::unordered_map<MaterialId, BuildingType>& buildingMaterials() {
+        static const std::unordered_map<MaterialId, BuildingType> materials = []() {
+            auto& registry = MaterialRegistry::instance();
+            return std::unordered_map<MaterialId, BuildingType>{
+                {registry.intern("Wood"), BuildingType::WALL},
+                {registry.intern("Seed"), BuildingType::FARM},
+                {registry.intern("Metal"), BuildingType::WORKSHOP},
+                {registry.intern("Leather"), BuildingType::STORAGE},
+                {registry.intern("Stone"), BuildingType::WATCHTOWER}
+            };
+        }();
+        return materials;
+    }
+
+    BuildingType cardToBuildingType(MaterialId material) {
+        const auto& materials = buildingMaterials();
+        auto it = materials.find(material);
+        return it != materials.end() ? it->second : BuildingType::NONE;
+    }
+
     BuildingType cardToBuildingType(const std::string& cardName) {
-        if (cardName == "Wood") return BuildingType::WALL;
-        if (cardName == "Seed") return BuildingType::FARM;
-        if (cardName == "Metal") return BuildingType::WORKSHOP;
-        if (cardName == "Leather") return BuildingType::STORAGE;
-        if (cardName == "Stone") return BuildingType::WATCHTOWER;
-        return BuildingType::NONE;
+        buildingMaterials();
+        return cardToBuildingType(MaterialRegistry::instance().find(cardName));
     }
     
     std::vector<std::string> getRequiredCards(BuildingType type) {
@@ -301,6 +325,10 @@ namespace BuildingConversion {
         return {requiredCard};  // For now, each building requires only one card type
     }
     
+    bool isCardBuildable(MaterialId material) {
+        return cardToBuildingType(material) != BuildingType::NONE;
+    }
+
     bool isCardBuildable(const std::string& cardName) {
         return cardToBuildingType(cardName) != BuildingType::NONE;
     }
@@ -103,7 +103,7 @@ CardDisplayData Card::getCardDisplayData() const {
 bool Card::isEquivalentForDisplay(const ICardComparable& other) const {
     // Try to cast to Card for comparison
     if (const Card* otherCard = dynamic_cast<const Card*>(&other)) {
-        return (name == otherCard->name &&
+        return (materialId == otherCard->materialId &&
                 rarity == otherCard->rarity &&
                 quantity == otherCard->quantity &&
                 type == otherCard->type);
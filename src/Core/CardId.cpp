@@ -0,0 +1,41 @@
+#include "Core/CardId.h"
+#include <mutex>
+
+MaterialRegistry& MaterialRegistry::instance() {
+    static MaterialRegistry registry;
+    return registry;
+}
+
+MaterialId MaterialRegistry::intern(const std::string& name) {
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        auto it = ids.find(name);
+        if (it != ids.end()) {
+            return it->second;
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    auto result = ids.try_emplace(name, static_cast<MaterialId>(names.size()));
+    if (result.second) {
+        names.push_back(&result.first->first);
+    }
+    return result.first->second;
+}
+
+MaterialId MaterialRegistry::find(const std::string& name) const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    auto it = ids.find(name);
+    return it != ids.end() ? it->second : INVALID_MATERIAL_ID;
+}
+
+const std::string& MaterialRegistry::getName(MaterialId id) const {
+    static const std::string empty;
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return id < names.size() ? *names[id] : empty;
+}
+
+size_t MaterialRegistry::size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return names.size();
+}
@@ -1,28 +1,53 @@
 #include "Core/Controller.h"
 #include "Constants.h"
-#include <random>
-#include <thread>
+#include "Core/Random.h"
+#include <chrono>
 #include <iostream>
+#include <unordered_map>
 
 Controller::Controller(Inventory& inv, View& v, CraftingSystem& crafting, BaseManager& baseManager) 
-    : inventory_(inv), view_(v), craftingSystem_(crafting), baseManager_(baseManager) {
+    : inventory_(inv), view_(v), craftingSystem_(crafting), baseManager_(baseManager),
+      craftingQueue_(crafting, inv, &baseManager),
+      organizerRng_(RandomService::instance().forThread(RngStream::Inventory, 0)),
+      organizerGeneration_(RandomService::instance().getGeneration()) {
+    
+    lootTables_.compileEvents(Constants::EXPLORATION_EVENTS);
+    explorationTable_ = lootTables_.findTable(LootTables::EXPLORATION);
     
     // Create base building controller
     baseBuildingController_ = std::make_shared<BaseBuildingController>(baseManager, inventory_);
     
-    // Set up notification callback for user feedback
-    baseBuildingController_->setNotificationCallback([this](const std::string& message) {
-        std::cout << "[Base Building] " << message << std::endl;
+    // Base building reports through the event bus; handlers run in update()
+    eventBus_.subscribe<NotificationEvent>([](const NotificationEvent& event) {
+        if (event.source == NotificationEvent::Source::BaseBuilding) {
+            std::cout << "[Base Building] ";
+        }
+        std::cout << event.message.c_str() << std::endl;
+    });
+    eventBus_.subscribe<BuildingsDecayedEvent>([](const BuildingsDecayedEvent& event) {
+        std::cout << "[Base Building] Building maintenance: " << event.damagedBuildings
+                  << " buildings lost durability due to aging" << std::endl;
     });
+    baseBuildingController_->setEventBus(&eventBus_);
     
-    // Start durability decay system
-    baseBuildingController_->startDurabilityDecay();
+    // Periodic background work runs as jobs on the game clock
+    baseBuildingController_->startDurabilityDecay(timers_);
+    organizeTimer_ = timers_.scheduleEvery(
+        std::chrono::duration<double>(Constants::ORGANIZE_INTERVAL).count(),
+        [this]() { organizeInventory(); }, TimerWheel::Dispatch::Job);
     
     // Create input handler with base building support
     inputHandler_ = std::make_unique<GameInputHandler>(view_, inventory_, craftingSystem_, baseBuildingController_);
     
     // Set up callbacks for input handler
     inputHandler_->setExploreCallback([this]() { handleExplore(); });
+    inputHandler_->setQueueCraftCallback([this](const std::string& recipeId, int count) {
+        return craftingQueue_.enqueue(recipeId, count) != 0;
+    });
+}
+
+Controller::~Controller() {
+    JobSystem::instance().wait(timers_.cancel(organizeTimer_));
 }
 
 void Controller::handleEvents() {
@@ -73,9 +98,8 @@ bool Controller::isRunning() const {
 }
 
 void Controller::updateView() {
-    // Validate card pointers before rendering to prevent dangling pointer errors
-    // FIXME:
-    // inputHandler_->validateCardPointers();
+    // Drop handles to stacks removed since the last frame (O(1) per handle)
+    inputHandler_->validateCardHandles();
     
     view_.render(inventory_, inputHandler_->getSelectedCard(), 
                 inputHandler_->getMouseX(), inputHandler_->getMouseY(), 
@@ -84,50 +108,38 @@ void Controller::updateView() {
                 inputHandler_->isDragging(), inputHandler_->getDraggedCard());
 }
 
-void Controller::organizeInventory() {
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> rarityDist(Constants::RARITY_MIN, Constants::RARITY_MAX);
+void Controller::update(float deltaSeconds) {
+    craftingQueue_.update(deltaSeconds);
+    timers_.advance(deltaSeconds);
+    eventBus_.drain();
+}
 
-    while (isRunning() && organizeInventoryEnabled_) {
-        // Check if organizeInventory is enabled before processing
-        if (organizeInventoryEnabled_) {
-            std::lock_guard<std::mutex> lock(mutex_);
-            std::vector<Card> newCards;
-            for (const auto& card : inventory_.getCards()) {
-                bool merged = false;
-                for (auto& newCard : newCards) {
-                    if (newCard.name == card.name && newCard.rarity == card.rarity) {
-                        newCard.quantity += card.quantity;
-                        merged = true;
-                        break;
-                    }
-                }
-                if (!merged) newCards.push_back(card);
-            }
-            inventory_.updateCards(newCards);
-            std::random_device rd;
-            std::mt19937 gen(rd());
-            std::uniform_int_distribution<> rarityDist(Constants::RARITY_MIN, Constants::RARITY_MAX);
-            inventory_.addCard(Constants::RandomCardGenerator::generateRandomCardByRarity(rarityDist(gen)));
-        }
-        
-        // Use much shorter sleep intervals for faster shutdown response
-        // Split the total sleep time into smaller chunks for immediate response
-        const auto totalSleepTime = Constants::ORGANIZE_INTERVAL;
-        const auto shortInterval = std::chrono::milliseconds(50); // Check every 50ms instead of 100ms
-        auto elapsed = std::chrono::milliseconds(0);
-        
-        while (elapsed < totalSleepTime && isRunning() && organizeInventoryEnabled_) {
-            std::this_thread::sleep_for(shortInterval);
-            elapsed += shortInterval;
-            
-            // Early exit check every 200ms for even faster response
-            if (elapsed.count() % 200 == 0 && (!isRunning() || !organizeInventoryEnabled_)) {
-                break;
-            }
+void Controller::organizeInventory() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Work on a snapshot and only publish if the main thread has not
+    // changed the inventory in the meantime (otherwise skip this pass)
+    InventorySnapshot snapshot = inventory_.snapshot();
+    std::vector<Card> newCards;
+    std::unordered_map<CardId, size_t> mergedIndex;
+    for (const auto& card : snapshot->cards) {
+        auto result = mergedIndex.try_emplace(card.getId(), newCards.size());
+        if (result.second) {
+            newCards.push_back(card);
+        } else {
+            newCards[result.first->second].quantity += card.quantity;
         }
     }
+    inventory_.updateCards(newCards, snapshot->version);
+    
+    // Loading a game reseeds, so derive again to draw from the saved seed
+    RandomService& random = RandomService::instance();
+    uint64_t generation = random.getGeneration();
+    if (generation != organizerGeneration_) {
+        organizerRng_ = random.forThread(RngStream::Inventory, 0);
+        organizerGeneration_ = generation;
+    }
+    int rarity = organizerRng_.nextInt(Constants::RARITY_MIN, Constants::RARITY_MAX);
+    inventory_.addCard(Constants::RandomCardGenerator::generateRandomCardByRarity(rarity, organizerRng_));
 }
 
 void Controller::setSaveCallback(std::function<bool()> saveCallback) {
@@ -140,66 +152,50 @@ void Controller::setLoadCallback(std::function<bool()> loadCallback) {
     inputHandler_->setLoadCallback(loadCallback);
 }
 
-void Controller::handleExplore() {
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_real_distribution<> dist(0.0f, 1.0f);
-    float roll = dist(gen);
-    float cumulative = 0.0f;
-    for (const auto& event : Constants::EXPLORATION_EVENTS) {
-        cumulative += event.probability;
-        if (roll <= cumulative) {
-            for (const auto& card : event.rewards) {
-                inventory_.addCard(card);
-                std::cout << "Event: " << event.description << " - Gained " << card.name << " x" << card.quantity << std::endl;
-            }
-            for (const auto& card : event.penalties) {
-                safeRemoveCard(card.name, card.rarity);
-                std::cout << "Event: " << event.description << " - Lost " << card.name << " x" << card.quantity << std::endl;
-            }
-            break;
-        }
-    }
+void Controller::setLootTables(const LootTables& lootTables) {
+    lootTables_ = lootTables;
+    explorationTable_ = lootTables_.findTable(LootTables::EXPLORATION);
 }
 
-void Controller::pauseOrganizeInventory() {
-    std::lock_guard<std::mutex> lock(mutex_);
-    organizeInventoryEnabled_ = false;
-    std::cout << "Inventory organization paused for editor mode" << std::endl;
+void Controller::handleExplore() {
+    bool applied = lootTables_.apply(explorationTable_, RandomService::instance().stream(RngStream::Exploration),
+                                     inventory_, exploreResult_);
+    if (exploreResult_.gained.empty() && exploreResult_.lost.empty()) {
+        return;
+    }
+    // Data-driven tables may yield stacks without any event firing
+    std::string description = exploreResult_.events.empty()
+        ? std::string("You searched the area")
+        : lootTables_.getEventDescription(exploreResult_.events.front());
+    if (!applied) {
+        std::cout << "Event: " << description << " - Nothing to lose, nothing happened" << std::endl;
+        return;
+    }
+    inputHandler_->validateCardHandles();
+    
+    for (const auto& drop : exploreResult_.gained) {
+        std::cout << "Event: " << description << " - Gained " << lootTables_.getItem(drop.item).name << " x" << drop.quantity << std::endl;
+    }
+    for (const auto& drop : exploreResult_.lost) {
+        std::cout << "Event: " << description << " - Lost " << lootTables_.getItem(drop.item).name << " x" << drop.quantity << std::endl;
+    }
 }
 
-void Controller::resumeOrganizeInventory() {
-    std::lock_guard<std::mutex> lock(mutex_);
-    organizeInventoryEnabled_ = true;
-    std::cout << "Inventory organization resumed" << std::endl;
+void Controller::setTimersPaused(bool paused) {
+    timers_.setPaused(paused);
+    std::cout << (paused ? "Game clock paused for editor mode" : "Game clock resumed") << std::endl;
 }
 
 void Controller::stopOrganizeInventory() {
-    std::lock_guard<std::mutex> lock(mutex_);
-    organizeInventoryEnabled_ = false;
+    JobSystem::instance().wait(timers_.cancel(organizeTimer_));
+    organizeTimer_ = TimerWheel::NONE;
     std::cout << "Inventory organization stopped permanently" << std::endl;
 }
 
 void Controller::safeRemoveCard(const std::string& name, int rarity) {
-    // Find the card that will be removed to check if it's selected
-    const auto& cards = inventory_.getCards();
-    const Card* cardToRemove = nullptr;
-    
-    for (const auto& card : cards) {
-        if (card.name == name && card.rarity == rarity) {
-            cardToRemove = &card;
-            break;
-        }
-    }
-    
-    // Clear selection state if the card being removed is selected
-    if (cardToRemove) {
-        inputHandler_->validateCardPointers();  // This will clean up any invalid pointers
-    }
-    
     // Remove the card from inventory
     inventory_.removeCard(name, rarity);
     
-    // Validate pointers again after removal to ensure consistency
-    inputHandler_->validateCardPointers();
+    // Clear selection or drag state if that removed the last unit of the stack
+    inputHandler_->validateCardHandles();
 }
\ No newline at end of file
@@ -0,0 +1,57 @@
+#include "Core/EventBus.h"
+
+EventBus::EventBus() = default;
+EventBus::~EventBus() = default;
+
+size_t EventBus::nextTypeIndex() {
+    static std::atomic<size_t> next{0};
+    return next.fetch_add(1, std::memory_order_relaxed);
+}
+
+EventBus::Channel* EventBus::channelFor(size_t type) {
+    Channel* channel = channels[type].load(std::memory_order_relaxed);
+    if (!channel) {
+        ownedChannels.push_back(std::make_unique<Channel>());
+        channel = ownedChannels.back().get();
+        channels[type].store(channel, std::memory_order_release);
+    }
+    return channel;
+}
+
+EventBus::SubscriptionId EventBus::addSubscription(size_t type, std::unique_ptr<SubscriptionBase> subscription) {
+    if (type >= MAX_EVENT_TYPES) {
+        return 0;
+    }
+    Channel* channel = channelFor(type);
+    for (auto& slot : channel->slots) {
+        if (slot.load(std::memory_order_relaxed) == nullptr) {
+            subscription->id = nextId++;
+            // Publish the fully built subscription; producers may see it at once
+            slot.store(subscription.get(), std::memory_order_release);
+            subscriptions.push_back(std::move(subscription));
+            return subscriptions.back()->id;
+        }
+    }
+    return 0;
+}
+
+void EventBus::unsubscribe(SubscriptionId id) {
+    for (auto& subscription : subscriptions) {
+        if (subscription->id == id) {
+            subscription->active.store(false, std::memory_order_relaxed);
+        }
+    }
+}
+
+size_t EventBus::drain() {
+    size_t delivered = 0;
+    // By index: a handler may subscribe() and reallocate the vector. Queues
+    // added during the drain start delivering next time.
+    const size_t count = subscriptions.size();
+    for (size_t i = 0; i < count; ++i) {
+        SubscriptionBase& subscription = *subscriptions[i];
+        // At most one queue's worth, so a handler that republishes cannot loop forever
+        delivered += subscription.deliver(subscription.capacity());
+    }
+    return delivered;
+}
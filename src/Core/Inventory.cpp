@@ -1,35 +1,523 @@
 #include "Core/Inventory.h"
+#include <algorithm>
+
+void InventoryBatch::add(const Card& card) {
+    ops.push_back({OpType::ADD, card.getId(), card.quantity, addedCards.size()});
+    addedCards.push_back(card);
+}
+
+void InventoryBatch::remove(const CardId& id, int quantity) {
+    ops.push_back({OpType::REMOVE, id, quantity, 0});
+}
+
+void InventoryBatch::removeAnyRarity(MaterialId material, int quantity, int preferredRarity) {
+    ops.push_back({OpType::REMOVE_ANY_RARITY, CardId{material, preferredRarity}, quantity, 0});
+}
+
+void InventoryBatch::clear() {
+    ops.clear();
+    addedCards.clear();
+}
 
 void Inventory::addCard(const Card& card) {
     std::lock_guard<std::mutex> lock(mutex);
-    for (auto& c : cards) {
-        if (c.name == card.name && c.rarity == card.rarity) {
-            c.quantity += card.quantity;
-            return;
+    int newQuantity = cards[addCardLocked(card)].quantity;
+    bumpVersionLocked();
+    recordDeltaLocked(card.getId(), newQuantity - card.quantity, newQuantity);
+}
+
+void Inventory::removeCard(const std::string& name, int rarity) {
+    MaterialId material = MaterialRegistry::instance().find(name);
+    if (material != INVALID_MATERIAL_ID) {
+        removeCard(CardId{material, rarity});
+    }
+}
+
+void Inventory::removeCard(const CardId& id) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = index.find(id);
+    if (it == index.end()) {
+        return;
+    }
+
+    size_t slot = it->second;
+    int oldQuantity = cards[slot].quantity;
+    int newQuantity = 0;
+    if (oldQuantity > 1) {
+        newQuantity = --cards[slot].quantity;
+        adjustTotalsLocked(cards[slot], -1);
+    } else {
+        index.erase(it);
+        eraseSlot(slot);
+    }
+    bumpVersionLocked();
+    recordDeltaLocked(id, oldQuantity, newQuantity);
+}
+
+void Inventory::updateCards(const std::vector<Card>& newCards) {
+    std::lock_guard<std::mutex> lock(mutex);
+    replaceCardsLocked(newCards);
+}
+
+bool Inventory::updateCards(const std::vector<Card>& newCards, uint64_t expectedVersion) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (version.load(std::memory_order_relaxed) != expectedVersion) {
+        return false;
+    }
+    replaceCardsLocked(newCards);
+    return true;
+}
+
+void Inventory::replaceCardsLocked(const std::vector<Card>& newCards) {
+    // Stacks that survive keep their handle; old quantities feed the delta log
+    struct OldStack {
+        int quantity;
+        CardHandle handle;
+    };
+    std::unordered_map<CardId, OldStack> oldStacks;
+    oldStacks.reserve(cards.size());
+    for (size_t i = 0; i < cards.size(); ++i) {
+        oldStacks.emplace(cards[i].getId(), OldStack{cards[i].quantity, handles[i]});
+    }
+
+    cards.clear();
+    index.clear();
+    slotRefs.clear();
+    handles.clear();
+    clearIndicesLocked();
+    cards.reserve(newCards.size());
+    slotRefs.reserve(newCards.size());
+    handles.reserve(newCards.size());
+    index.reserve(newCards.size());
+    for (const auto& card : newCards) {
+        auto old = oldStacks.find(card.getId());
+        addCardLocked(card, old != oldStacks.end() ? old->second.handle : CardHandle{});
+    }
+    bumpVersionLocked();
+
+    // Reordering alone produces no deltas; only quantities that differ are logged
+    for (const auto& card : cards) {
+        auto it = oldStacks.find(card.getId());
+        int oldQuantity = 0;
+        if (it != oldStacks.end()) {
+            oldQuantity = it->second.quantity;
+            oldStacks.erase(it);
         }
+        recordDeltaLocked(card.getId(), oldQuantity, card.quantity);
+    }
+    for (const auto& [id, old] : oldStacks) {
+        releaseHandleLocked(old.handle);
+        recordDeltaLocked(id, old.quantity, 0);
     }
-    cards.push_back(card);
 }
 
-void Inventory::removeCard(const std::string& name, int rarity) {
+bool Inventory::apply(const InventoryBatch& batch) {
+    std::vector<InventoryDelta> applied;
+    return apply(batch, applied);
+}
+
+bool Inventory::apply(const InventoryBatch& batch, std::vector<InventoryDelta>& applied) {
     std::lock_guard<std::mutex> lock(mutex);
-    for (auto it = cards.begin(); it != cards.end(); ++it) {
-        if (it->name == name && it->rarity == rarity) {
-            if (it->quantity > 1) {
-                it->quantity--;
-            } else {
-                cards.erase(it);
+    std::vector<StackChange> changes;
+    if (!resolveBatchLocked(batch, changes)) {
+        return false;
+    }
+
+    // Existing stacks first, so all erasures happen in a single compaction pass
+    bool modified = false;
+    std::vector<bool> erase;
+    for (const auto& change : changes) {
+        auto it = index.find(change.id);
+        if (it == index.end()) {
+            continue;
+        }
+        size_t slot = it->second;
+        adjustTotalsLocked(cards[slot], change.newQuantity - cards[slot].quantity);
+        cards[slot].quantity = change.newQuantity;
+        modified = modified || change.oldQuantity != change.newQuantity;
+        if (change.drained && change.newQuantity <= 0) {
+            erase.resize(cards.size(), false);
+            erase[slot] = true;
+        }
+    }
+    if (!erase.empty()) {
+        eraseSlots(erase);
+    }
+
+    // Then stacks the batch creates, appended in the order they were added
+    for (const auto& change : changes) {
+        if (!change.addedCard || index.count(change.id) ||
+            (change.drained && change.newQuantity <= 0)) {
+            continue;
+        }
+        Card card = *change.addedCard;
+        card.quantity = change.newQuantity;
+        addCardLocked(card);
+        modified = true;
+    }
+
+    if (modified) {
+        bumpVersionLocked();
+        uint64_t appliedVersion = version.load(std::memory_order_relaxed);
+        for (const auto& change : changes) {
+            recordDeltaLocked(change.id, change.oldQuantity, change.newQuantity);
+            if (change.oldQuantity != change.newQuantity) {
+                applied.push_back({change.id, change.oldQuantity, change.newQuantity, appliedVersion});
             }
-            return;
         }
     }
+    return true;
 }
 
-void Inventory::updateCards(const std::vector<Card>& newCards) {
+bool Inventory::canApply(const InventoryBatch& batch) const {
     std::lock_guard<std::mutex> lock(mutex);
-    cards = newCards;
+    std::vector<StackChange> changes;
+    return resolveBatchLocked(batch, changes);
+}
+
+bool Inventory::resolveBatchLocked(const InventoryBatch& batch, std::vector<StackChange>& changes) const {
+    using OpType = InventoryBatch::OpType;
+
+    // Running quantity of every stack touched so far, as an index into changes
+    std::unordered_map<CardId, size_t> touched;
+    auto stackFor = [&](const CardId& id) -> StackChange& {
+        auto result = touched.try_emplace(id, changes.size());
+        if (result.second) {
+            auto slot = index.find(id);
+            int quantity = slot != index.end() ? cards[slot->second].quantity : 0;
+            changes.push_back({id, quantity, quantity, nullptr, false});
+        }
+        return changes[result.first->second];
+    };
+    auto take = [&](const CardId& id, int& remaining) {
+        StackChange& change = stackFor(id);
+        int amount = std::min(remaining, change.newQuantity);
+        if (amount > 0) {
+            change.newQuantity -= amount;
+            change.drained = change.drained || change.newQuantity <= 0;
+            remaining -= amount;
+        }
+    };
+
+    for (const auto& op : batch.ops) {
+        switch (op.type) {
+            case OpType::ADD: {
+                if (op.quantity < 0) {
+                    return false;
+                }
+                StackChange& change = stackFor(op.id);
+                change.newQuantity += op.quantity;
+                if (!change.addedCard && !index.count(op.id)) {
+                    change.addedCard = &batch.addedCards[op.cardIndex];
+                }
+                break;
+            }
+            case OpType::REMOVE: {
+                int remaining = op.quantity;
+                if (remaining < 0 || (remaining > 0 && stackFor(op.id).newQuantity < remaining)) {
+                    return false;
+                }
+                if (remaining > 0) {
+                    take(op.id, remaining);
+                }
+                break;
+            }
+            case OpType::REMOVE_ANY_RARITY: {
+                int remaining = op.quantity;
+                if (remaining < 0) {
+                    return false;
+                }
+                if (remaining == 0) {
+                    break;
+                }
+                if (touched.count(op.id) || index.count(op.id)) {
+                    take(op.id, remaining);
+                }
+                auto stacks = materialStacks.find(op.id.material);
+                if (stacks != materialStacks.end()) {
+                    for (const auto& handle : stacks->second) {
+                        if (remaining <= 0) break;
+                        const CardId id = cards[handleSlots[handle.index].position].getId();
+                        if (id != op.id) take(id, remaining);
+                    }
+                }
+                // Stacks created earlier in this batch come last
+                for (size_t i = 0; i < changes.size() && remaining > 0; ++i) {
+                    if (changes[i].addedCard && changes[i].id.material == op.id.material &&
+                        changes[i].id != op.id) {
+                        take(changes[i].id, remaining);
+                    }
+                }
+                if (remaining > 0) {
+                    return false;
+                }
+                break;
+            }
+        }
+    }
+    return true;
 }
 
 const std::vector<Card>& Inventory::getCards() const {
     return cards;
-}
\ No newline at end of file
+}
+
+bool Inventory::changesSince(uint64_t sinceVersion, std::vector<InventoryDelta>& out) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (sinceVersion < deltaLogStart) {
+        return false;
+    }
+
+    // Versions in the log are non-decreasing, so skip ahead by binary search
+    auto first = std::upper_bound(deltaLog.begin(), deltaLog.end(), sinceVersion,
+        [](uint64_t v, const InventoryDelta& delta) { return v < delta.version; });
+    out.insert(out.end(), first, deltaLog.end());
+    return true;
+}
+
+InventorySnapshot Inventory::snapshot() const {
+    InventorySnapshot current = std::atomic_load(&published);
+    if (current->version == getVersion()) {
+        return current;
+    }
+
+    // Never wait for a writer: if one holds the lock, hand out the last snapshot
+    std::unique_lock<std::mutex> lock(mutex, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        return current;
+    }
+    return publishLocked();
+}
+
+InventorySnapshot Inventory::consistentSnapshot() const {
+    InventorySnapshot current = std::atomic_load(&published);
+    if (current->version == getVersion()) {
+        return current;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    return publishLocked();
+}
+
+InventorySnapshot Inventory::publishLocked() const {
+    InventorySnapshot current = std::atomic_load(&published);
+    uint64_t currentVersion = version.load(std::memory_order_relaxed);
+    if (current->version != currentVersion) {
+        auto state = std::make_shared<InventoryState>();
+        state->version = currentVersion;
+        state->cards = cards;
+        state->handles = handles;
+        state->slots = handleSlots;
+        current = std::move(state);
+        std::atomic_store(&published, current);
+    }
+    return current;
+}
+
+int Inventory::countOf(const CardId& id) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = index.find(id);
+    return it != index.end() ? cards[it->second].quantity : 0;
+}
+
+int Inventory::countOfAnyRarity(MaterialId material) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = materialStacks.find(material);
+    if (it == materialStacks.end()) {
+        return 0;
+    }
+    int total = 0;
+    for (const auto& handle : it->second) {
+        total += cards[handleSlots[handle.index].position].quantity;
+    }
+    return total;
+}
+
+int Inventory::countOfAnyRarity(const std::string& name) const {
+    MaterialId material = MaterialRegistry::instance().find(name);
+    return material != INVALID_MATERIAL_ID ? countOfAnyRarity(material) : 0;
+}
+
+bool Inventory::contains(const CardId& id) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return index.count(id) > 0;
+}
+
+void Inventory::forEachOfType(CardType type, const std::function<void(const Card&)>& fn) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto& handle : typeStacks[static_cast<size_t>(type)]) {
+        fn(cards[handleSlots[handle.index].position]);
+    }
+}
+
+void Inventory::forEachOfMaterial(MaterialId material, const std::function<void(const Card&)>& fn) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = materialStacks.find(material);
+    if (it == materialStacks.end()) {
+        return;
+    }
+    for (const auto& handle : it->second) {
+        fn(cards[handleSlots[handle.index].position]);
+    }
+}
+
+float Inventory::totalWeight() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return static_cast<float>(weightTotal);
+}
+
+const Card* Inventory::findCard(const std::string& name, int rarity) const {
+    MaterialId material = MaterialRegistry::instance().find(name);
+    return material != INVALID_MATERIAL_ID ? findCard(CardId{material, rarity}) : nullptr;
+}
+
+const Card* Inventory::findCard(const CardId& id) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = index.find(id);
+    return it != index.end() ? &cards[it->second] : nullptr;
+}
+
+CardHandle Inventory::handleOf(const CardId& id) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = index.find(id);
+    return it != index.end() ? handles[it->second] : CardHandle{};
+}
+
+bool Inventory::isValid(CardHandle handle) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return handle.index < handleSlots.size() && handleSlots[handle.index].generation == handle.generation;
+}
+
+const Card* Inventory::resolve(CardHandle handle) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (handle.index >= handleSlots.size() || handleSlots[handle.index].generation != handle.generation) {
+        return nullptr;
+    }
+    return &cards[handleSlots[handle.index].position];
+}
+
+size_t Inventory::addCardLocked(const Card& card, CardHandle handle) {
+    auto result = index.try_emplace(card.getId(), cards.size());
+    if (!result.second) {
+        cards[result.first->second].quantity += card.quantity;
+        adjustTotalsLocked(card, card.quantity);
+        return result.first->second;
+    }
+    cards.push_back(card);
+    slotRefs.push_back(&result.first->second);
+    handles.push_back(handle ? handle : acquireHandleLocked());
+    handleSlots[handles.back().index].position = static_cast<uint32_t>(cards.size() - 1);
+    indexStackLocked(cards.size() - 1);
+    return cards.size() - 1;
+}
+
+void Inventory::indexStackLocked(size_t slot) {
+    // Stacks are only ever appended, so the lists stay in inventory order
+    const Card& card = cards[slot];
+    materialStacks[card.materialId].push_back(handles[slot]);
+    typeStacks[static_cast<size_t>(card.type)].push_back(handles[slot]);
+    adjustTotalsLocked(card, card.quantity);
+}
+
+void Inventory::unindexStackLocked(size_t slot) {
+    const Card& card = cards[slot];
+    CardHandle handle = handles[slot];
+    // A handle missing from an index means the index is already out of sync;
+    // leave that list alone rather than erase end()
+    auto stacks = materialStacks.find(card.materialId);
+    if (stacks != materialStacks.end()) {
+        auto& list = stacks->second;
+        auto it = std::find(list.begin(), list.end(), handle);
+        if (it != list.end()) {
+            list.erase(it);
+        }
+        if (list.empty()) {
+            materialStacks.erase(stacks);
+        }
+    }
+    auto& typeList = typeStacks[static_cast<size_t>(card.type)];
+    auto it = std::find(typeList.begin(), typeList.end(), handle);
+    if (it != typeList.end()) {
+        typeList.erase(it);
+    }
+    adjustTotalsLocked(card, -card.quantity);
+}
+
+void Inventory::adjustTotalsLocked(const Card& card, int quantityDelta) {
+    weightTotal += static_cast<double>(quantityDelta) * card.getAttribute(AttributeType::WEIGHT);
+}
+
+void Inventory::clearIndicesLocked() {
+    materialStacks.clear();
+    for (auto& list : typeStacks) {
+        list.clear();
+    }
+    weightTotal = 0.0;
+}
+
+CardHandle Inventory::acquireHandleLocked() {
+    if (!freeHandles.empty()) {
+        uint32_t slot = freeHandles.back();
+        freeHandles.pop_back();
+        return CardHandle{slot, handleSlots[slot].generation};
+    }
+    handleSlots.push_back(CardHandleSlot{});
+    return CardHandle{static_cast<uint32_t>(handleSlots.size() - 1), 0};
+}
+
+void Inventory::releaseHandleLocked(CardHandle handle) {
+    // Outstanding copies of the handle stop resolving; the slot is reused later
+    ++handleSlots[handle.index].generation;
+    freeHandles.push_back(handle.index);
+}
+
+void Inventory::recordDeltaLocked(const CardId& id, int oldQuantity, int newQuantity) {
+    if (oldQuantity == newQuantity) {
+        return;
+    }
+    deltaLog.push_back({id, oldQuantity, newQuantity, version.load(std::memory_order_relaxed)});
+
+    // Trim whole versions so a consumer never sees half of one change set
+    if (deltaLog.size() > MAX_DELTA_LOG) {
+        deltaLogStart = deltaLog.front().version;
+        while (!deltaLog.empty() && deltaLog.front().version == deltaLogStart) {
+            deltaLog.pop_front();
+        }
+    }
+}
+
+void Inventory::eraseSlot(size_t slot) {
+    // Preserve insertion order: shift the tail down and fix up its slots
+    unindexStackLocked(slot);
+    releaseHandleLocked(handles[slot]);
+    cards.erase(cards.begin() + slot);
+    slotRefs.erase(slotRefs.begin() + slot);
+    handles.erase(handles.begin() + slot);
+    for (size_t i = slot; i < slotRefs.size(); ++i) {
+        *slotRefs[i] = i;
+        handleSlots[handles[i].index].position = static_cast<uint32_t>(i);
+    }
+}
+
+void Inventory::eraseSlots(const std::vector<bool>& erase) {
+    size_t write = 0;
+    for (size_t read = 0; read < cards.size(); ++read) {
+        if (read < erase.size() && erase[read]) {
+            index.erase(cards[read].getId());
+            unindexStackLocked(read);
+            releaseHandleLocked(handles[read]);
+            continue;
+        }
+        if (write != read) {
+            cards[write] = std::move(cards[read]);
+            slotRefs[write] = slotRefs[read];
+            handles[write] = handles[read];
+        }
+        *slotRefs[write] = write;
+        handleSlots[handles[write].index].position = static_cast<uint32_t>(write);
+        ++write;
+    }
+    cards.erase(cards.begin() + write, cards.end());
+    slotRefs.erase(slotRefs.begin() + write, slotRefs.end());
+    handles.erase(handles.begin() + write, handles.end());
+}
@@ -0,0 +1,232 @@
+#include "Core/JobSystem.h"
+#include <algorithm>
+#include <exception>
+#include <iostream>
+
+struct Job {
+    std::function<void()> fn;
+    std::atomic<int> pending{1};        // Unfinished dependencies, plus one until submitted
+    std::mutex mutex;
+    std::condition_variable finished;
+    bool done = false;                  // Guarded by mutex
+    std::atomic<bool> doneFlag{false};  // Same, readable without the lock
+    std::vector<std::shared_ptr<Job>> continuations;   // Jobs waiting on this one
+};
+
+namespace {
+// Which pool and worker the current thread belongs to, if any
+thread_local JobSystem* currentSystem = nullptr;
+thread_local size_t currentWorker = 0;
+}
+
+bool JobHandle::isDone() const {
+    return !job || job->doneFlag.load(std::memory_order_acquire);
+}
+
+JobSystem& JobSystem::instance() {
+    // One core is left for the main thread, which also helps in wait()
+    static JobSystem system([]() {
+        unsigned cores = std::thread::hardware_concurrency();
+        return cores > 1 ? cores - 1 : 1u;
+    }());
+    return system;
+}
+
+JobSystem::JobSystem(size_t workerCount) {
+    workerCount = std::max<size_t>(1, workerCount);
+    for (size_t i = 0; i < workerCount; ++i) {
+        workers.push_back(std::make_unique<Worker>());
+    }
+    for (size_t i = 0; i < workerCount; ++i) {
+        workers[i]->thread = std::thread(&JobSystem::workerLoop, this, i);
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping.store(true);
+    }
+    wake.notify_all();
+    for (auto& worker : workers) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+}
+
+JobHandle JobSystem::submit(std::function<void()> fn) {
+    return submit(std::move(fn), {});
+}
+
+JobHandle JobSystem::submit(std::function<void()> fn, const std::vector<JobHandle>& dependencies) {
+    auto job = std::make_shared<Job>();
+    job->fn = std::move(fn);
+    job->pending.store(1 + static_cast<int>(dependencies.size()));
+    for (const auto& dependency : dependencies) {
+        bool registered = false;
+        if (dependency.job) {
+            std::lock_guard<std::mutex> lock(dependency.job->mutex);
+            if (!dependency.job->done) {
+                dependency.job->continuations.push_back(job);
+                registered = true;
+            }
+        }
+        if (!registered) {
+            job->pending.fetch_sub(1);
+        }
+    }
+    if (job->pending.fetch_sub(1) == 1) {
+        enqueue(job);
+    }
+    return JobHandle(job);
+}
+
+void JobSystem::enqueue(std::shared_ptr<Job> job) {
+    // Counted before it becomes visible, so a worker never finds more jobs than counted
+    queued.fetch_add(1);
+    size_t target = currentSystem == this ? currentWorker : nextWorker.fetch_add(1) % workers.size();
+    {
+        std::lock_guard<std::mutex> lock(workers[target]->mutex);
+        workers[target]->jobs.push_back(std::move(job));
+    }
+    {
+        // Pairs with the predicate check in workerLoop, so the wakeup is not lost
+        std::lock_guard<std::mutex> lock(sleepMutex);
+    }
+    wake.notify_one();
+}
+
+std::shared_ptr<Job> JobSystem::take() {
+    std::shared_ptr<Job> job;
+    size_t count = workers.size();
+    size_t start = currentSystem == this ? currentWorker : 0;
+    if (currentSystem == this) {
+        Worker& own = *workers[start];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.jobs.empty()) {
+            job = std::move(own.jobs.back());
+            own.jobs.pop_back();
+        }
+    }
+    for (size_t i = 1; !job && i <= count; ++i) {
+        Worker& victim = *workers[(start + i) % count];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.jobs.empty()) {
+            job = std::move(victim.jobs.front());
+            victim.jobs.pop_front();
+        }
+    }
+    if (job) {
+        queued.fetch_sub(1);
+    }
+    return job;
+}
+
+void JobSystem::execute(const std::shared_ptr<Job>& job) {
+    try {
+        job->fn();
+    } catch (const std::exception& e) {
+        std::cerr << "Job failed: " << e.what() << std::endl;
+    } catch (...) {
+        std::cerr << "Job failed with an unknown exception" << std::endl;
+    }
+    job->fn = nullptr;
+
+    std::vector<std::shared_ptr<Job>> ready;
+    {
+        std::lock_guard<std::mutex> lock(job->mutex);
+        job->done = true;
+        job->doneFlag.store(true, std::memory_order_release);
+        ready.swap(job->continuations);
+    }
+    job->finished.notify_all();
+    for (auto& continuation : ready) {
+        if (continuation->pending.fetch_sub(1) == 1) {
+            enqueue(std::move(continuation));
+        }
+    }
+}
+
+void JobSystem::workerLoop(size_t index) {
+    currentSystem = this;
+    currentWorker = index;
+    for (;;) {
+        if (std::shared_ptr<Job> job = take()) {
+            execute(job);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wake.wait(lock, [this]() { return stopping.load() || queued.load() > 0; });
+        if (stopping.load() && queued.load() <= 0) {
+            break;
+        }
+    }
+}
+
+void JobSystem::wait(const JobHandle& handle) {
+    if (!handle.job) {
+        return;
+    }
+    while (!handle.isDone()) {
+        if (std::shared_ptr<Job> job = take()) {
+            execute(job);
+            continue;
+        }
+        // Nothing to help with: sleep until the job finishes or new work may exist
+        std::unique_lock<std::mutex> lock(handle.job->mutex);
+        handle.job->finished.wait_for(lock, std::chrono::milliseconds(1), [&]() { return handle.job->done; });
+    }
+}
+
+void JobSystem::waitAll(const std::vector<JobHandle>& handles) {
+    for (const auto& handle : handles) {
+        wait(handle);
+    }
+}
+
+bool JobSystem::waitFor(const JobHandle& handle, std::chrono::milliseconds timeout) {
+    if (!handle.job) {
+        return true;
+    }
+    std::unique_lock<std::mutex> lock(handle.job->mutex);
+    return handle.job->finished.wait_for(lock, timeout, [&]() { return handle.job->done; });
+}
+
+void JobSystem::parallelFor(size_t count, size_t batch, const std::function<void(size_t, size_t)>& fn) {
+    batch = std::max<size_t>(1, batch);
+    std::vector<JobHandle> handles;
+    handles.reserve((count + batch - 1) / batch);
+    for (size_t begin = 0; begin < count; begin += batch) {
+        size_t end = std::min(count, begin + batch);
+        handles.push_back(submit([&fn, begin, end]() { fn(begin, end); }));
+    }
+    waitAll(handles);
+}
+
+TaskGraph::Node TaskGraph::add(std::function<void()> fn, const std::vector<Node>& after) {
+    Entry entry;
+    entry.fn = std::move(fn);
+    for (Node node : after) {
+        if (node < nodes.size()) {
+            entry.after.push_back(node);
+        }
+    }
+    nodes.push_back(std::move(entry));
+    return nodes.size() - 1;
+}
+
+void TaskGraph::run(JobSystem& jobs) {
+    handles.clear();
+    handles.reserve(nodes.size());
+    std::vector<JobHandle> dependencies;
+    for (const auto& entry : nodes) {
+        dependencies.clear();
+        for (Node node : entry.after) {
+            dependencies.push_back(handles[node]);
+        }
+        // The graph outlives the run, so jobs can refer to its functions
+        handles.push_back(jobs.submit([&entry]() { entry.fn(); }, dependencies));
+    }
+    jobs.waitAll(handles);
+}
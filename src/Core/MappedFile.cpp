@@ -0,0 +1,144 @@
+#include "Core/MappedFile.h"
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#endif
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+#if defined(_WIN32)
+
+bool MappedFile::open(const std::string& path) {
+    close();
+
+    HANDLE fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                    OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    if (GetFileType(fileHandle) != FILE_TYPE_DISK || !GetFileSizeEx(fileHandle, &fileSize)) {
+        CloseHandle(fileHandle);
+        return false;
+    }
+
+    size_t fileLength = static_cast<size_t>(fileSize.QuadPart);
+    if (fileLength > 0) {
+        // An empty file cannot be mapped, so only non-empty ones get here
+        HANDLE mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        void* view = mappingHandle ? MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0) : nullptr;
+        if (mappingHandle) {
+            CloseHandle(mappingHandle);     // The view keeps the mapping alive
+        }
+        if (!view) {
+            CloseHandle(fileHandle);
+            return false;
+        }
+        bytes = static_cast<const char*>(view);
+        length = fileLength;
+    }
+    CloseHandle(fileHandle);
+    opened = true;
+    return true;
+}
+
+void MappedFile::close() {
+    if (bytes) {
+        UnmapViewOfFile(bytes);
+    }
+    bytes = nullptr;
+    length = 0;
+    opened = false;
+}
+
+#elif defined(__unix__) || defined(__APPLE__)
+
+bool MappedFile::open(const std::string& path) {
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) {
+        ::close(fd);
+        return false;
+    }
+
+    size_t fileLength = static_cast<size_t>(info.st_size);
+    if (fileLength > 0) {
+        void* mapping = mmap(nullptr, fileLength, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED) {
+            ::close(fd);
+            return false;
+        }
+        // Read front to back, so let the kernel read ahead aggressively
+        madvise(mapping, fileLength, MADV_SEQUENTIAL);
+        bytes = static_cast<const char*>(mapping);
+        length = fileLength;
+    }
+    ::close(fd);    // The mapping keeps the file alive
+    opened = true;
+    return true;
+}
+
+void MappedFile::close() {
+    if (bytes) {
+        munmap(const_cast<char*>(bytes), length);
+    }
+    bytes = nullptr;
+    length = 0;
+    opened = false;
+}
+
+#else
+
+// No mapping API: read the whole file into a buffer instead
+bool MappedFile::open(const std::string& path) {
+    close();
+
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) {
+        return false;
+    }
+    std::streamoff fileLength = in.tellg();
+    if (fileLength < 0) {
+        return false;
+    }
+    buffer.resize(static_cast<size_t>(fileLength));
+    in.seekg(0);
+    if (fileLength > 0 && !in.read(buffer.data(), fileLength)) {
+        buffer.clear();
+        return false;
+    }
+    bytes = buffer.empty() ? nullptr : buffer.data();
+    length = buffer.size();
+    opened = true;
+    return true;
+}
+
+void MappedFile::close() {
+    buffer.clear();
+    buffer.shrink_to_fit();
+    bytes = nullptr;
+    length = 0;
+    opened = false;
+}
+
+#endif
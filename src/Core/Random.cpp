@@ -0,0 +1,87 @@
+#include "Core/Random.h"
+#include <random>
+
+namespace {
+
+uint64_t splitmix64(uint64_t& x) {
+    uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+uint64_t rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+// Seed of one stream: the master seed mixed with the stream and worker numbers
+uint64_t deriveSeed(uint64_t master, uint32_t id, uint32_t worker) {
+    uint64_t x = master ^ (static_cast<uint64_t>(id) << 32 | worker);
+    splitmix64(x);
+    return splitmix64(x);
+}
+
+}
+
+void Rng::reseed(uint64_t seed) {
+    // splitmix64 never yields four zero words, the one state xoshiro cannot leave
+    for (auto& word : state) {
+        word = splitmix64(seed);
+    }
+}
+
+bool Rng::setState(const State& newState) {
+    if (newState == State{}) {
+        return false;
+    }
+    state = newState;
+    return true;
+}
+
+Rng::result_type Rng::operator()() {
+    const uint64_t result = rotl(state[1] * 5, 7) * 9;
+    const uint64_t t = state[1] << 17;
+    state[2] ^= state[0];
+    state[3] ^= state[1];
+    state[1] ^= state[2];
+    state[0] ^= state[3];
+    state[2] ^= t;
+    state[3] = rotl(state[3], 45);
+    return result;
+}
+
+float Rng::nextFloat() {
+    // Top 24 bits fill the float mantissa exactly
+    return static_cast<float>((*this)() >> 40) * (1.0f / 16777216.0f);
+}
+
+int Rng::nextInt(int lo, int hi) {
+    // Multiply-shift instead of modulo: no division, and bias is below 2^-32
+    uint64_t range = static_cast<uint64_t>(static_cast<int64_t>(hi) - lo) + 1;
+    uint64_t offset = (((*this)() >> 32) * range) >> 32;
+    return static_cast<int>(lo + static_cast<int64_t>(offset));
+}
+
+RandomService& RandomService::instance() {
+    static RandomService service;
+    return service;
+}
+
+RandomService::RandomService() {
+    std::random_device rd;
+    reseed((static_cast<uint64_t>(rd()) << 32) | rd());
+}
+
+void RandomService::reseed(uint64_t newSeed) {
+    seed.store(newSeed, std::memory_order_release);
+    for (size_t i = 0; i < streams.size(); ++i) {
+        streams[i].reseed(deriveSeed(newSeed, static_cast<uint32_t>(i), 0));
+    }
+    // After the seed, so a worker seeing the new generation sees the new seed
+    generation.fetch_add(1, std::memory_order_release);
+}
+
+Rng RandomService::forThread(RngStream id, uint32_t worker) const {
+    // Worker 0 is the main-thread stream, so workers count from 1
+    return Rng(deriveSeed(getSeed(), static_cast<uint32_t>(id), worker + 1));
+}
@@ -0,0 +1,252 @@
+#include "Core/TimerWheel.h"
+#include <cmath>
+
+TimerWheel::TimerWheel(double tickSeconds) : tickSeconds(tickSeconds > 0.0 ? tickSeconds : 0.01) {
+    heads.fill(NIL);
+    tails.fill(NIL);
+}
+
+TimerWheel::TimerId TimerWheel::schedule(double delaySeconds, std::function<void()> fn, Dispatch dispatch) {
+    return add(delaySeconds, 0.0, std::move(fn), dispatch);
+}
+
+TimerWheel::TimerId TimerWheel::scheduleEvery(double intervalSeconds, std::function<void()> fn, Dispatch dispatch) {
+    return add(intervalSeconds, intervalSeconds, std::move(fn), dispatch);
+}
+
+uint64_t TimerWheel::toTicks(double seconds) const {
+    long long ticks = std::llround(seconds / tickSeconds);
+    return ticks < 1 ? 1 : static_cast<uint64_t>(ticks);
+}
+
+TimerWheel::TimerId TimerWheel::add(double delaySeconds, double intervalSeconds, std::function<void()> fn,
+                                    Dispatch dispatch) {
+    uint32_t index;
+    if (!freeTimers.empty()) {
+        index = freeTimers.back();
+        freeTimers.pop_back();
+    } else {
+        index = static_cast<uint32_t>(timers.size());
+        timers.emplace_back();
+        timers.back().generation = 1;
+    }
+
+    Timer& timer = timers[index];
+    timer.fn = std::move(fn);
+    // Advancing by the delay processes ticks [base, base + ticks), so the
+    // timer expires on the last of them. While firing, the current tick is
+    // already under way and counting starts at the next one.
+    uint64_t base = firing ? tick + 1 : tick;
+    timer.expires = base + toTicks(delaySeconds) - 1;
+    timer.interval = intervalSeconds > 0.0 ? toTicks(intervalSeconds) : 0;
+    timer.dispatch = dispatch;
+    timer.scheduled = true;
+    timer.job = JobHandle();
+    ++active;
+    link(index);
+    return (static_cast<TimerId>(timer.generation) << 32) | index;
+}
+
+TimerWheel::Timer* TimerWheel::find(TimerId id) {
+    uint32_t index = static_cast<uint32_t>(id);
+    uint32_t generation = static_cast<uint32_t>(id >> 32);
+    if (index >= timers.size() || timers[index].generation != generation || !timers[index].scheduled) {
+        return nullptr;
+    }
+    return &timers[index];
+}
+
+const TimerWheel::Timer* TimerWheel::find(TimerId id) const {
+    return const_cast<TimerWheel*>(this)->find(id);
+}
+
+bool TimerWheel::isScheduled(TimerId id) const {
+    return find(id) != nullptr;
+}
+
+JobHandle TimerWheel::cancel(TimerId id) {
+    Timer* timer = find(id);
+    if (!timer) {
+        return JobHandle();
+    }
+    JobHandle job = timer->job;
+    uint32_t index = static_cast<uint32_t>(id);
+    if (timer->slot != NIL) {
+        unlink(index);
+    }
+    release(index);
+    return job;
+}
+
+void TimerWheel::link(uint32_t index) {
+    Timer& timer = timers[index];
+    if (timer.expires < tick) {
+        timer.expires = tick;
+    }
+    uint64_t delta = timer.expires - tick;
+    int level = 0;
+    while (level < LEVELS - 1 && delta >= (uint64_t(1) << (SLOT_BITS * (level + 1)))) {
+        ++level;
+    }
+    if (level == LEVELS - 1) {
+        // Delays past the range of the wheel (2^32 ticks) are shortened to it
+        uint64_t range = (uint64_t(1) << (SLOT_BITS * LEVELS)) - 1;
+        if (delta > range) {
+            timer.expires = tick + range;
+        }
+    }
+    uint32_t slot = static_cast<uint32_t>(level) * SLOTS +
+                    static_cast<uint32_t>((timer.expires >> (SLOT_BITS * level)) & SLOT_MASK);
+
+    timer.slot = slot;
+    timer.next = NIL;
+    timer.prev = tails[slot];
+    if (tails[slot] != NIL) {
+        timers[tails[slot]].next = index;
+    } else {
+        heads[slot] = index;
+    }
+    tails[slot] = index;
+    if (slot < SLOTS) {
+        occupied[slot >> 6] |= uint64_t(1) << (slot & 63);
+    }
+}
+
+void TimerWheel::unlink(uint32_t index) {
+    Timer& timer = timers[index];
+    if (timer.prev != NIL) {
+        timers[timer.prev].next = timer.next;
+    } else {
+        heads[timer.slot] = timer.next;
+    }
+    if (timer.next != NIL) {
+        timers[timer.next].prev = timer.prev;
+    } else {
+        tails[timer.slot] = timer.prev;
+    }
+    if (heads[timer.slot] == NIL && timer.slot < SLOTS) {
+        occupied[timer.slot >> 6] &= ~(uint64_t(1) << (timer.slot & 63));
+    }
+    timer.prev = timer.next = timer.slot = NIL;
+}
+
+void TimerWheel::release(uint32_t index) {
+    Timer& timer = timers[index];
+    timer.fn = nullptr;
+    timer.job = JobHandle();
+    timer.scheduled = false;
+    ++timer.generation;
+    freeTimers.push_back(index);
+    --active;
+}
+
+uint32_t TimerWheel::cascade(int level) {
+    uint32_t index = static_cast<uint32_t>((tick >> (SLOT_BITS * level)) & SLOT_MASK);
+    uint32_t slot = static_cast<uint32_t>(level) * SLOTS + index;
+    while (heads[slot] != NIL) {
+        uint32_t timer = heads[slot];
+        unlink(timer);
+        link(timer);
+    }
+    return index;
+}
+
+void TimerWheel::advance(double deltaSeconds) {
+    if (paused || deltaSeconds <= 0.0) {
+        return;
+    }
+    carry += deltaSeconds / tickSeconds;
+    double whole = std::floor(carry);
+    carry -= whole;
+    uint64_t steps = static_cast<uint64_t>(whole);
+    while (steps > 0) {
+        if (active == 0) {
+            // Nothing to fire: jump straight to the end
+            tick += steps;
+            break;
+        }
+        uint64_t idle = idleTicks();
+        if (idle > 0) {
+            uint64_t skip = idle < steps ? idle : steps;
+            tick += skip;
+            steps -= skip;
+            continue;
+        }
+        processTick();
+        --steps;
+    }
+}
+
+uint64_t TimerWheel::idleTicks() const {
+    // A wrap must be processed, since it cascades the levels above
+    uint32_t index = static_cast<uint32_t>(tick & SLOT_MASK);
+    if (index == 0) {
+        return 0;
+    }
+    // Fine slots from index on hold exactly the timers due before the wrap
+    for (uint32_t word = index >> 6; word < SLOTS / 64; ++word) {
+        uint64_t bits = occupied[word];
+        if (word == index >> 6) {
+            bits &= ~uint64_t(0) << (index & 63);
+        }
+        if (bits) {
+            uint32_t bit = 0;
+            while (!(bits & 1)) {
+                bits >>= 1;
+                ++bit;
+            }
+            return (word << 6) + bit - index;
+        }
+    }
+    return SLOTS - index;
+}
+
+void TimerWheel::processTick() {
+    // When a level wraps, the next slot of the level above moves down
+    if ((tick & SLOT_MASK) == 0) {
+        for (int level = 1; level < LEVELS && cascade(level) == 0; ++level) {
+        }
+    }
+
+    uint32_t slot = static_cast<uint32_t>(tick & SLOT_MASK);
+    firing = true;
+    while (heads[slot] != NIL) {
+        uint32_t index = heads[slot];
+        unlink(index);
+        fire(index);
+    }
+    firing = false;
+    ++tick;
+}
+
+void TimerWheel::fire(uint32_t index) {
+    uint32_t generation = timers[index].generation;
+    bool recurring = timers[index].interval > 0;
+
+    if (timers[index].dispatch == Dispatch::Job) {
+        Timer& timer = timers[index];
+        if (timer.job.isDone()) {
+            timer.job = recurring ? JobSystem::instance().submit(timer.fn)
+                                  : JobSystem::instance().submit(std::move(timer.fn));
+        }
+    } else {
+        // Moved out, so the callback may add timers (and move the vector)
+        std::function<void()> fn = std::move(timers[index].fn);
+        fn();
+        if (timers[index].generation == generation && recurring) {
+            timers[index].fn = std::move(fn);
+        }
+    }
+
+    // The callback may have cancelled this timer, and its slot may be reused
+    Timer& timer = timers[index];
+    if (timer.generation != generation) {
+        return;
+    }
+    if (recurring) {
+        timer.expires += timer.interval;
+        link(index);
+    } else {
+        release(index);
+    }
+}
@@ -23,23 +23,28 @@ View::View(SDLManager& sdl)
     initializeUIAreas();
 }
 
-void View::render(const Inventory& inventory, const Card* selectedCard, int mouseX, int mouseY, 
+void View::render(const Inventory& inventory, CardHandle selectedCard, int mouseX, int mouseY, 
                   bool showCraftingPanel, const CraftingSystem& craftingSystem,
                   int inventoryScrollOffset, int craftingScrollOffset) {
     // Delegate to extended render method without dragging
     render(inventory, selectedCard, mouseX, mouseY, showCraftingPanel, craftingSystem,
-           inventoryScrollOffset, craftingScrollOffset, false, nullptr);
+           inventoryScrollOffset, craftingScrollOffset, false, CardHandle{});
 }
 
-void View::render(const Inventory& inventory, const Card* selectedCard, int mouseX, int mouseY, 
+void View::render(const Inventory& inventory, CardHandle selectedCard, int mouseX, int mouseY, 
                   bool showCraftingPanel, const CraftingSystem& craftingSystem,
                   int inventoryScrollOffset, int craftingScrollOffset,
-                  bool isDragging, const Card* draggedCard) {
+                  bool isDragging, CardHandle draggedCard) {
+    
+    // Handles resolve in O(1); stale ones (stack removed) resolve to nullptr
+    InventorySnapshot snapshot = inventory.snapshot();
+    const Card* selected = snapshot->resolve(selectedCard);
+    const Card* dragged = snapshot->resolve(draggedCard);
     
     renderBackground();
     
     // Render base building area (right half of screen)
-    renderBaseArea(mouseX, mouseY, isDragging, draggedCard);
+    renderBaseArea(mouseX, mouseY, isDragging, dragged);
     
     // Render inventory area background
     renderInventoryBackground();
@@ -54,26 +59,14 @@ void View::render(const Inventory& inventory, const Card* selectedCard, int mous
     // Render inventory (virtualized rendering happens inside the container)
     inventoryContainer_->render();
     
-    // Helper function to check if card pointer is still valid in current inventory
-    auto isCardValid = [&inventory](const Card* card) -> bool {
-        if (!card) return false;
-        const auto& cards = inventory.getCards();
-        for (const auto& invCard : cards) {
-            if (&invCard == card) {
-                return true;
-            }
-        }
-        return false;
-    };
-    
-    // Render dragged card if any (check validity first)
-    if (isDragging && draggedCard && isCardValid(draggedCard)) {
+    // Render dragged card if any
+    if (isDragging && dragged) {
         // Create temporary UICard for drag rendering
-        auto dragCard = std::make_unique<UICard>(*draggedCard, mouseX, mouseY, sdlManager_);
+        auto dragCard = std::make_unique<UICard>(*dragged, mouseX, mouseY, sdlManager_);
         dragCard->renderDragging(mouseX, mouseY);
-    } else if (selectedCard && isCardValid(selectedCard)) {
+    } else if (selected) {
         // Render selected card highlight if not dragging
-        auto dragCard = std::make_unique<UICard>(*selectedCard, mouseX, mouseY, sdlManager_);
+        auto dragCard = std::make_unique<UICard>(*selected, mouseX, mouseY, sdlManager_);
         dragCard->renderDragging(mouseX, mouseY);
     }
     
@@ -108,6 +101,10 @@ const Card* View::getHoveredCard(const Inventory& inventory, int mouseX, int mou
     return inventoryContainer_->getCardAtPosition(mouseX, mouseY, scrollOffset);
 }
 
+CardHandle View::getHoveredCardHandle(int mouseX, int mouseY, int scrollOffset) const {
+    return inventoryContainer_->getHandleAtPosition(mouseX, mouseY, scrollOffset);
+}
+
 bool View::isPointInUIArea(int x, int y, const std::string& areaName) const {
     auto it = uiAreas_.find(areaName);
     if (it != uiAreas_.end()) {
@@ -237,7 +234,7 @@ void View::renderHints() {
     textRenderer.renderTextAt(Constants::HINT_EXIT, hintX, hintY + 3 * Constants::HINT_LINE_SPACING, Constants::TEXT_COLOR);
 }
 
-void View::updateTooltip(const Inventory& inventory, const Card* selectedCard, 
+void View::updateTooltip(const Inventory& inventory, CardHandle selectedCard, 
                          bool showCraftingPanel, int mouseX, int mouseY, int scrollOffset) {
     // Show tooltip only when not dragging and crafting panel is not shown
     if (!selectedCard && !showCraftingPanel) {
@@ -293,7 +290,7 @@ void View::renderScrollIndicators(const Inventory& inventory, int inventoryScrol
     // The detailed scroll bar rendering can be added later if needed
     
     // Check if inventory needs scrolling
-    int totalCards = inventory.getCards().size();
+    int totalCards = inventory.snapshot()->cards.size();
     if (totalCards > 10) { // If more than 10 cards, show scroll hint
         // Simple scroll indicator - can be enhanced later
         SDL_SetRenderDrawColor(sdlManager_.getRenderer(), 100, 100, 100, 100);
@@ -302,7 +299,7 @@ void View::renderScrollIndicators(const Inventory& inventory, int inventoryScrol
     }
 }
 
-void View::setCardSelection(const Card* selectedCard) {
+void View::setCardSelection(CardHandle selectedCard) {
     // Delegate to inventory container
     if (inventoryContainer_) {
         inventoryContainer_->setSelectedCard(selectedCard);
@@ -1,8 +1,8 @@
 #include "Interface/GameInputHandler.h"
 #include "Constants.h"
 #include "Core/BaseManager.h"
+#include "Core/Random.h"
 #include <iostream>
-#include <random>
 #include <thread>
 #include <chrono>
 #include <cstdlib>
@@ -11,11 +11,11 @@ GameInputHandler::GameInputHandler(IGameView& view,
                                   Inventory& inventory, 
                                   CraftingSystem& craftingSystem,
                                   std::shared_ptr<BaseBuildingController> baseBuildingController)
-    : view_(view), inventory_(inventory), craftingSystem_(craftingSystem),
+    : view_(view), inventory_(inventory), craftingSystem_(craftingSystem), planner_(craftingSystem),
       baseBuildingController_(baseBuildingController),
-      running_(true), selectedCard_(nullptr), previousSelectedCard_(nullptr), showCraftingPanel_(false),
+      running_(true), showCraftingPanel_(false),
       mouseX_(0), mouseY_(0), inventoryScrollOffset_(0), craftingScrollOffset_(0),
-      isDragging_(false), draggedCard_(nullptr), dragStartX_(0), dragStartY_(0) {
+      isDragging_(false), dragStartX_(0), dragStartY_(0) {
 }
 
 void GameInputHandler::handleMouseDown(int x, int y) {
@@ -60,18 +60,20 @@ void GameInputHandler::handleMouseDown(int x, int y) {
     
     // Card selection logic (only when crafting panel is not shown)
     if (!showCraftingPanel_) {
-        const Card* hoveredCard = view_.getHoveredCard(inventory_, x, y, inventoryScrollOffset_);
-        if (hoveredCard) {
+        CardHandle hoveredCard = view_.getHoveredCardHandle(x, y, inventoryScrollOffset_);
+        InventorySnapshot snapshot = inventory_.snapshot();
+        const Card* card = snapshot->resolve(hoveredCard);
+        if (card) {
             bool isSameCard = (selectedCard_ == hoveredCard);
-            selectedCard_ = isSameCard ? nullptr : const_cast<Card*>(hoveredCard);
-            std::cout << "Card " << (isSameCard ? "deselected: " : "selected: ") << hoveredCard->name << std::endl;
+            selectedCard_ = isSameCard ? CardHandle{} : hoveredCard;
+            std::cout << "Card " << (isSameCard ? "deselected: " : "selected: ") << card->name << std::endl;
 
             handleCardClick(selectedCard_);
             updateUICardSelection();
             
             // Start potential drag if card is selected and buildable
             if (selectedCard_ && baseBuildingController_) {
-                if (BuildingConversion::isCardBuildable(selectedCard_->name)) {
+                if (BuildingConversion::isCardBuildable(card->materialId)) {
                     // Store drag start position but don't start dragging yet
                     dragStartX_ = x;
                     dragStartY_ = y;
@@ -80,7 +82,7 @@ void GameInputHandler::handleMouseDown(int x, int y) {
             
         } else if (selectedCard_) {
             std::cout << "Card deselected (empty area clicked)" << std::endl;
-            selectedCard_ = nullptr;
+            selectedCard_ = CardHandle{};
             updateUICardSelection();
         }
     }
@@ -110,7 +112,7 @@ void GameInputHandler::handleMouseMotion(int x, int y) {
     
     // Check if we should start dragging
     if (!isDragging_ && selectedCard_ && baseBuildingController_) {
-        if (BuildingConversion::isCardBuildable(selectedCard_->name) && shouldStartDrag(x, y)) {
+        if (shouldStartDrag(x, y) && isSelectedCardBuildable()) {
             startDrag(selectedCard_, dragStartX_, dragStartY_);
         }
     }
@@ -210,7 +212,7 @@ void GameInputHandler::handleButtonClick(const std::string& buttonName) {
     }
 }
 
-void GameInputHandler::handleCardClick(const Card* card) {
+void GameInputHandler::handleCardClick(CardHandle card) {
     // Card selection is handled in handleMouseDown
     // This method can be extended for card-specific actions
     // Use selectedCard_ for consistency instead of parameter
@@ -218,7 +220,7 @@ void GameInputHandler::handleCardClick(const Card* card) {
         view_.setCardSelection(selectedCard_);
     } else {
         // Handle deselection case
-        view_.setCardSelection(nullptr);
+        view_.setCardSelection(CardHandle{});
     }
     
     // Update tracking for future reference
@@ -231,46 +233,60 @@ void GameInputHandler::handleRecipeClick(int recipeIndex) {
     if (recipeIndex >= 0 && recipeIndex < static_cast<int>(allRecipes.size())) {
         const Recipe& selectedRecipe = allRecipes[recipeIndex];
         
+        // Shift+click queues a batch; materials for all of it are reserved at once
+        if ((SDL_GetModState() & KMOD_SHIFT) && queueCraftCallback_) {
+            if (!queueCraftCallback_(selectedRecipe.id, Constants::CRAFT_BATCH_SIZE)) {
+                std::cout << "Cannot queue " << Constants::CRAFT_BATCH_SIZE << " x " << selectedRecipe.name
+                         << " - insufficient materials or recipe not unlocked" << std::endl;
+            }
+            return;
+        }
+        
         if (craftingSystem_.canCraft(selectedRecipe, inventory_)) {
             craftRecipe(recipeIndex);
         } else {
             std::cout << "Cannot craft " << selectedRecipe.name 
                      << " - insufficient materials or recipe not unlocked" << std::endl;
+            printCraftingPlan(selectedRecipe);
         }
     }
 }
 
+void GameInputHandler::printCraftingPlan(const Recipe& recipe) {
+    if (!recipe.isUnlocked) {
+        return;
+    }
+    const CraftingPlan& plan = planner_.plan(recipe.id, 1, inventory_);
+    if (plan.feasible) {
+        std::cout << "Plan:";
+        for (const auto& step : plan.steps) {
+            const Recipe* stepRecipe = craftingSystem_.getRecipe(step.recipeId);
+            std::cout << " " << step.crafts << " x " << (stepRecipe ? stepRecipe->name : step.recipeId) << ";";
+        }
+        std::cout << std::endl;
+    } else {
+        std::cout << "Still missing:";
+        for (const auto& missing : plan.missing) {
+            std::cout << " " << missing.second << " x " << MaterialRegistry::instance().getName(missing.first) << ";";
+        }
+        std::cout << std::endl;
+    }
+}
+
 void GameInputHandler::addRandomCard() {
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> rarityDist(Constants::RARITY_MIN, Constants::RARITY_MAX);
-    inventory_.addCard(Constants::RandomCardGenerator::generateRandomCardByRarity(rarityDist(gen)));
+    Rng& rng = RandomService::instance().stream(RngStream::Cards);
+    int rarity = rng.nextInt(Constants::RARITY_MIN, Constants::RARITY_MAX);
+    inventory_.addCard(Constants::RandomCardGenerator::generateRandomCardByRarity(rarity, rng));
 }
 
 void GameInputHandler::removeFirstCard() {
-    auto& cards = inventory_.getCards();
+    InventorySnapshot snapshot = inventory_.snapshot();
+    const auto& cards = snapshot->cards;
     if (!cards.empty()) {
-        const Card& cardToRemove = cards[0];
-
-        if (cardToRemove.quantity == 1) {
-            // Check if the card being removed is currently selected
-            if (selectedCard_ && selectedCard_->compare(cardToRemove)) {
-                selectedCard_ = nullptr;  // Clear selection
-            }
-            
-            // Check if the card being removed is currently being dragged
-            if (draggedCard_ && draggedCard_->compare(cardToRemove)) {
-                draggedCard_ = nullptr;
-                isDragging_ = false;  // Stop dragging
-            }
-            
-            // Check if the card being removed is the previously selected card
-            if (previousSelectedCard_ && previousSelectedCard_ == &cardToRemove) {
-                previousSelectedCard_ = nullptr;
-            }
-        }
-
-        inventory_.removeCard(cardToRemove.name, cardToRemove.rarity);
+        inventory_.removeCard(cards[0].getId());
+        
+        // Drop selection or drag state if that removed the last unit
+        validateCardHandles();
     }
 }
 
@@ -323,7 +339,8 @@ void GameInputHandler::handleScrollWheel(int x, int y, int deltaY) {
         inventoryScrollOffset_ -= deltaY * INVENTORY_SCROLL_SPEED;
         
         // Calculate maximum scroll offset based on card count and spacing within inventory bounds
-        auto& cards = inventory_.getCards();
+        InventorySnapshot snapshot = inventory_.snapshot();
+        const auto& cards = snapshot->cards;
         // Calculate visible cards based on inventory area height instead of window height
         int inventoryHeight = Constants::INVENTORY_AREA_HEIGHT;
         int cardSpacing = Constants::CARD_SPACING;
@@ -374,15 +391,17 @@ void GameInputHandler::requestClearFocus() {
 }
 
 // Drag and drop implementation
-void GameInputHandler::startDrag(Card* card, int startX, int startY) {
-    if (!card || !baseBuildingController_) return;
+void GameInputHandler::startDrag(CardHandle card, int startX, int startY) {
+    InventorySnapshot snapshot = inventory_.snapshot();
+    const Card* draggedCard = snapshot->resolve(card);
+    if (!draggedCard || !baseBuildingController_) return;
     
     isDragging_ = true;
     draggedCard_ = card;
     dragStartX_ = startX;
     dragStartY_ = startY;
     
-    std::cout << "Started dragging card: " << card->name << " from (" << startX << ", " << startY << ")" << std::endl;
+    std::cout << "Started dragging card: " << draggedCard->name << " from (" << startX << ", " << startY << ")" << std::endl;
 }
 
 void GameInputHandler::updateDrag(int currentX, int currentY) {
@@ -397,21 +416,24 @@ void GameInputHandler::updateDrag(int currentX, int currentY) {
 }
 
 void GameInputHandler::endDrag(int endX, int endY) {
-    if (!isDragging_ || !draggedCard_ || !baseBuildingController_) {
+    // The snapshot keeps the dragged card alive even if the organizer replaces the inventory
+    InventorySnapshot snapshot = inventory_.snapshot();
+    const Card* draggedCard = snapshot->resolve(draggedCard_);
+    if (!isDragging_ || !draggedCard || !baseBuildingController_) {
         isDragging_ = false;
-        draggedCard_ = nullptr;
+        draggedCard_ = CardHandle{};
         return;
     }
     
     std::cout << "Ending drag at (" << endX << ", " << endY << ")" << std::endl;
     
     // Try to place building if dropped in base area
-    bool placementSuccess = baseBuildingController_->handleCardDrop(draggedCard_, endX, endY);
+    bool placementSuccess = baseBuildingController_->handleCardDrop(draggedCard, endX, endY);
     
     if (placementSuccess) {
         std::cout << "Successfully placed building from dragged card!" << std::endl;
         // Clear selection after successful placement
-        selectedCard_ = nullptr;
+        selectedCard_ = CardHandle{};
         updateUICardSelection();
     } else {
         std::cout << "Failed to place building: " << baseBuildingController_->getErrorMessage(baseBuildingController_->getLastError()) << std::endl;
@@ -419,7 +441,7 @@ void GameInputHandler::endDrag(int endX, int endY) {
     
     // Reset drag state
     isDragging_ = false;
-    draggedCard_ = nullptr;
+    draggedCard_ = CardHandle{};
 }
 
 bool GameInputHandler::shouldStartDrag(int currentX, int currentY) const {
@@ -432,32 +454,26 @@ bool GameInputHandler::shouldStartDrag(int currentX, int currentY) const {
     return distance >= (DRAG_THRESHOLD * DRAG_THRESHOLD);
 }
 
-void GameInputHandler::validateCardPointers() {
-    // Helper function to check if a card pointer is valid
-    auto isCardValid = [this](const Card* card) -> bool {
-        if (!card) return false;
-        const auto& cards = inventory_.getCards();
-        for (const auto& invCard : cards) {
-            if (&invCard == card) {
-                return true;
-            }
-        }
-        return false;
-    };
-    
-    // Clear selectedCard_ if it's no longer valid
-    if (selectedCard_ && !isCardValid(selectedCard_)) {
-        selectedCard_ = nullptr;
+bool GameInputHandler::isSelectedCardBuildable() const {
+    InventorySnapshot snapshot = inventory_.snapshot();
+    const Card* card = snapshot->resolve(selectedCard_);
+    return card && BuildingConversion::isCardBuildable(card->materialId);
+}
+
+void GameInputHandler::validateCardHandles() {
+    // Clear selectedCard_ if its stack is gone
+    if (selectedCard_ && !inventory_.isValid(selectedCard_)) {
+        selectedCard_ = CardHandle{};
     }
     
-    // Clear previousSelectedCard_ if it's no longer valid
-    if (previousSelectedCard_ && !isCardValid(previousSelectedCard_)) {
-        previousSelectedCard_ = nullptr;
+    // Clear previousSelectedCard_ if its stack is gone
+    if (previousSelectedCard_ && !inventory_.isValid(previousSelectedCard_)) {
+        previousSelectedCard_ = CardHandle{};
     }
     
-    // Clear draggedCard_ and stop dragging if it's no longer valid
-    if (draggedCard_ && !isCardValid(draggedCard_)) {
-        draggedCard_ = nullptr;
+    // Clear draggedCard_ and stop dragging if its stack is gone
+    if (draggedCard_ && !inventory_.isValid(draggedCard_)) {
+        draggedCard_ = CardHandle{};
         isDragging_ = false;
     }
 }
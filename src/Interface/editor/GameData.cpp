@@ -41,10 +41,9 @@ MaterialTemplate MaterialTemplate::fromCard(const Card& card) {
 }
 
 // EventCondition implementation
-bool EventCondition::evaluate() const {
-    // Placeholder implementation - would need game state access
-    // This should be connected to the actual game state
-    return false;
+bool EventCondition::evaluate(const EventState& state, Rng& rng) const {
+    // Bulk checks should go through GameDataManager::getCompiledEvents()
+    return CompiledEvents::evaluate(*this, state, rng);
 }
 
 // EventEffect implementation
@@ -54,17 +53,17 @@ void EventEffect::execute() const {
 }
 
 // EventTemplate implementation
-bool EventTemplate::canTrigger() const {
+bool EventTemplate::canTrigger(const EventState& state, Rng& rng) const {
     for (const auto& condition : conditions) {
-        if (!condition.evaluate()) {
+        if (!condition.evaluate(state, rng)) {
             return false;
         }
     }
     return true;
 }
 
-void EventTemplate::trigger() const {
-    if (!canTrigger()) return;
+void EventTemplate::trigger(const EventState& state, Rng& rng) const {
+    if (!canTrigger(state, rng)) return;
     
     for (const auto& effect : effects) {
         effect.execute();
@@ -209,9 +208,19 @@ EventTemplate* GameDataManager::getEvent(const std::string& id) {
     auto it = std::find_if(events_.begin(), events_.end(),
         [&id](const EventTemplate& e) { return e.id == id; });
     
+    // The caller may edit through the pointer
+    eventsDirty_ = true;
     return (it != events_.end()) ? &(*it) : nullptr;
 }
 
+const CompiledEvents& GameDataManager::getCompiledEvents() const {
+    if (eventsDirty_) {
+        compiledEvents_.compile(events_);
+        eventsDirty_ = false;
+    }
+    return compiledEvents_;
+}
+
 GameDataManager::ValidationResult GameDataManager::validateData() const {
     ValidationResult result;
     result.isValid = true;
@@ -320,6 +329,23 @@ bool GameDataManager::saveToFile(const std::string& filename) const {
             eventJson["description"] = event.description;
             eventJson["is_repeatable"] = event.isRepeatable;
             eventJson["priority"] = event.priority;
+            eventJson["conditions"] = json::array();
+            for (const auto& condition : event.conditions) {
+                json conditionJson;
+                conditionJson["type"] = static_cast<int>(condition.type);
+                conditionJson["target"] = condition.target;
+                conditionJson["value"] = condition.value;
+                conditionJson["operator"] = condition.operator_;
+                eventJson["conditions"].push_back(conditionJson);
+            }
+            eventJson["effects"] = json::array();
+            for (const auto& effect : event.effects) {
+                json effectJson;
+                effectJson["type"] = static_cast<int>(effect.type);
+                effectJson["target"] = effect.target;
+                effectJson["value"] = effect.value;
+                eventJson["effects"].push_back(effectJson);
+            }
             j["events"].push_back(eventJson);
         }
         
@@ -408,8 +434,29 @@ bool GameDataManager::loadFromFile(const std::string& filename) {
                 event.isRepeatable = eventJson.value("is_repeatable", false);
                 event.priority = eventJson.value("priority", 0);
                 
+                if (eventJson.contains("conditions")) {
+                    for (const auto& conditionJson : eventJson["conditions"]) {
+                        EventCondition condition;
+                        condition.type = static_cast<ConditionType>(conditionJson["type"].get<int>());
+                        condition.target = conditionJson.value("target", "");
+                        condition.value = conditionJson.value("value", 0.0f);
+                        condition.operator_ = conditionJson.value("operator", "");
+                        event.conditions.push_back(condition);
+                    }
+                }
+                if (eventJson.contains("effects")) {
+                    for (const auto& effectJson : eventJson["effects"]) {
+                        EventEffect effect;
+                        effect.type = static_cast<EffectType>(effectJson["type"].get<int>());
+                        effect.target = effectJson.value("target", "");
+                        effect.value = effectJson.value("value", 0.0f);
+                        event.effects.push_back(effect);
+                    }
+                }
+                
                 events_.push_back(event);
             }
+            eventsDirty_ = true;
         }
         
         std::cout << "Game data loaded from " << filename << std::endl;
@@ -460,6 +507,9 @@ bool GameDataManager::redo() {
 }
 
 void GameDataManager::notifyChange(const std::string& type, const std::string& id) {
+    if (type == "event") {
+        eventsDirty_ = true;
+    }
     if (changeCallback_) {
         changeCallback_(type, id);
     }
@@ -477,6 +527,7 @@ void GameDataManager::restoreState(const DataState& state) {
     materials_ = state.materials;
     recipes_ = state.recipes;
     events_ = state.events;
+    eventsDirty_ = true;
 }
 
 void GameDataManager::initializeDefaults() {
@@ -499,7 +550,8 @@ void GameDataManager::syncFromGame() {
     // Sync materials from current inventory
     materials_.clear();
     const auto& inventory = gameInstance_->getInventory();
-    auto inventoryCards = inventory.getCards();
+    InventorySnapshot snapshot = inventory.snapshot();
+    const auto& inventoryCards = snapshot->cards;
     
     // Create materials from inventory cards
     std::set<std::string> addedMaterials;
@@ -540,7 +592,7 @@ GameDataManager::GameState GameDataManager::getCurrentGameState() const {
     
     // Get inventory cards
     const auto& inventory = gameInstance_->getInventory();
-    state.inventoryCards = inventory.getCards();
+    state.inventoryCards = inventory.snapshot()->cards;
     
     // Get available recipes
     const auto& craftingSystem = gameInstance_->getCraftingSystem();
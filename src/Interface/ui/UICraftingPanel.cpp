@@ -1,5 +1,6 @@
 #include "Interface/ui/UICraftingPanel.h"
 #include "Systems/SDLManager.h"
+#include <limits>
 
 // UIRecipeItem implementation
 UIRecipeItem::UIRecipeItem(const Recipe& recipe, int x, int y, SDLManager& sdlManager, 
@@ -8,6 +9,7 @@ UIRecipeItem::UIRecipeItem(const Recipe& recipe, int x, int y, SDLManager& sdlMa
                       Constants::RECIPE_ITEM_HEIGHT - Constants::RECIPE_ITEM_VERTICAL_SPACING, sdlManager),
       recipe_(recipe),
       canCraft_(false),
+      maxCrafts_(0),
       onRecipeClick_(onRecipeClick) {
     setScrollable(true); // Enable scrolling for UIContainer compatibility
     createRecipeContent();
@@ -29,7 +31,13 @@ void UIRecipeItem::render() {
         textColor = Constants::BORDER_COLOR;
         renderText("??? (Locked)", Constants::CRAFT_PANEL_MARGIN, 5, textColor);
     } else {
-        renderText(recipe_.name, Constants::CRAFT_PANEL_MARGIN, 5, textColor);
+        std::string nameText = recipe_.name;
+        if (canCraft_ && maxCrafts_ < std::numeric_limits<int>::max()) {
+            nameText += " (x" + std::to_string(maxCrafts_) + ")";
+        } else if (!canCraft_ && !bottleneck_.empty()) {
+            nameText += " (short on " + bottleneck_ + ")";
+        }
+        renderText(nameText, Constants::CRAFT_PANEL_MARGIN, 5, textColor);
         
         // Success rate
         std::string successText = "Success Rate: " + std::to_string(static_cast<int>(recipe_.successRate * 100)) + "%";
@@ -45,9 +53,11 @@ void UIRecipeItem::render() {
     }
 }
 
-void UIRecipeItem::update(const Recipe& recipe, bool canCraft) {
+void UIRecipeItem::update(const Recipe& recipe, bool canCraft, int maxCrafts, const std::string& bottleneck) {
     recipe_ = recipe;
     canCraft_ = canCraft;
+    maxCrafts_ = maxCrafts;
+    bottleneck_ = bottleneck;
     updateLayout();  // Update layout when recipe changes
 }
 
@@ -138,43 +148,40 @@ void UICraftingPanel::update(const CraftingSystem& craftingSystem, const Invento
     }
     
     scrollOffset_ = scrollOffset;
-    auto allRecipes = craftingSystem.getAllRecipes();
+    const auto& allRecipes = craftingSystem.getAllRecipes();
     
     // Create recipe items if needed
+    bool fullRefresh = !evaluated_;
     if (recipeItems_.size() != allRecipes.size()) {
         createRecipeItems(allRecipes);
+        fullRefresh = true;
     }
     
-    // Update recipe items with current status
+    // Craftability is read from the crafting system's cache, which only
+    // re-evaluates recipes touched by inventory changes. Items are rebuilt
+    // only when what they show has changed.
     for (size_t i = 0; i < recipeItems_.size() && i < allRecipes.size(); ++i) {
         const Recipe& recipe = allRecipes[i];
-        bool canCraft = false;
-        
-        if (recipe.isUnlocked) {
-            canCraft = true;
-            for (const auto& ingredient : recipe.ingredients) {
-                const Card& requiredCard = ingredient.first;
-                int requiredQuantity = ingredient.second;
-                
-                bool hasEnough = false;
-                for (const auto& card : inventory.getCards()) {
-                    if (card.name == requiredCard.name && 
-                        card.rarity == requiredCard.rarity &&
-                        card.quantity >= requiredQuantity) {
-                        hasEnough = true;
-                        break;
-                    }
-                }
-                
-                if (!hasEnough) {
-                    canCraft = false;
-                    break;
-                }
-            }
+        int maxCrafts = craftingSystem.getMaxCraftCount(i, inventory);
+        MaterialId bottleneck = craftingSystem.getBottleneckMaterial(i, inventory);
+        bool dirty = fullRefresh ||
+                     recipe.isUnlocked != recipeUnlocked_[i] ||
+                     maxCrafts != recipeMaxCrafts_[i] ||
+                     bottleneck != recipeBottlenecks_[i] ||
+                     recipe.id != recipeItems_[i]->getRecipeId();
+        if (!dirty) {
+            continue;
         }
         
-        recipeItems_[i]->update(recipe, canCraft);
+        recipeUnlocked_[i] = recipe.isUnlocked;
+        recipeMaxCrafts_[i] = maxCrafts;
+        recipeBottlenecks_[i] = bottleneck;
+        std::string bottleneckName = bottleneck != INVALID_MATERIAL_ID
+            ? MaterialRegistry::instance().getName(bottleneck) : "";
+        recipeItems_[i]->update(recipe, craftingSystem.isCraftable(i, inventory), maxCrafts, bottleneckName);
     }
+    
+    evaluated_ = true;
 }
 
 void UICraftingPanel::handleClick(int mouseX, int mouseY) {
@@ -198,6 +205,9 @@ void UICraftingPanel::hide() {
 
 void UICraftingPanel::createRecipeItems(const std::vector<Recipe>& recipes) {
     recipeItems_.clear();
+    recipeUnlocked_.assign(recipes.size(), false);
+    recipeMaxCrafts_.assign(recipes.size(), 0);
+    recipeBottlenecks_.assign(recipes.size(), INVALID_MATERIAL_ID);
     
     int startY = Constants::CRAFT_PANEL_Y + Constants::CRAFT_PANEL_RECIPES_START_Y;
     
@@ -9,30 +9,16 @@ UIInventoryContainer::UIInventoryContainer(int x, int y, int width, int height,
     setScrollable(true); // Enable scrolling for UIContainer compatibility
     // Pre-allocate some cards in the pool to avoid frequent allocations
     cardPool_.reserve(20);  // Reasonable default for most inventories
+    poolHandles_.reserve(20);
 }
 
 void UIInventoryContainer::updateInventory(const Inventory& inventory) {
-    // Save selection state before clearing
-    saveSelectionState();
+    // Update inventory data (shared snapshot, no copy)
+    inventorySnapshot_ = inventory.snapshot();
     
-    // Update inventory data
-    inventoryCards_ = inventory.getCards();
-    lastInventorySize_ = inventoryCards_.size();
-    
-    // Check if selectedCard_ is still valid in the new inventory
-    if (selectedCard_) {
-        bool cardStillExists = false;
-        for (const auto& card : inventoryCards_) {
-            if (&card == selectedCard_) {
-                cardStillExists = true;
-                break;
-            }
-        }
-        
-        // If the selected card is no longer in the inventory, clear the selection
-        if (!cardStillExists) {
-            selectedCard_ = nullptr;
-        }
+    // If the selected card is no longer in the inventory, clear the selection
+    if (selectedCard_ && !inventorySnapshot_->resolve(selectedCard_)) {
+        selectedCard_ = CardHandle{};
     }
     
     // Reset pool for reuse
@@ -44,28 +30,21 @@ void UIInventoryContainer::updateInventory(const Inventory& inventory) {
     
     // Create/update only visible cards
     for (int i = startIndex; i < endIndex; ++i) {
-        if (i < 0 || i >= static_cast<int>(inventoryCards_.size())) {
+        if (i < 0 || i >= static_cast<int>(inventoryCards().size())) {
             continue;
         }
         
-        const Card& card = inventoryCards_[i];
         int cardY = getCardYPosition(i);
         
         if (isCardVisible(cardY)) {
-            UICard* uiCard = getCardFromPool();
-            if (uiCard) {
-                int cardX = x_ + Constants::INVENTORY_MARGIN;
-                uiCard->setFromProvider(card);
-                uiCard->setPosition(cardX, cardY);
-                restoreSelectionState(uiCard, card);
-            }
+            showCard(i, cardY);
         }
     }
 }
 #include <iostream>
 void UIInventoryContainer::updateScroll(int scrollOffset) {
     // Check if we need to initialize inventory data first
-    if (inventoryCards_.empty()) {
+    if (inventoryCards().empty()) {
         return;  // No inventory to display
     }
     
@@ -80,9 +59,6 @@ void UIInventoryContainer::updateScroll(int scrollOffset) {
     // Update scroll offset
     setScrollOffset(scrollOffset);
     
-    // Save current selection state
-    saveSelectionState();
-    
     // Reset pool for reuse
     resetPool();
     
@@ -92,26 +68,18 @@ void UIInventoryContainer::updateScroll(int scrollOffset) {
     
     // Create/update only visible cards
     for (int i = startIndex; i < endIndex; ++i) {
-        if (i < 0 || i >= static_cast<int>(inventoryCards_.size())) {
+        if (i < 0 || i >= static_cast<int>(inventoryCards().size())) {
             continue;
         }
         
-        const Card& card = inventoryCards_[i];
-        UICard* uiCard = getCardFromPool();
-        if (uiCard) {
-            int cardX = x_ + Constants::INVENTORY_MARGIN;
-            int cardY = getCardYPosition(i);
-            uiCard->setFromProvider(card);
-            uiCard->setPosition(cardX, cardY);
-            restoreSelectionState(uiCard, card);
-        }
+        showCard(i, getCardYPosition(i));
     }
 }
 
 // Helper method to check if inventory needs updating
 bool UIInventoryContainer::needsInventoryUpdate(const Inventory& inventory) const {
-    const auto& cards = inventory.getCards();
-    return cards.size() != lastInventorySize_ || inventoryCards_.empty();
+    // Versions change on every modification, including quantity-only changes
+    return inventory.getVersion() != inventorySnapshot_->version;
 }
 #include <iostream>
 void UIInventoryContainer::render() {
@@ -159,57 +127,43 @@ const Card* UIInventoryContainer::getCardAtPosition(int x, int y) const {
 }
 
 const Card* UIInventoryContainer::getCardAtPosition(int x, int y, int scrollOffset) const {
+    int cardIndex = getCardIndexAtPosition(x, y, scrollOffset);
+    return cardIndex >= 0 ? &inventoryCards()[cardIndex] : nullptr;
+}
+
+CardHandle UIInventoryContainer::getHandleAtPosition(int x, int y, int scrollOffset) const {
+    int cardIndex = getCardIndexAtPosition(x, y, scrollOffset);
+    return cardIndex >= 0 ? inventorySnapshot_->handles[cardIndex] : CardHandle{};
+}
+
+int UIInventoryContainer::getCardIndexAtPosition(int x, int y, int scrollOffset) const {
     // Check if position is within container bounds
     if (x < x_ || x >= x_ + width_ || y < y_ || y >= y_ + height_) {
-        return nullptr;
+        return -1;
     }
     
     // Calculate which card index based on Y position
     int relativeY = y - y_ + scrollOffset;
     int cardIndex = (relativeY - Constants::INVENTORY_MARGIN) / Constants::CARD_SPACING;
     
-    if (cardIndex >= 0 && cardIndex < static_cast<int>(inventoryCards_.size())) {
+    if (cardIndex >= 0 && cardIndex < static_cast<int>(inventoryCards().size())) {
         // Check X bounds too
         int cardX = x_ + Constants::INVENTORY_MARGIN;
         if (x >= cardX && x <= cardX + Constants::CARD_WIDTH) {
-            return &inventoryCards_[cardIndex];
+            return cardIndex;
         }
     }
     
-    return nullptr;
+    return -1;
 }
 
-void UIInventoryContainer::setSelectedCard(const Card* card) {
-    // Update selection state
-    if (selectedCard_) {
-        selectionState_[getCardKey(*selectedCard_)] = false;
-    }
-    
+void UIInventoryContainer::setSelectedCard(CardHandle card) {
     selectedCard_ = card;
     
-    if (selectedCard_) {
-        selectionState_[getCardKey(*selectedCard_)] = true;
-    }
-    
-    // Update visual state of active cards
+    // Update visual state of active cards; a stale handle simply matches nothing
     for (size_t i = 0; i < usedCards_; ++i) {
         if (cardPool_[i]) {
-            bool isSelected = false;
-            if (selectedCard_) {
-                // Safely check if selectedCard_ is still valid by comparing with inventory cards
-                bool selectedCardValid = false;
-                for (const auto& invCard : inventoryCards_) {
-                    if (&invCard == selectedCard_) {
-                        selectedCardValid = true;
-                        break;
-                    }
-                }
-                
-                if (selectedCardValid) {
-                    isSelected = cardPool_[i]->compareDisplayData(selectedCard_->getCardDisplayData());
-                }
-            }
-            cardPool_[i]->setSelected(isSelected);
+            cardPool_[i]->setSelected(selectedCard_ && poolHandles_[i] == selectedCard_);
         }
     }
 }
@@ -217,11 +171,11 @@ void UIInventoryContainer::setSelectedCard(const Card* card) {
 void UIInventoryContainer::calculateVisibleRange(int& startIndex, int& endIndex) const {
     int visibleCards = height_ / Constants::CARD_SPACING;
     startIndex = std::max(0, (getScrollOffset() / Constants::CARD_SPACING) - BUFFER_CARDS);
-    endIndex = std::min(static_cast<int>(inventoryCards_.size()), 
+    endIndex = std::min(static_cast<int>(inventoryCards().size()), 
                        startIndex + visibleCards + (2 * BUFFER_CARDS));
 }
 
-UICard* UIInventoryContainer::getCardFromPool() {
+UICard* UIInventoryContainer::getCardFromPool(CardHandle handle) {
     // Expand pool if needed
     if (usedCards_ >= cardPool_.size()) {
         int cardX = x_ + Constants::INVENTORY_MARGIN;
@@ -230,8 +184,10 @@ UICard* UIInventoryContainer::getCardFromPool() {
         cardPool_.push_back(std::make_unique<UICard>(
             Card("", 1, CardType::MISC, 1), cardX, cardY, sdlManager_
         ));
+        poolHandles_.push_back(CardHandle{});
     }
     
+    poolHandles_[usedCards_] = handle;
     return cardPool_[usedCards_++].get();
 }
 
@@ -239,28 +195,14 @@ void UIInventoryContainer::resetPool() {
     usedCards_ = 0;
 }
 
-std::string UIInventoryContainer::getCardKey(const Card& card) const {
-    return card.name + "_" + std::to_string(card.rarity);
-}
-
-void UIInventoryContainer::saveSelectionState() {
-    selectionState_.clear();
-    for (size_t i = 0; i < usedCards_; ++i) {
-        if (cardPool_[i]) {
-            const CardDisplayData& displayData = cardPool_[i]->getDisplayData();
-            // Assuming getCardKey can be overloaded or modified to accept CardDisplayData,
-            // or you need to extract the key info from displayData manually.
-            std::string key = displayData.name + "_" + std::to_string(displayData.rarity);
-            selectionState_[key] = cardPool_[i]->isSelected();
-        }
-    }
-}
-
-void UIInventoryContainer::restoreSelectionState(UICard* uiCard, const Card& card) {
-    std::string key = getCardKey(card);
-    auto it = selectionState_.find(key);
-    if (it != selectionState_.end()) {
-        uiCard->setSelected(it->second);
+void UIInventoryContainer::showCard(size_t inventoryIndex, int cardY) {
+    CardHandle handle = inventorySnapshot_->handles[inventoryIndex];
+    UICard* uiCard = getCardFromPool(handle);
+    if (uiCard) {
+        int cardX = x_ + Constants::INVENTORY_MARGIN;
+        uiCard->setFromProvider(inventoryCards()[inventoryIndex]);
+        uiCard->setPosition(cardX, cardY);
+        uiCard->setSelected(selectedCard_ && handle == selectedCard_);
     }
 }
 
@@ -275,12 +217,12 @@ bool UIInventoryContainer::isCardVisible(int cardY) const {
 
 int UIInventoryContainer::getMaxScroll() const {
     // Calculate max scroll based on inventory cards
-    if (inventoryCards_.empty()) {
+    if (inventoryCards().empty()) {
         return 0;
     }
     
     // Total height needed = (number of cards * card spacing) + top/bottom margins
-    int totalContentHeight = inventoryCards_.size() * Constants::CARD_SPACING + 2 * Constants::INVENTORY_MARGIN;
+    int totalContentHeight = inventoryCards().size() * Constants::CARD_SPACING + 2 * Constants::INVENTORY_MARGIN;
     
     // Max scroll = total content height - visible container height
     return std::max(0, totalContentHeight - height_);
@@ -0,0 +1,254 @@
+#include "Systems/CompiledEvents.h"
+#include "Interface/editor/GameData.h"
+#include "Core/Inventory.h"
+#include "Core/Random.h"
+#include <algorithm>
+
+void EventState::readInventory(const InventoryState& inventory) {
+    std::fill(counts.begin(), counts.end(), 0);
+    for (const auto& card : inventory.cards) {
+        if (card.materialId == INVALID_MATERIAL_ID) {
+            continue;
+        }
+        if (card.materialId >= counts.size()) {
+            counts.resize(card.materialId + 1, 0);
+        }
+        counts[card.materialId] += card.quantity;
+    }
+}
+
+void CompiledEvents::clear() {
+    predicateBegin.clear();
+    predicates.clear();
+    never.clear();
+    locations.clear();
+    errors.clear();
+    materialBegin.clear();
+    materialEvents.clear();
+    inventoryEvents.clear();
+    for (auto& events : inputEvents) {
+        events.clear();
+    }
+}
+
+void CompiledEvents::compile(const std::vector<EventTemplate>& events) {
+    clear();
+    predicateBegin.reserve(events.size() + 1);
+    predicateBegin.push_back(0);
+    never.reserve(events.size());
+
+    for (const auto& event : events) {
+        size_t first = predicates.size();
+        bool impossible = false;
+        for (const auto& condition : event.conditions) {
+            Predicate predicate;
+            bool always = false;
+            std::string error;
+            if (!compileCondition(condition, predicate, always, error)) {
+                impossible = true;
+                if (!error.empty()) {
+                    errors.push_back("Event '" + event.id + "': " + error);
+                }
+            } else if (!always) {
+                predicates.push_back(predicate);
+            }
+        }
+        if (impossible) {
+            predicates.resize(first);
+        }
+        // Cheap scalar checks first, inventory lookups next, random draws last
+        std::stable_sort(predicates.begin() + first, predicates.end(),
+                         [](const Predicate& a, const Predicate& b) { return a.kind < b.kind; });
+        predicateBegin.push_back(static_cast<uint32_t>(predicates.size()));
+        never.push_back(impossible);
+    }
+    buildIndex();
+}
+
+void CompiledEvents::buildIndex() {
+    // Events are visited in ascending order, so comparing with back() is
+    // enough to list each event once per input
+    auto addOnce = [](std::vector<uint32_t>& events, uint32_t event) {
+        if (events.empty() || events.back() != event) {
+            events.push_back(event);
+        }
+    };
+
+    std::vector<std::vector<uint32_t>> byMaterial;
+    for (uint32_t event = 0; event < eventCount(); ++event) {
+        for (uint32_t i = predicateBegin[event]; i < predicateBegin[event + 1]; ++i) {
+            const Predicate& predicate = predicates[i];
+            switch (predicate.kind) {
+                case Kind::Location: addOnce(inputEvents[static_cast<size_t>(Input::Location)], event); break;
+                case Kind::Time: addOnce(inputEvents[static_cast<size_t>(Input::Turn)], event); break;
+                case Kind::Health: addOnce(inputEvents[static_cast<size_t>(Input::Health)], event); break;
+                case Kind::Chance: addOnce(inputEvents[static_cast<size_t>(Input::Chance)], event); break;
+                case Kind::InventoryCount:
+                    if (predicate.key >= byMaterial.size()) {
+                        byMaterial.resize(predicate.key + 1);
+                    }
+                    addOnce(byMaterial[predicate.key], event);
+                    addOnce(inventoryEvents, event);
+                    break;
+            }
+        }
+    }
+
+    materialBegin.assign(byMaterial.size() + 1, 0);
+    for (size_t material = 0; material < byMaterial.size(); ++material) {
+        materialBegin[material + 1] = materialBegin[material] + static_cast<uint32_t>(byMaterial[material].size());
+        materialEvents.insert(materialEvents.end(), byMaterial[material].begin(), byMaterial[material].end());
+    }
+}
+
+void CompiledEvents::eventsReadingMaterial(MaterialId material, std::vector<uint32_t>& out) const {
+    if (material + 1 >= materialBegin.size()) {
+        return;
+    }
+    out.insert(out.end(), materialEvents.begin() + materialBegin[material],
+               materialEvents.begin() + materialBegin[material + 1]);
+}
+
+bool CompiledEvents::compileCondition(const EventCondition& condition, Predicate& out, bool& always,
+                                      std::string& error) {
+    static const std::unordered_map<std::string, Compare> operators = {
+        {"<", Compare::Less}, {"<=", Compare::LessEqual}, {"==", Compare::Equal}, {"=", Compare::Equal},
+        {"!=", Compare::NotEqual}, {">=", Compare::GreaterEqual}, {">", Compare::Greater}
+    };
+
+    out.compare = Compare::GreaterEqual;
+    if (!condition.operator_.empty()) {
+        auto it = operators.find(condition.operator_);
+        if (it == operators.end()) {
+            error = "unknown operator '" + condition.operator_ + "'";
+            return false;
+        }
+        out.compare = it->second;
+    }
+    out.key = 0;
+    out.value = condition.value;
+
+    switch (condition.type) {
+        case ConditionType::LOCATION: {
+            if (condition.operator_.empty()) {
+                out.compare = Compare::Equal;
+            } else if (out.compare != Compare::Equal && out.compare != Compare::NotEqual) {
+                error = "location only supports == and !=";
+                return false;
+            }
+            out.kind = Kind::Location;
+            auto result = locations.try_emplace(condition.target, static_cast<uint32_t>(locations.size()));
+            out.key = result.first->second;
+            return true;
+        }
+        case ConditionType::TIME:
+            out.kind = Kind::Time;
+            return true;
+        case ConditionType::PLAYER_HEALTH:
+            out.kind = Kind::Health;
+            return true;
+        case ConditionType::INVENTORY_HAS:
+            // Holding at least one (or value, if larger) of the material
+            out.kind = Kind::InventoryCount;
+            out.compare = Compare::GreaterEqual;
+            out.value = std::max(condition.value, 1.0f);
+            out.key = MaterialRegistry::instance().intern(condition.target);
+            return true;
+        case ConditionType::INVENTORY_COUNT:
+            out.kind = Kind::InventoryCount;
+            out.key = MaterialRegistry::instance().intern(condition.target);
+            return true;
+        case ConditionType::RANDOM_CHANCE:
+            // Values above 1 are percentages
+            out.kind = Kind::Chance;
+            out.value = condition.value > 1.0f ? condition.value / 100.0f : condition.value;
+            if (out.value <= 0.0f) {
+                return false;
+            }
+            always = out.value >= 1.0f;
+            return true;
+    }
+    error = "unknown condition type";
+    return false;
+}
+
+uint32_t CompiledEvents::locationKey(const std::string& location) const {
+    auto it = locations.find(location);
+    return it != locations.end() ? it->second : UINT32_MAX;
+}
+
+bool CompiledEvents::holds(const Predicate& predicate, const EventState& state, uint32_t location, Rng& rng) const {
+    float actual = 0.0f;
+    switch (predicate.kind) {
+        case Kind::Location:
+            return (location == predicate.key) == (predicate.compare == Compare::Equal);
+        case Kind::Chance:
+            return rng.nextFloat() < predicate.value;
+        case Kind::Time:
+            actual = static_cast<float>(state.turn);
+            break;
+        case Kind::Health:
+            actual = state.playerHealth;
+            break;
+        case Kind::InventoryCount:
+            actual = predicate.key < state.counts.size() ? static_cast<float>(state.counts[predicate.key]) : 0.0f;
+            break;
+    }
+    switch (predicate.compare) {
+        case Compare::Less: return actual < predicate.value;
+        case Compare::LessEqual: return actual <= predicate.value;
+        case Compare::Equal: return actual == predicate.value;
+        case Compare::NotEqual: return actual != predicate.value;
+        case Compare::GreaterEqual: return actual >= predicate.value;
+        case Compare::Greater: return actual > predicate.value;
+    }
+    return false;
+}
+
+bool CompiledEvents::eventHolds(size_t event, const EventState& state, uint32_t location, Rng& rng) const {
+    if (never[event]) {
+        return false;
+    }
+    for (uint32_t i = predicateBegin[event]; i < predicateBegin[event + 1]; ++i) {
+        if (!holds(predicates[i], state, location, rng)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool CompiledEvents::canTrigger(size_t event, const EventState& state, Rng& rng) const {
+    if (event >= eventCount()) {
+        return false;
+    }
+    return eventHolds(event, state, locationKey(state.location), rng);
+}
+
+void CompiledEvents::canTriggerAll(const EventState& state, Rng& rng, std::vector<uint8_t>& out) const {
+    // The location is resolved once for the whole pass
+    uint32_t location = locationKey(state.location);
+    out.assign(eventCount(), 0);
+    for (size_t event = 0; event < eventCount(); ++event) {
+        out[event] = eventHolds(event, state, location, rng);
+    }
+}
+
+void CompiledEvents::canTriggerSome(const std::vector<uint32_t>& events, const EventState& state, Rng& rng,
+                                    std::vector<uint8_t>& out) const {
+    uint32_t location = locationKey(state.location);
+    out.resize(eventCount(), 0);
+    for (uint32_t event : events) {
+        out[event] = eventHolds(event, state, location, rng);
+    }
+}
+
+bool CompiledEvents::evaluate(const EventCondition& condition, const EventState& state, Rng& rng) {
+    CompiledEvents single;
+    Predicate predicate;
+    bool always = false;
+    std::string error;
+    if (!single.compileCondition(condition, predicate, always, error)) {
+        return false;
+    }
+    return always || single.holds(predicate, state, single.locationKey(state.location), rng);
+}
@@ -0,0 +1,143 @@
+#include "Systems/CompiledRecipes.h"
+#include "Systems/CraftingSystem.h"
+#include <algorithm>
+#include <limits>
+
+void CompiledRecipes::compile(const std::vector<Recipe>& recipes) {
+    clear();
+    needBegin.reserve(recipes.size() + 1);
+    needBegin.push_back(0);
+
+    for (const auto& recipe : recipes) {
+        uint32_t first = static_cast<uint32_t>(needMaterial.size());
+        for (const auto& ingredient : recipe.ingredients) {
+            if (ingredient.second <= 0 || ingredient.first.materialId == INVALID_MATERIAL_ID) {
+                continue;
+            }
+            MaterialId material = ingredient.first.materialId;
+            auto begin = needMaterial.begin() + first;
+            auto it = std::find(begin, needMaterial.end(), material);
+            if (it != needMaterial.end()) {
+                needQuantity[it - needMaterial.begin()] += ingredient.second;
+                continue;
+            }
+            needMaterial.push_back(material);
+            needQuantity.push_back(ingredient.second);
+            needRarity.push_back(ingredient.first.rarity);
+            needRecipe.push_back(static_cast<uint32_t>(needBegin.size() - 1));
+            slots = std::max(slots, static_cast<size_t>(material) + 1);
+        }
+        needBegin.push_back(static_cast<uint32_t>(needMaterial.size()));
+    }
+
+    // Counting sort of (material, recipe) pairs builds the reverse index in recipe order
+    usingBegin.assign(slots + 1, 0);
+    for (MaterialId material : needMaterial) {
+        ++usingBegin[material + 1];
+    }
+    for (size_t m = 0; m < slots; ++m) {
+        usingBegin[m + 1] += usingBegin[m];
+    }
+    usingRecipes.resize(needMaterial.size());
+    std::vector<uint32_t> fill(usingBegin.begin(), usingBegin.end() - 1);
+    for (size_t i = 0; i < recipeCount(); ++i) {
+        for (uint32_t need = needBegin[i]; need < needBegin[i + 1]; ++need) {
+            usingRecipes[fill[needMaterial[need]]++] = static_cast<uint32_t>(i);
+        }
+    }
+}
+
+void CompiledRecipes::clear() {
+    needBegin.clear();
+    needMaterial.clear();
+    needQuantity.clear();
+    needRarity.clear();
+    needRecipe.clear();
+    usingBegin.clear();
+    usingRecipes.clear();
+    slots = 0;
+}
+
+const uint32_t* CompiledRecipes::recipesUsingBegin(MaterialId material) const {
+    return material < slots ? usingRecipes.data() + usingBegin[material] : nullptr;
+}
+
+const uint32_t* CompiledRecipes::recipesUsingEnd(MaterialId material) const {
+    return material < slots ? usingRecipes.data() + usingBegin[material + 1] : nullptr;
+}
+
+bool CompiledRecipes::canCraft(size_t recipe, const std::vector<int32_t>& counts) const {
+    for (uint32_t need = needBegin[recipe]; need < needBegin[recipe + 1]; ++need) {
+        if (counts[needMaterial[need]] < needQuantity[need]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int32_t CompiledRecipes::maxCrafts(size_t recipe, const std::vector<int32_t>& counts) const {
+    int32_t crafts = std::numeric_limits<int32_t>::max();
+    for (uint32_t need = needBegin[recipe]; need < needBegin[recipe + 1]; ++need) {
+        crafts = std::min(crafts, counts[needMaterial[need]] / needQuantity[need]);
+    }
+    return crafts;
+}
+
+uint32_t CompiledRecipes::bottleneckNeed(size_t recipe, const std::vector<int32_t>& counts) const {
+    uint32_t bottleneck = NO_NEED;
+    for (uint32_t need = needBegin[recipe]; need < needBegin[recipe + 1]; ++need) {
+        if (bottleneck == NO_NEED || limitsMore(need, bottleneck, counts)) {
+            bottleneck = need;
+        }
+    }
+    return bottleneck;
+}
+
+void CompiledRecipes::canCraftAll(const std::vector<int32_t>& counts, std::vector<uint8_t>& out) const {
+    // One flat pass over every need with no per-recipe loop: recipes have
+    // different ingredient counts, and branching on that mispredicts badly
+    const size_t needs = needCount();
+    const int32_t* have = counts.data();
+    const MaterialId* material = needMaterial.data();
+    const int32_t* quantity = needQuantity.data();
+    const uint32_t* owner = needRecipe.data();
+    out.assign(recipeCount(), 1);
+    uint8_t* craftable = out.data();
+    for (size_t need = 0; need < needs; ++need) {
+        craftable[owner[need]] &= static_cast<uint8_t>(have[material[need]] >= quantity[need]);
+    }
+}
+
+void CompiledRecipes::maxCraftsAll(const std::vector<int32_t>& counts, std::vector<int32_t>& out) const {
+    const size_t needs = needCount();
+    const int32_t* have = counts.data();
+    const MaterialId* material = needMaterial.data();
+    const int32_t* quantity = needQuantity.data();
+    const uint32_t* owner = needRecipe.data();
+    out.assign(recipeCount(), std::numeric_limits<int32_t>::max());
+    int32_t* crafts = out.data();
+    for (size_t need = 0; need < needs; ++need) {
+        crafts[owner[need]] = std::min(crafts[owner[need]], have[material[need]] / quantity[need]);
+    }
+}
+
+void CompiledRecipes::maxCraftsAll(const std::vector<int32_t>& counts, std::vector<int32_t>& out,
+                                   std::vector<uint32_t>& bottlenecks) const {
+    const size_t needs = needCount();
+    const int32_t* have = counts.data();
+    const MaterialId* material = needMaterial.data();
+    const int32_t* quantity = needQuantity.data();
+    const uint32_t* owner = needRecipe.data();
+    out.assign(recipeCount(), std::numeric_limits<int32_t>::max());
+    bottlenecks.assign(recipeCount(), NO_NEED);
+    int32_t* crafts = out.data();
+    uint32_t* limiting = bottlenecks.data();
+    for (uint32_t need = 0; need < needs; ++need) {
+        uint32_t recipe = owner[need];
+        uint32_t current = limiting[recipe];
+        if (current == NO_NEED || limitsMore(need, current, counts)) {
+            limiting[recipe] = need;
+        }
+        crafts[recipe] = std::min(crafts[recipe], have[material[need]] / quantity[need]);
+    }
+}
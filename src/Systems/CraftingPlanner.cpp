@@ -0,0 +1,214 @@
+#include "Systems/CraftingPlanner.h"
+#include "Systems/CraftingSystem.h"
+#include "Core/Inventory.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <unordered_set>
+
+namespace {
+const float RAW_COST = 1.0f;
+const float UNREACHABLE = std::numeric_limits<float>::infinity();
+}
+
+CraftingPlanner::CraftingPlanner(const CraftingSystem& craftingSystem)
+    : craftingSystem(craftingSystem) {
+}
+
+const CraftingPlan& CraftingPlanner::plan(const std::string& recipeId, int count, const Inventory& inventory) {
+    syncGraph();
+
+    const auto& recipes = craftingSystem.getAllRecipes();
+    const Recipe* recipe = craftingSystem.getRecipe(recipeId);
+    if (!recipe || !recipe->isUnlocked || count <= 0) {
+        rejected = CraftingPlan{};
+        return rejected;
+    }
+
+    // Cached plans only hold for the inventory version they were made from.
+    // Key on the snapshot's version, not getVersion(): while a writer holds
+    // the lock the snapshot can still be the previous one.
+    InventorySnapshot snapshot = inventory.snapshot();
+    if (inventory.getInstanceId() != planInventory || snapshot->version != planVersion) {
+        plans.clear();
+        planInventory = inventory.getInstanceId();
+        planVersion = snapshot->version;
+    }
+    std::string key = recipeId + "#" + std::to_string(count);
+    auto it = plans.find(key);
+    if (it != plans.end()) {
+        return it->second;
+    }
+    size_t recipeIndex = static_cast<size_t>(recipe - recipes.data());
+    return plans.emplace(key, expand(recipeIndex, count, *snapshot)).first->second;
+}
+
+float CraftingPlanner::unitCost(MaterialId material) {
+    syncGraph();
+    return material < cost.size() ? cost[material] : RAW_COST;
+}
+
+void CraftingPlanner::syncGraph() {
+    uint64_t generation = craftingSystem.getRecipeGeneration();
+    if (generation == graphGeneration) {
+        return;
+    }
+    graphGeneration = generation;
+    plans.clear();
+
+    const auto& recipes = craftingSystem.getAllRecipes();
+    compiled.compile(recipes);
+    size_t slots = compiled.materialSlots();
+    resultMaterial.resize(recipes.size());
+    resultYield.resize(recipes.size());
+    for (size_t i = 0; i < recipes.size(); ++i) {
+        const Recipe& recipe = recipes[i];
+        resultMaterial[i] = recipe.result.materialId;
+        bool usable = recipe.isUnlocked && recipe.successRate > 0.0f &&
+                      recipe.result.quantity > 0 && recipe.result.materialId != INVALID_MATERIAL_ID;
+        resultYield[i] = usable ? recipe.result.quantity * recipe.successRate : 0.0f;
+        if (usable) {
+            slots = std::max(slots, static_cast<size_t>(recipe.result.materialId) + 1);
+        }
+    }
+
+    cost.assign(slots, UNREACHABLE);
+    bestRecipe.assign(slots, -1);
+    std::vector<bool> settled(slots, false);
+    std::vector<bool> produced(slots, false);
+    for (size_t i = 0; i < recipes.size(); ++i) {
+        if (resultYield[i] > 0.0f) {
+            produced[resultMaterial[i]] = true;
+        }
+    }
+
+    using Entry = std::pair<float, MaterialId>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> frontier;
+    auto relax = [&](size_t recipe) {
+        float total = 1.0f;
+        for (uint32_t need = compiled.firstNeed(recipe); need < compiled.endNeed(recipe); ++need) {
+            total += compiled.needQuantityAt(need) * cost[compiled.needMaterialAt(need)];
+        }
+        float unit = total / resultYield[recipe];
+        MaterialId out = resultMaterial[recipe];
+        if (!settled[out] && unit < cost[out]) {
+            cost[out] = unit;
+            bestRecipe[out] = static_cast<int32_t>(recipe);
+            frontier.push({unit, out});
+        }
+    };
+
+    // Materials no unlocked recipe makes are raw
+    for (MaterialId m = 0; m < slots; ++m) {
+        if (!produced[m]) {
+            cost[m] = RAW_COST;
+            frontier.push({RAW_COST, m});
+        }
+    }
+    // A recipe becomes usable once every input has a settled cost
+    std::vector<uint32_t> pending(recipes.size());
+    for (size_t i = 0; i < recipes.size(); ++i) {
+        pending[i] = compiled.endNeed(i) - compiled.firstNeed(i);
+        if (resultYield[i] > 0.0f && pending[i] == 0) {
+            relax(i);
+        }
+    }
+
+    while (!frontier.empty()) {
+        Entry entry = frontier.top();
+        frontier.pop();
+        MaterialId material = entry.second;
+        if (settled[material] || entry.first > cost[material]) {
+            continue;
+        }
+        settled[material] = true;
+        const uint32_t* end = compiled.recipesUsingEnd(material);
+        for (const uint32_t* it = compiled.recipesUsingBegin(material); it != end; ++it) {
+            if (resultYield[*it] > 0.0f && --pending[*it] == 0) {
+                relax(*it);
+            }
+        }
+    }
+}
+
+CraftingPlan CraftingPlanner::expand(size_t recipeIndex, int count, const InventoryState& contents) const {
+    CraftingPlan result;
+    const auto& recipes = craftingSystem.getAllRecipes();
+
+    std::unordered_map<MaterialId, int64_t> stock;
+    for (const auto& card : contents.cards) {
+        stock[card.materialId] += card.quantity;
+    }
+
+    std::unordered_map<MaterialId, int64_t> demand;
+    std::vector<MaterialId> roots;
+    for (uint32_t need = compiled.firstNeed(recipeIndex); need < compiled.endNeed(recipeIndex); ++need) {
+        demand[compiled.needMaterialAt(need)] += static_cast<int64_t>(compiled.needQuantityAt(need)) * count;
+        roots.push_back(compiled.needMaterialAt(need));
+    }
+
+    // Post-order over the chosen recipes: inputs come before what they make
+    auto chosen = [this](MaterialId material) {
+        return material < bestRecipe.size() ? bestRecipe[material] : -1;
+    };
+    std::vector<MaterialId> order;
+    std::unordered_set<MaterialId> visited;
+    std::vector<std::pair<MaterialId, uint32_t>> stack;
+    for (MaterialId root : roots) {
+        if (!visited.insert(root).second) {
+            continue;
+        }
+        stack.push_back({root, 0});
+        while (!stack.empty()) {
+            auto& top = stack.back();
+            int32_t recipe = chosen(top.first);
+            uint32_t needCount = recipe >= 0 ? compiled.endNeed(recipe) - compiled.firstNeed(recipe) : 0;
+            if (top.second < needCount) {
+                MaterialId child = compiled.needMaterialAt(compiled.firstNeed(recipe) + top.second++);
+                if (visited.insert(child).second) {
+                    stack.push_back({child, 0});
+                }
+                continue;
+            }
+            order.push_back(top.first);
+            stack.pop_back();
+        }
+    }
+
+    // Walk products before their inputs so each material's demand is complete
+    // when it is reached; use stock first and craft only the shortfall
+    std::vector<CraftingPlanStep> reversedSteps;
+    for (auto it = order.rbegin(); it != order.rend(); ++it) {
+        MaterialId material = *it;
+        int64_t wanted = demand[material];
+        int64_t& have = stock[material];
+        int64_t used = std::min(have, wanted);
+        have -= used;
+        int64_t shortfall = wanted - used;
+        if (shortfall <= 0) {
+            continue;
+        }
+
+        int32_t recipe = chosen(material);
+        if (recipe < 0) {
+            result.missing.emplace_back(material, static_cast<int>(shortfall));
+            continue;
+        }
+        int64_t crafts = static_cast<int64_t>(std::ceil(shortfall / resultYield[recipe] - 1e-4f));
+        crafts = std::max<int64_t>(crafts, 1);
+        reversedSteps.push_back({recipes[recipe].id, static_cast<int>(crafts)});
+        for (uint32_t need = compiled.firstNeed(recipe); need < compiled.endNeed(recipe); ++need) {
+            demand[compiled.needMaterialAt(need)] += compiled.needQuantityAt(need) * crafts;
+        }
+    }
+
+    result.steps.assign(reversedSteps.rbegin(), reversedSteps.rend());
+    result.steps.push_back({recipes[recipeIndex].id, count});
+    for (const auto& step : result.steps) {
+        result.totalCrafts += step.crafts;
+    }
+    result.feasible = result.missing.empty();
+    return result;
+}
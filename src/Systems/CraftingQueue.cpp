@@ -0,0 +1,210 @@
+#include "Systems/CraftingQueue.h"
+#include "Systems/CraftingSystem.h"
+#include "Core/Inventory.h"
+#include "Core/Random.h"
+#include "Core/BaseManager.h"
+#include "Constants.h"
+#include <algorithm>
+#include <iostream>
+#include <unordered_map>
+
+CraftingQueue::CraftingQueue(CraftingSystem& craftingSystem, Inventory& inventory, const BaseManager* baseManager)
+    : craftingSystem(craftingSystem), inventory(inventory), baseManager(baseManager) {
+}
+
+uint32_t CraftingQueue::enqueue(const std::string& recipeId, int count) {
+    const Recipe* recipe = craftingSystem.getRecipe(recipeId);
+    if (!recipe || !recipe->isUnlocked || count <= 0) {
+        return 0;
+    }
+
+    CraftingJob job;
+    job.recipeId = recipeId;
+    job.result = recipe->result;
+    job.count = count;
+    job.successRate = craftingSystem.calculateActualSuccessRate(*recipe, inventory);
+
+    // Remember what the stacks look like, so reserved units can be given back intact
+    std::unordered_map<CardId, Card> templates;
+    for (const auto& ingredient : recipe->ingredients) {
+        if (ingredient.second > 0) {
+            job.needs.emplace_back(ingredient.first.getId(), ingredient.second);
+            inventory.forEachOfMaterial(ingredient.first.materialId, [&templates](const Card& card) {
+                templates.emplace(card.getId(), card);
+            });
+        }
+    }
+
+    // One reservation for the whole job
+    InventoryBatch batch;
+    craftingSystem.addIngredientRemovals(*recipe, batch, count);
+    std::vector<InventoryDelta> taken;
+    if (!inventory.apply(batch, taken)) {
+        return 0;
+    }
+    for (const auto& delta : taken) {
+        auto it = templates.find(delta.id);
+        if (it == templates.end()) {
+            continue;
+        }
+        Card card = it->second;
+        card.quantity = delta.oldQuantity - delta.newQuantity;
+        job.reserved.push_back(card);
+    }
+
+    job.id = nextJobId++;
+    jobs.push_back(std::move(job));
+    std::cout << "Queued " << count << " x " << recipe->name << std::endl;
+    return jobs.back().id;
+}
+
+bool CraftingQueue::cancel(uint32_t jobId) {
+    auto it = std::find_if(jobs.begin(), jobs.end(),
+        [jobId](const CraftingJob& job) { return job.id == jobId; });
+    if (it == jobs.end()) {
+        return false;
+    }
+
+    // Items in progress are abandoned along with the rest
+    for (auto& station : stations) {
+        if (station.jobId == jobId) {
+            station = Station{};
+        }
+    }
+    InventoryBatch refund;
+    for (const auto& card : it->reserved) {
+        refund.add(card);
+    }
+    inventory.apply(refund);
+    jobs.erase(it);
+    return true;
+}
+
+void CraftingQueue::update(float deltaSeconds) {
+    if (jobs.empty() || deltaSeconds <= 0.0f) {
+        return;
+    }
+    resizeStations();
+
+    InventoryBatch output;
+    for (auto& station : stations) {
+        float remaining = deltaSeconds;
+        // A long frame can finish several items on one station
+        while (remaining > 0.0f) {
+            if (station.jobId == 0 && !startNextItem(station)) {
+                break;
+            }
+            CraftingJob* job = findJob(station.jobId);
+            if (!job) {
+                station = Station{};
+                continue;
+            }
+
+            float needed = Constants::CRAFT_TIME_SECONDS - station.elapsed;
+            if (remaining < needed) {
+                station.elapsed += remaining;
+                if (onProgress) {
+                    onProgress(*job, station.elapsed / Constants::CRAFT_TIME_SECONDS);
+                }
+                break;
+            }
+            remaining -= needed;
+            station = Station{};
+            finishItem(*job, output);
+        }
+    }
+
+    // Everything finished this update lands in one inventory change
+    if (!output.empty()) {
+        inventory.apply(output);
+    }
+
+    for (auto it = jobs.begin(); it != jobs.end();) {
+        if (!it->isFinished()) {
+            ++it;
+            continue;
+        }
+        std::cout << "Crafted " << it->succeeded << "/" << it->count << " x " << it->result.name << std::endl;
+        if (onJobFinished) {
+            onJobFinished(*it);
+        }
+        it = jobs.erase(it);
+    }
+}
+
+int CraftingQueue::getStationCount() const {
+    int workshops = baseManager ? baseManager->countOperationalBuildings(BuildingType::WORKSHOP) : 0;
+    return 1 + workshops;
+}
+
+const CraftingJob* CraftingQueue::getJob(uint32_t jobId) const {
+    auto it = std::find_if(jobs.begin(), jobs.end(),
+        [jobId](const CraftingJob& job) { return job.id == jobId; });
+    return it != jobs.end() ? &*it : nullptr;
+}
+
+CraftingJob* CraftingQueue::findJob(uint32_t jobId) {
+    return const_cast<CraftingJob*>(static_cast<const CraftingQueue*>(this)->getJob(jobId));
+}
+
+void CraftingQueue::resizeStations() {
+    size_t target = static_cast<size_t>(getStationCount());
+    if (stations.size() < target) {
+        stations.resize(target);
+    }
+    // Stations lost with a workshop finish their current item first
+    while (stations.size() > target && stations.back().jobId == 0) {
+        stations.pop_back();
+    }
+}
+
+bool CraftingQueue::startNextItem(Station& station) {
+    // First come, first served: later jobs only get stations the earlier ones leave free
+    for (auto& job : jobs) {
+        if (job.started < job.count) {
+            ++job.started;
+            station.jobId = job.id;
+            station.elapsed = 0.0f;
+            return true;
+        }
+    }
+    return false;
+}
+
+void CraftingQueue::finishItem(CraftingJob& job, InventoryBatch& output) {
+    ++job.completed;
+    useReservedMaterials(job);
+
+    Rng& rng = RandomService::instance().stream(RngStream::Crafting);
+    bool success = rng.nextFloat() <= job.successRate;
+    if (success) {
+        ++job.succeeded;
+        output.add(job.result);
+    } else if (rng.nextFloat() <= 0.5f) {
+        output.add(CraftingSystem::createScrap());
+    }
+
+    if (onItemCompleted) {
+        onItemCompleted(job, success);
+    }
+}
+
+void CraftingQueue::useReservedMaterials(CraftingJob& job) {
+    // Same order crafting consumes in: the preferred stack, then other rarities
+    for (const auto& need : job.needs) {
+        int remaining = need.second;
+        for (int pass = 0; pass < 2 && remaining > 0; ++pass) {
+            for (auto& card : job.reserved) {
+                bool matches = pass == 0 ? card.getId() == need.first
+                                         : card.materialId == need.first.material;
+                if (matches && card.quantity > 0) {
+                    int amount = std::min(remaining, card.quantity);
+                    card.quantity -= amount;
+                    remaining -= amount;
+                }
+            }
+        }
+    }
+    job.reserved.erase(std::remove_if(job.reserved.begin(), job.reserved.end(),
+        [](const Card& card) { return card.quantity <= 0; }), job.reserved.end());
+}
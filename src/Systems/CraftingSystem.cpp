@@ -1,9 +1,10 @@
 #include "Systems/CraftingSystem.h"
 #include "Core/Inventory.h"
+#include "Core/Random.h"
 #include "Constants.h"
 #include "Systems/DataManager.h"
 #include <algorithm>
-#include <random>
+#include <limits>
 #include <iostream>
 
 CraftingSystem::CraftingSystem() {
@@ -11,8 +12,8 @@ CraftingSystem::CraftingSystem() {
 }
 
 CraftingResult CraftingSystem::craftItem(const Recipe& recipe, Inventory& inventory) {
-    // Check if crafting is possible
-    if (!canCraft(recipe, inventory)) {
+    // Check if crafting is possible; materials are validated when the batch is applied
+    if (!isRecipeUnlocked(recipe.id)) {
         return CraftingResult(false, Card("", 1, CardType::MISC), "Insufficient materials or recipe not unlocked");
     }
     
@@ -20,18 +21,20 @@ CraftingResult CraftingSystem::craftItem(const Recipe& recipe, Inventory& invent
     float actualSuccessRate = calculateActualSuccessRate(recipe, inventory);
     
     // Perform random check
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
-    bool success = dist(gen) <= actualSuccessRate;
+    Rng& rng = RandomService::instance().stream(RngStream::Crafting);
+    bool success = rng.nextFloat() <= actualSuccessRate;
     
-    // Consume materials
-    consumeMaterials(recipe, inventory);
+    // Consume materials and add the outcome in one atomic inventory update
+    InventoryBatch batch;
+    addIngredientRemovals(recipe, batch);
 
     if (success) {
         // Crafting succeeded
         Card resultCard = recipe.result;
-        inventory.addCard(resultCard);
+        batch.add(resultCard);
+        if (!inventory.apply(batch)) {
+            return CraftingResult(false, Card("", 1, CardType::MISC), "Insufficient materials or recipe not unlocked");
+        }
 
         std::string successMsg = "Successfully crafted " + resultCard.name + "!";
         std::cout << successMsg << std::endl;
@@ -42,13 +45,13 @@ CraftingResult CraftingSystem::craftItem(const Recipe& recipe, Inventory& invent
         std::string failMsg = "Crafting failed! Materials were wasted.";
 
         // 50% chance to get scrap
-        if (dist(gen) <= 0.5f) {
-            Card scrap("Scrap", 1, CardType::MISC);
-            scrap.setAttribute(AttributeType::CRAFTING_VALUE, 1.0f);
-            scrap.setAttribute(AttributeType::TRADE_VALUE, 2.0f);
-            inventory.addCard(scrap);
+        if (rng.nextFloat() <= 0.5f) {
+            batch.add(createScrap());
             failMsg += " But you received some scrap.";
         }
+        if (!inventory.apply(batch)) {
+            return CraftingResult(false, Card("", 1, CardType::MISC), "Insufficient materials or recipe not unlocked");
+        }
         
         std::cout << failMsg << std::endl;
         return CraftingResult(false, Card("", 1, CardType::MISC), failMsg);
@@ -56,7 +59,8 @@ CraftingResult CraftingSystem::craftItem(const Recipe& recipe, Inventory& invent
 }
 
 bool CraftingSystem::canCraft(const Recipe& recipe, const Inventory& inventory) const {
-    return isRecipeUnlocked(recipe.id) && hasEnoughMaterials(recipe, inventory);
+    auto it = recipeIndexMap.find(recipe.id);
+    return it != recipeIndexMap.end() && isCraftable(it->second, inventory);
 }
 
 const std::vector<Recipe>& CraftingSystem::getAllRecipes() const {
@@ -66,19 +70,134 @@ const std::vector<Recipe>& CraftingSystem::getAllRecipes() const {
 const std::vector<Recipe> CraftingSystem::getAvailableRecipes(const Inventory& inventory) const {
     std::vector<Recipe> available;
     
-    for (const auto& recipe : recipes) {
-        if (canCraft(recipe, inventory)) {
-            available.push_back(recipe);
+    syncAvailability(inventory);
+    for (size_t i = 0; i < recipes.size(); ++i) {
+        if (recipes[i].isUnlocked && maxCrafts[i] > 0) {
+            available.push_back(recipes[i]);
         }
     }
     
     return available;
 }
 
+bool CraftingSystem::isCraftable(size_t recipeIndex, const Inventory& inventory) const {
+    return getMaxCraftCount(recipeIndex, inventory) > 0;
+}
+
+int CraftingSystem::getMaxCraftCount(size_t recipeIndex, const Inventory& inventory) const {
+    if (recipeIndex >= recipes.size() || !recipes[recipeIndex].isUnlocked) {
+        return 0;
+    }
+    syncAvailability(inventory);
+    return maxCrafts[recipeIndex];
+}
+
+MaterialId CraftingSystem::getBottleneckMaterial(size_t recipeIndex, const Inventory& inventory) const {
+    if (recipeIndex >= recipes.size()) {
+        return INVALID_MATERIAL_ID;
+    }
+    syncAvailability(inventory);
+    uint32_t need = bottleneckNeeds[recipeIndex];
+    return need != CompiledRecipes::NO_NEED ? compiled.needMaterialAt(need) : INVALID_MATERIAL_ID;
+}
+
+void CraftingSystem::syncAvailability(const Inventory& inventory) const {
+    if (!recipesCompiled) {
+        compileRecipes();
+    }
+    if (availabilityInventory != inventory.getInstanceId()) {
+        recountAvailability(inventory);
+        return;
+    }
+    
+    uint64_t currentVersion = inventory.getVersion();
+    if (currentVersion == availabilityVersion) {
+        return;
+    }
+    std::vector<InventoryDelta> deltas;
+    if (!inventory.changesSince(availabilityVersion, deltas)) {
+        recountAvailability(inventory);
+        return;
+    }
+    
+    // Only recipes using a changed material are looked at, and most of those
+    // are settled by comparing the changed need with the current bottleneck
+    for (const auto& delta : deltas) {
+        MaterialId material = delta.id.material;
+        if (material >= materialCounts.size() || delta.newQuantity == delta.oldQuantity) {
+            continue;
+        }
+        int32_t before = materialCounts[material];
+        int32_t after = before + delta.newQuantity - delta.oldQuantity;
+        materialCounts[material] = after;
+        
+        const uint32_t* end = compiled.recipesUsingEnd(material);
+        for (const uint32_t* it = compiled.recipesUsingBegin(material); it != end; ++it) {
+            uint32_t recipeIndex = *it;
+            uint32_t need = compiled.firstNeed(recipeIndex);
+            while (compiled.needMaterialAt(need) != material) {
+                ++need;
+            }
+            uint32_t bottleneck = bottleneckNeeds[recipeIndex];
+            if (need == bottleneck && after > before) {
+                // The limit was lifted; another need may be the tightest now
+                evaluateAvailability(recipeIndex);
+            } else if (need == bottleneck || compiled.limitsMore(need, bottleneck, materialCounts)) {
+                bottleneckNeeds[recipeIndex] = need;
+                maxCrafts[recipeIndex] = after / compiled.needQuantityAt(need);
+            }
+        }
+    }
+    availabilityVersion = deltas.empty() ? currentVersion : std::max(currentVersion, deltas.back().version);
+}
+
+void CraftingSystem::compileRecipes() const {
+    compiled.compile(recipes);
+    recipesCompiled = true;
+    // Counts are sized for the compiled materials, so they must be redone too
+    availabilityInventory = 0;
+}
+
+void CraftingSystem::recountAvailability(const Inventory& inventory) const {
+    // A snapshot gives counts and a version that match, so no delta is applied twice
+    InventorySnapshot snapshot = inventory.snapshot();
+    materialCounts.assign(compiled.materialSlots(), 0);
+    for (const auto& card : snapshot->cards) {
+        if (card.materialId < materialCounts.size()) {
+            materialCounts[card.materialId] += card.quantity;
+        }
+    }
+    
+    compiled.maxCraftsAll(materialCounts, maxCrafts, bottleneckNeeds);
+    availabilityInventory = inventory.getInstanceId();
+    availabilityVersion = snapshot->version;
+}
+
+void CraftingSystem::evaluateAvailability(size_t recipeIndex) const {
+    uint32_t need = compiled.bottleneckNeed(recipeIndex, materialCounts);
+    bottleneckNeeds[recipeIndex] = need;
+    maxCrafts[recipeIndex] = need != CompiledRecipes::NO_NEED
+        ? materialCounts[compiled.needMaterialAt(need)] / compiled.needQuantityAt(need)
+        : std::numeric_limits<int32_t>::max();
+}
+
+void CraftingSystem::addRecipe(const Recipe& recipe) {
+    auto it = recipeIndexMap.find(recipe.id);
+    if (it != recipeIndexMap.end()) {
+        recipes[it->second] = recipe;
+    } else {
+        recipes.push_back(recipe);
+        recipeIndexMap[recipe.id] = recipes.size() - 1;
+    }
+    recipesCompiled = false;
+    ++recipeGeneration;
+}
+
 void CraftingSystem::unlockRecipe(const std::string& recipeId) {
     auto it = recipeIndexMap.find(recipeId);
     if (it != recipeIndexMap.end()) {
         recipes[it->second].isUnlocked = true;
+        ++recipeGeneration;
         std::cout << "Unlocked new recipe: " << recipes[it->second].name << std::endl;
     }
 }
@@ -96,6 +215,8 @@ const Recipe* CraftingSystem::getRecipe(const std::string& recipeId) const {
 void CraftingSystem::initializeDefaultRecipes() {
     recipes.clear();
     recipeIndexMap.clear();
+    recipesCompiled = false;
+    ++recipeGeneration;
     
     // Basic crafting recipes
     
@@ -206,94 +327,48 @@ void CraftingSystem::initializeDefaultRecipes() {
     std::cout << "Initialized " << recipes.size() << " crafting recipes" << std::endl;
 }
 
-bool CraftingSystem::hasEnoughMaterials(const Recipe& recipe, const Inventory& inventory) const {
-    const auto& cards = inventory.getCards();
-    
-    for (const auto& ingredient : recipe.ingredients) {
-        const Card& requiredCard = ingredient.first;
-        int requiredQuantity = ingredient.second;
-        
-        // Find the corresponding card and check the quantity
-        int totalAvailable = 0;
-        for (const auto& card : cards) {
-            // First try exact match (name and rarity)
-            if (card.name == requiredCard.name && 
-                card.rarity == requiredCard.rarity) {
-                totalAvailable += card.quantity;
-            }
-            // If exact match not enough, also consider same name but different rarity
-            // This allows more flexible crafting (e.g., using rare materials for common recipes)
-            else if (card.name == requiredCard.name && totalAvailable < requiredQuantity) {
-                totalAvailable += card.quantity;
-            }
-        }
-        
-        if (totalAvailable < requiredQuantity) {
-            return false;
-        }
-    }
-    
-    return true;
+Card CraftingSystem::createScrap() {
+    Card scrap("Scrap", 1, CardType::MISC);
+    scrap.setAttribute(AttributeType::CRAFTING_VALUE, 1.0f);
+    scrap.setAttribute(AttributeType::TRADE_VALUE, 2.0f);
+    return scrap;
 }
 
-void CraftingSystem::consumeMaterials(const Recipe& recipe, Inventory& inventory) {
+void CraftingSystem::addIngredientRemovals(const Recipe& recipe, InventoryBatch& batch, int times) const {
     for (const auto& ingredient : recipe.ingredients) {
         const Card& requiredCard = ingredient.first;
-        int requiredQuantity = ingredient.second;
-        int remainingToRemove = requiredQuantity;
-        
-        // First try to remove exact matches (name and rarity)
-        auto cards = inventory.getCards();
-        for (auto& card : cards) {
-            if (remainingToRemove <= 0) break;
-            
-            if (card.name == requiredCard.name && 
-                card.rarity == requiredCard.rarity &&
-                card.quantity > 0) {
-                int toRemove = std::min(remainingToRemove, card.quantity);
-                for (int i = 0; i < toRemove; ++i) {
-                    inventory.removeCard(requiredCard.name, requiredCard.rarity);
-                }
-                remainingToRemove -= toRemove;
-            }
-        }
+        int requiredQuantity = ingredient.second * times;
         
-        // If still need more, remove from cards with same name but different rarity
-        if (remainingToRemove > 0) {
-            cards = inventory.getCards(); // Refresh the list
-            for (auto& card : cards) {
-                if (remainingToRemove <= 0) break;
-                
-                if (card.name == requiredCard.name && card.quantity > 0) {
-                    int toRemove = std::min(remainingToRemove, card.quantity);
-                    for (int i = 0; i < toRemove; ++i) {
-                        inventory.removeCard(card.name, card.rarity);
-                    }
-                    remainingToRemove -= toRemove;
-                }
-            }
-        }
+        // Exact rarity first, then same material at other rarities
+        // This allows more flexible crafting (e.g., using rare materials for common recipes)
+        batch.removeAnyRarity(requiredCard.materialId, requiredQuantity, requiredCard.rarity);
     }
 }
 
 float CraftingSystem::calculateActualSuccessRate(const Recipe& recipe, const Inventory& inventory) const {
     float baseRate = recipe.successRate;
     
+    // Rarity of the first stack of each ingredient material, via the material index
+    std::unordered_map<MaterialId, int> firstRarity;
+    for (const auto& ingredient : recipe.ingredients) {
+        auto result = firstRarity.emplace(ingredient.first.materialId, 0);
+        if (result.second) {
+            int& rarity = result.first->second;
+            inventory.forEachOfMaterial(ingredient.first.materialId, [&rarity](const Card& card) {
+                if (rarity == 0) {
+                    rarity = card.rarity;
+                }
+            });
+        }
+    }
+    
     // Adjust success rate based on material quality
     float qualityBonus = 0.0f;
-    const auto& cards = inventory.getCards();
-    
     for (const auto& ingredient : recipe.ingredients) {
-        const Card& requiredCard = ingredient.first;
-        
-        for (const auto& card : cards) {
-            if (card.name == requiredCard.name) {
-                // Higher rarity slightly increases success rate
-                if (card.rarity == 2) qualityBonus += 0.05f;
-                else if (card.rarity == 3) qualityBonus += 0.1f;
-                break;
-            }
-        }
+        int rarity = firstRarity[ingredient.first.materialId];
+        // Higher rarity slightly increases success rate
+        if (rarity == 2) qualityBonus += 0.05f;
+        else if (rarity == 3) qualityBonus += 0.1f;
     }
     
     return std::min(1.0f, baseRate + qualityBonus);
@@ -303,23 +378,15 @@ void CraftingSystem::loadRecipesFromDataManager(const DataManagement::GameDataMa
     clearRecipes();
     
     const auto& recipeDataList = dataManager.getRecipes();
+    recipes.reserve(recipeDataList.size());
     
     for (const auto& recipeData : recipeDataList) {
         // Convert DataManagement::RecipeData to Recipe
         std::vector<std::pair<Card, int>> ingredients;
         
         for (const auto& ingredient : recipeData.ingredients) {
-            // Try to find the material with any rarity level
-            const DataManagement::MaterialData* materialData = nullptr;
-            
-            // Search through all materials to find one with matching name
-            const auto& allMaterials = dataManager.getMaterials();
-            for (const auto& material : allMaterials) {
-                if (material.name == ingredient.first) {
-                    materialData = &material;
-                    break; // Take the first match (could be improved to prefer lower rarity)
-                }
-            }
+            // Try to find the material with any rarity level (first match)
+            const DataManagement::MaterialData* materialData = dataManager.findMaterialByName(ingredient.first);
             
             if (materialData) {
                 Card ingredientCard = materialData->toCard();
@@ -368,4 +435,6 @@ void CraftingSystem::loadRecipesFromDataManager(const DataManagement::GameDataMa
 void CraftingSystem::clearRecipes() {
     recipes.clear();
     recipeIndexMap.clear();
+    recipesCompiled = false;
+    ++recipeGeneration;
 }
@@ -1,16 +1,506 @@
 #include "Systems/DataManager.h"
 #include "Core/Inventory.h"
 #include "Systems/CraftingSystem.h"
+#include "Systems/LootTables.h"
+#include "Systems/DataPack.h"
 #include "Core/Controller.h"
+#include "Core/JobSystem.h"
+#include "Core/MappedFile.h"
+#include "Systems/JsonStream.h"
 #include <nlohmann/json.hpp>
+#include <algorithm>
+#include <chrono>
 #include <fstream>
+#include <initializer_list>
 #include <iostream>
 #include <sstream>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_set>
 #include <filesystem>
 
 using json = nlohmann::json;
 using namespace DataManagement;
 
+namespace {
+
+// First name in names whose bit (1 << position) is not set in seen
+const char* firstMissing(unsigned seen, std::initializer_list<const char*> names) {
+    unsigned bit = 1;
+    for (const char* name : names) {
+        if (!(seen & bit)) {
+            return name;
+        }
+        bit <<= 1;
+    }
+    return nullptr;
+}
+
+/**
+ * Shared shape of the data files: a root object with a "version" string
+ * and top-level arrays of record objects. Records are built in place as
+ * the parser reaches their fields and checked for required fields when
+ * they close; the manager takes the results only if the whole file parsed.
+ */
+class DataFileReader : public JsonStreamReader {
+public:
+    std::string version;
+    bool hasVersion = false;
+
+protected:
+    // Directly inside a record object of the top-level array list
+    bool inRecord(const char* list) const {
+        return depth() == 3 && underList(list) && !isArray(3);
+    }
+    // Inside the container stored under field of such a record
+    bool inRecordField(const char* list, const char* field) const {
+        return depth() == 4 && underList(list) && !isArray(3) && name(4) == field;
+    }
+    // Inside an object element of that container, when it is an array
+    bool inRecordFieldElement(const char* list, const char* field) const {
+        return depth() == 5 && underList(list) && !isArray(3) && name(4) == field &&
+               isArray(4) && !isArray(5);
+    }
+    // Elements of list must be objects, as the DOM accessors required
+    bool isListElement(const char* list) const {
+        return depth() == 2 && underList(list);
+    }
+
+    bool readVersion(Scalar& value) {
+        hasVersion = true;
+        return get(value, version);
+    }
+
+    bool missing(const char* record, size_t index, const char* field) {
+        return fail(std::string(record) + " " + std::to_string(index) + " is missing '" + field + "'");
+    }
+
+private:
+    bool underList(const char* list) const {
+        return depth() >= 2 && isArray(2) && name(2) == list;
+    }
+};
+
+class GameConfigReader : public DataFileReader {
+public:
+    std::string configName;
+    std::string description;
+    bool hasConfigName = false;
+    bool hasDescription = false;
+    std::unordered_map<std::string, std::string> settings;
+
+protected:
+    bool onValue(const std::string& key, Scalar& value) override {
+        if (depth() == 1 && key == "version") {
+            return readVersion(value);
+        }
+        if (depth() == 1 && key == "config_name") {
+            hasConfigName = true;
+            return get(value, configName);
+        }
+        if (depth() == 1 && key == "description") {
+            hasDescription = true;
+            return get(value, description);
+        }
+        // Only string settings are kept, anything else is skipped
+        if (depth() == 2 && !isArray(2) && name(2) == "settings" && value.type == Scalar::Type::String) {
+            return get(value, settings[key]);
+        }
+        return true;
+    }
+};
+
+class MaterialsReader : public DataFileReader {
+public:
+    std::vector<MaterialData> materials;
+    bool hasMaterials = false;
+
+protected:
+    bool onValue(const std::string& key, Scalar& value) override {
+        if (depth() == 1 && key == "version") {
+            return readVersion(value);
+        }
+        if (isListElement("materials")) {
+            return fail("expected an object in 'materials'");
+        }
+        if (inRecord("materials")) {
+            if (key == "name") {
+                seen |= 1;
+                return get(value, current.name);
+            }
+            if (key == "rarity") {
+                seen |= 2;
+                return get(value, current.rarity);
+            }
+            if (key == "type") {
+                seen |= 4;
+                int type;
+                if (!get(value, type)) {
+                    return false;
+                }
+                current.type = static_cast<CardType>(type);
+                return true;
+            }
+            if (key == "base_quantity") {
+                return get(value, current.baseQuantity);
+            }
+            return true;
+        }
+        if (inRecordField("materials", "attributes") && !isArray(4)) {
+            float amount;
+            if (!get(value, amount)) {
+                return false;
+            }
+            current.attributes[static_cast<AttributeType>(std::stoi(key))] = amount;
+        }
+        return true;
+    }
+
+    bool onBeginArray() override {
+        if (depth() == 2 && name(2) == "materials") {
+            hasMaterials = true;
+            materials.clear();
+        } else if (isListElement("materials")) {
+            return fail("expected an object in 'materials'");
+        }
+        return true;
+    }
+
+    bool onBeginObject() override {
+        if (inRecord("materials")) {
+            current = MaterialData();
+            seen = 0;
+        }
+        return true;
+    }
+
+    bool onEndObject() override {
+        if (!inRecord("materials")) {
+            return true;
+        }
+        if (const char* field = firstMissing(seen, {"name", "rarity", "type"})) {
+            return missing("material", materials.size(), field);
+        }
+        MaterialRegistry::instance().intern(current.name);
+        materials.push_back(std::move(current));
+        return true;
+    }
+
+private:
+    MaterialData current;
+    unsigned seen = 0;
+};
+
+class RecipesReader : public DataFileReader {
+public:
+    std::vector<RecipeData> recipes;
+    bool hasRecipes = false;
+
+protected:
+    bool onValue(const std::string& key, Scalar& value) override {
+        if (depth() == 1 && key == "version") {
+            return readVersion(value);
+        }
+        if (isListElement("recipes")) {
+            return fail("expected an object in 'recipes'");
+        }
+        if (inRecord("recipes")) {
+            if (key == "id") {
+                seen |= 1;
+                return get(value, current.id);
+            }
+            if (key == "name") {
+                seen |= 2;
+                return get(value, current.name);
+            }
+            if (key == "description") {
+                seen |= 4;
+                return get(value, current.description);
+            }
+            if (key == "result_material") {
+                seen |= 8;
+                return get(value, current.resultMaterial);
+            }
+            if (key == "success_rate") {
+                seen |= 16;
+                return get(value, current.successRate);
+            }
+            if (key == "unlock_level") {
+                return get(value, current.unlockLevel);
+            }
+            if (key == "is_unlocked") {
+                return get(value, current.isUnlocked);
+            }
+            return true;
+        }
+        if (inRecordFieldElement("recipes", "ingredients")) {
+            if (key == "material") {
+                ingredientSeen |= 1;
+                return get(value, ingredient.first);
+            }
+            if (key == "quantity") {
+                ingredientSeen |= 2;
+                return get(value, ingredient.second);
+            }
+        }
+        return true;
+    }
+
+    bool onBeginArray() override {
+        if (depth() == 2 && name(2) == "recipes") {
+            hasRecipes = true;
+            recipes.clear();
+        } else if (isListElement("recipes")) {
+            return fail("expected an object in 'recipes'");
+        }
+        return true;
+    }
+
+    bool onBeginObject() override {
+        if (inRecord("recipes")) {
+            current = RecipeData();
+            current.unlockLevel = 0;
+            current.isUnlocked = true;
+            seen = 0;
+        } else if (inRecordFieldElement("recipes", "ingredients")) {
+            ingredient = {};
+            ingredientSeen = 0;
+        }
+        return true;
+    }
+
+    bool onEndObject() override {
+        if (inRecordFieldElement("recipes", "ingredients")) {
+            if (const char* field = firstMissing(ingredientSeen, {"material", "quantity"})) {
+                return missing("ingredient of recipe", recipes.size(), field);
+            }
+            current.ingredients.push_back(std::move(ingredient));
+            return true;
+        }
+        if (!inRecord("recipes")) {
+            return true;
+        }
+        if (const char* field = firstMissing(seen, {"id", "name", "description", "result_material",
+                                                     "success_rate"})) {
+            return missing("recipe", recipes.size(), field);
+        }
+        recipes.push_back(std::move(current));
+        return true;
+    }
+
+private:
+    RecipeData current;
+    unsigned seen = 0;
+    std::pair<std::string, int> ingredient;
+    unsigned ingredientSeen = 0;
+};
+
+class EventsReader : public DataFileReader {
+public:
+    std::vector<EventData> events;
+    std::vector<LootTableData> lootTables;
+    bool hasEvents = false;
+
+protected:
+    bool onValue(const std::string& key, Scalar& value) override {
+        if (depth() == 1 && key == "version") {
+            return readVersion(value);
+        }
+        if (isListElement("events")) {
+            return fail("expected an object in 'events'");
+        }
+        if (isListElement("loot_tables")) {
+            return fail("expected an object in 'loot_tables'");
+        }
+        if (inRecord("events")) {
+            return readEventField(key, value);
+        }
+        if (inRecord("loot_tables")) {
+            if (key == "id") {
+                seen |= 1;
+                return get(value, table.id);
+            }
+            return true;
+        }
+        if (depth() == 4 && isArray(4)) {
+            if (inRecordField("events", "effects")) {
+                return getInto(value, event.effects);
+            }
+            if (inRecordField("events", "reward_materials")) {
+                return getInto(value, event.rewardMaterials);
+            }
+            if (inRecordField("events", "penalty_materials")) {
+                return getInto(value, event.penaltyMaterials);
+            }
+            return true;
+        }
+        if (inLootEntry()) {
+            return readLootEntryField(key, value);
+        }
+        return true;
+    }
+
+    bool onBeginArray() override {
+        if (depth() == 2 && name(2) == "events") {
+            hasEvents = true;
+            events.clear();
+        } else if (depth() == 2 && name(2) == "loot_tables") {
+            lootTables.clear();
+        } else if (isListElement("events") || isListElement("loot_tables")) {
+            return fail("expected an object in '" + name(2) + "'");
+        }
+        return true;
+    }
+
+    bool onBeginObject() override {
+        if (inRecord("events")) {
+            event = EventData();
+            event.isActive = true;
+            seen = 0;
+        } else if (inRecord("loot_tables")) {
+            table = LootTableData();
+            seen = 0;
+        } else if (inLootEntry()) {
+            entry = LootEntryData();
+            hasMax = false;
+        }
+        return true;
+    }
+
+    bool onEndObject() override {
+        if (inLootEntry()) {
+            if (!hasMax) {
+                entry.maxQuantity = entry.minQuantity;
+            }
+            if (name(2) == "loot_tables") {
+                table.entries.push_back(std::move(entry));
+            } else if (name(4) == "rewards") {
+                event.rewards.push_back(std::move(entry));
+            } else {
+                event.penalties.push_back(std::move(entry));
+            }
+            return true;
+        }
+        if (inRecord("events")) {
+            if (const char* field = firstMissing(seen, {"name", "description", "probability"})) {
+                return missing("event", events.size(), field);
+            }
+            events.push_back(std::move(event));
+        } else if (inRecord("loot_tables")) {
+            if (!(seen & 1)) {
+                return missing("loot table", lootTables.size(), "id");
+            }
+            lootTables.push_back(std::move(table));
+        }
+        return true;
+    }
+
+private:
+    EventData event;
+    LootTableData table;
+    LootEntryData entry;
+    unsigned seen = 0;
+    bool hasMax = false;
+
+    bool inLootEntry() const {
+        return inRecordFieldElement("events", "rewards") || inRecordFieldElement("events", "penalties") ||
+               inRecordFieldElement("loot_tables", "entries");
+    }
+
+    bool getInto(Scalar& value, std::vector<std::string>& list) {
+        list.emplace_back();
+        return get(value, list.back());
+    }
+
+    bool readEventField(const std::string& key, Scalar& value) {
+        if (key == "id") {
+            return get(value, event.id);
+        }
+        if (key == "name") {
+            seen |= 1;
+            return get(value, event.name);
+        }
+        if (key == "description") {
+            seen |= 2;
+            return get(value, event.description);
+        }
+        if (key == "probability") {
+            seen |= 4;
+            return get(value, event.probability);
+        }
+        if (key == "type") {
+            return get(value, event.type);
+        }
+        if (key == "trigger_condition") {
+            return get(value, event.triggerCondition);
+        }
+        if (key == "is_active") {
+            return get(value, event.isActive);
+        }
+        return true;
+    }
+
+    bool readLootEntryField(const std::string& key, Scalar& value) {
+        if (key == "material") {
+            return get(value, entry.material);
+        }
+        if (key == "rarity") {
+            return get(value, entry.rarity);
+        }
+        if (key == "table") {
+            return get(value, entry.table);
+        }
+        if (key == "event") {
+            return get(value, entry.event);
+        }
+        if (key == "weight") {
+            return get(value, entry.weight);
+        }
+        if (key == "min") {
+            return get(value, entry.minQuantity);
+        }
+        if (key == "max") {
+            hasMax = true;
+            return get(value, entry.maxQuantity);
+        }
+        if (key == "requires") {
+            return get(value, entry.requiresMaterial);
+        }
+        if (key == "requires_count") {
+            return get(value, entry.requiresCount);
+        }
+        return true;
+    }
+};
+
+json lootEntriesToJson(const std::vector<LootEntryData>& entries) {
+    json entriesJson = json::array();
+    for (const auto& entry : entries) {
+        json entryJson;
+        if (!entry.material.empty()) {
+            entryJson["material"] = entry.material;
+            entryJson["rarity"] = entry.rarity;
+        }
+        if (!entry.table.empty()) {
+            entryJson["table"] = entry.table;
+        }
+        if (!entry.event.empty()) {
+            entryJson["event"] = entry.event;
+        }
+        entryJson["weight"] = entry.weight;
+        entryJson["min"] = entry.minQuantity;
+        entryJson["max"] = entry.maxQuantity;
+        if (!entry.requiresMaterial.empty()) {
+            entryJson["requires"] = entry.requiresMaterial;
+            entryJson["requires_count"] = entry.requiresCount;
+        }
+        entriesJson.push_back(entryJson);
+    }
+    return entriesJson;
+}
+
+}
+
 // Version implementation
 Version Version::fromString(const std::string& versionStr) {
     Version version;
@@ -49,9 +539,7 @@ bool Version::isCompatible(const Version& other) const {
 // MaterialData implementation
 Card MaterialData::toCard() const {
     Card card(name, rarity, type, baseQuantity);
-    for (const auto& attr : attributes) {
-        card.setAttribute(attr.first, attr.second);
-    }
+    card.attributes = attributes;
     return card;
 }
 
@@ -108,70 +596,122 @@ GameDataManager::GameDataManager() {
 GameDataManager::~GameDataManager() = default;
 
 bool GameDataManager::loadGameConfig(const std::string& configPath) {
-    std::string content;
-    if (!readFileContent(configPath, content)) {
+    MappedFile file;
+    if (!file.open(configPath)) {
         std::cerr << "Failed to read game config file: " << configPath << std::endl;
         return false;
     }
     
-    return parseGameConfigJson(content);
+    return parseGameConfigJson(file.begin(), file.end());
 }
 
 bool GameDataManager::loadMaterials(const std::string& materialsPath) {
-    std::string content;
-    if (!readFileContent(materialsPath, content)) {
+    MappedFile file;
+    if (!file.open(materialsPath)) {
         std::cerr << "Failed to read materials file: " << materialsPath << std::endl;
         return false;
     }
     
-    return parseMaterialsJson(content);
+    return parseMaterialsJson(file.begin(), file.end());
 }
 
 bool GameDataManager::loadRecipes(const std::string& recipesPath) {
-    std::string content;
-    if (!readFileContent(recipesPath, content)) {
+    MappedFile file;
+    if (!file.open(recipesPath)) {
         std::cerr << "Failed to read recipes file: " << recipesPath << std::endl;
         return false;
     }
     
-    return parseRecipesJson(content);
+    return parseRecipesJson(file.begin(), file.end());
 }
 
 bool GameDataManager::loadEvents(const std::string& eventsPath) {
-    std::string content;
-    if (!readFileContent(eventsPath, content)) {
+    MappedFile file;
+    if (!file.open(eventsPath)) {
         std::cerr << "Failed to read events file: " << eventsPath << std::endl;
         return false;
     }
     
-    return parseEventsJson(content);
+    return parseEventsJson(file.begin(), file.end());
 }
 
 bool GameDataManager::loadAllData(const std::string& dataDirectory) {
-    std::string configPath = dataDirectory + "game_config.json";
-    std::string materialsPath = dataDirectory + "materials.json";
-    std::string recipesPath = dataDirectory + "recipes.json";
-    std::string eventsPath = dataDirectory + "events.json";
+    // A current pack needs neither parsing nor validation
+    auto packStarted = std::chrono::steady_clock::now();
+    if (loadDataPack(dataDirectory)) {
+        double packMilliseconds = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - packStarted).count();
+        loadTimings = {FileLoadTiming{DataPack::FILE_NAME, packMilliseconds, true}};
+        std::cout << "  " << DataPack::FILE_NAME << ": " << packMilliseconds << " ms" << std::endl;
+        std::cout << "Successfully loaded compiled game data" << std::endl;
+        return true;
+    }
+    return loadJsonData(dataDirectory);
+}
+
+bool GameDataManager::loadJsonData(const std::string& dataDirectory) {
+    using Loader = bool (GameDataManager::*)(const std::string&);
+    const std::pair<const char*, Loader> files[] = {
+        {"game_config.json", &GameDataManager::loadGameConfig},
+        {"materials.json", &GameDataManager::loadMaterials},
+        {"recipes.json", &GameDataManager::loadRecipes},
+        {"events.json", &GameDataManager::loadEvents},
+    };
+    constexpr size_t fileCount = sizeof(files) / sizeof(files[0]);
+    
+    // Files that fail to load keep what was there, so finish the pack's data
+    ensureData();
+    dataPack.reset();
+    
+    // Each file fills its own members and parses without looking at the
+    // others, so all four load side by side. Validation resolves references
+    // between them (recipes and events to materials) and waits for all.
+    loadTimings.assign(fileCount, FileLoadTiming());
+    ValidationResult validation;
+    bool validated = false;
+    
+    auto started = std::chrono::steady_clock::now();
+    TaskGraph graph;
+    std::vector<TaskGraph::Node> loads;
+    for (size_t i = 0; i < fileCount; ++i) {
+        loads.push_back(graph.add([this, &files, &dataDirectory, i]() {
+            auto fileStarted = std::chrono::steady_clock::now();
+            FileLoadTiming& timing = loadTimings[i];
+            timing.file = files[i].first;
+            timing.loaded = (this->*files[i].second)(dataDirectory + files[i].first);
+            timing.milliseconds = std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - fileStarted).count();
+        }));
+    }
+    graph.add([this, &validation, &validated]() {
+        bool allLoaded = std::all_of(loadTimings.begin(), loadTimings.end(),
+                                     [](const FileLoadTiming& timing) { return timing.loaded; });
+        if (allLoaded) {
+            validation = validateAll();
+            validated = true;
+        }
+    }, loads);
+    graph.run(JobSystem::instance());
+    double totalMilliseconds = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - started).count();
+    
+    for (const auto& timing : loadTimings) {
+        std::cout << "  " << timing.file << ": " << timing.milliseconds << " ms"
+                  << (timing.loaded ? "" : " (failed)") << std::endl;
+    }
+    std::cout << "Data files loaded in " << totalMilliseconds << " ms" << std::endl;
     
-    // Load game config first
-    if (!loadGameConfig(configPath)) {
+    if (!loadTimings[0].loaded) {
         std::cerr << "Failed to load game configuration" << std::endl;
         return false;
     }
     
-    // Load other data files
-    bool success = true;
-    success &= loadMaterials(materialsPath);
-    success &= loadRecipes(recipesPath);
-    success &= loadEvents(eventsPath);
-    
-    if (!success) {
+    if (!validated) {
         std::cerr << "Failed to load some data files" << std::endl;
         return false;
     }
     
     // Validate loaded data
-    ValidationResult validation = validateAll();
     if (!validation.isValid) {
         std::cerr << "Data validation failed:\n" << validation.getSummary() << std::endl;
         return false;
@@ -185,6 +725,123 @@ bool GameDataManager::loadAllData(const std::string& dataDirectory) {
     return true;
 }
 
+bool GameDataManager::compileDataPack(const std::string& dataDirectory) {
+    // Stamped and hashed before parsing, so an edit in between leaves the
+    // pack stale rather than matching JSON it does not hold
+    std::vector<DataPack::SourceStamp> stamps;
+    uint64_t sourceHash = 0;
+    if (!DataPack::stampSources(dataDirectory, stamps) || !DataPack::hashSources(dataDirectory, sourceHash)) {
+        std::cerr << "Data pack needs every JSON file in " << dataDirectory << std::endl;
+        return false;
+    }
+    
+    // Parsed afresh rather than taken from a loaded manager, whose lists may
+    // hold unsaved edits or predate the files now on disk
+    GameDataManager source;
+    if (!source.loadJsonData(dataDirectory)) {
+        std::cerr << "Not compiling: the JSON in " << dataDirectory << " did not load" << std::endl;
+        return false;
+    }
+    
+    // Startup skips the payload hash, so check what was written here
+    std::string path = dataDirectory + DataPack::FILE_NAME;
+    std::string error;
+    DataPack written;
+    if (!DataPack::write(source, sourceHash, stamps, path, error) || !written.open(path, error) ||
+        !written.verify(error)) {
+        std::cerr << "Failed to write data pack: " << error << std::endl;
+        return false;
+    }
+    std::cout << "Compiled " << source.materials.size() << " materials, " << source.recipes.size()
+              << " recipes and " << source.events.size() << " events into " << dataDirectory
+              << DataPack::FILE_NAME << std::endl;
+    return true;
+}
+
+bool GameDataManager::loadDataPack(const std::string& dataDirectory) {
+    std::string path = dataDirectory + DataPack::FILE_NAME;
+    if (!std::filesystem::exists(path)) {
+        return false;
+    }
+    
+    auto pack = std::make_unique<DataPack>();
+    std::string error;
+    if (!pack->open(path, error)) {
+        std::cerr << "Ignoring data pack: " << error << std::endl;
+        return false;
+    }
+    if (!pack->isCurrent(dataDirectory)) {
+        std::cout << "Data pack is stale, loading JSON instead" << std::endl;
+        return false;
+    }
+    
+    // Only the config and versions are read now; the lists follow on first use
+    Version versions[3];
+    pack->readConfig(gameConfig, versions);
+    materialsVersion = versions[0];
+    recipesVersion = versions[1];
+    eventsVersion = versions[2];
+    std::lock_guard<std::mutex> lock(packMutex);
+    dataPack = std::move(pack);
+    packPending.store(true, std::memory_order_release);
+    return true;
+}
+
+void GameDataManager::ensureData() const {
+    if (!packPending.load(std::memory_order_acquire)) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(packMutex);
+    if (packPending.load(std::memory_order_relaxed)) {
+        dataPack->read(materials, recipes, events, lootTables);
+        rebuildMaterialIndex();
+        rebuildRecipeIndex();
+        packPending.store(false, std::memory_order_release);
+    }
+}
+
+const std::vector<MaterialData>& GameDataManager::getMaterials() const {
+    ensureData();
+    return materials;
+}
+
+const std::vector<RecipeData>& GameDataManager::getRecipes() const {
+    ensureData();
+    return recipes;
+}
+
+const std::vector<EventData>& GameDataManager::getEvents() const {
+    ensureData();
+    return events;
+}
+
+const std::vector<LootTableData>& GameDataManager::getLootTables() const {
+    ensureData();
+    return lootTables;
+}
+
+void GameDataManager::setMaterials(const std::vector<MaterialData>& mats) {
+    ensureData();
+    materials = mats;
+    rebuildMaterialIndex();
+}
+
+void GameDataManager::setRecipes(const std::vector<RecipeData>& recs) {
+    ensureData();
+    recipes = recs;
+    rebuildRecipeIndex();
+}
+
+void GameDataManager::setEvents(const std::vector<EventData>& evts) {
+    ensureData();
+    events = evts;
+}
+
+void GameDataManager::setLootTables(const std::vector<LootTableData>& tables) {
+    ensureData();
+    lootTables = tables;
+}
+
 bool GameDataManager::saveGameConfig(const std::string& configPath) const {
     if (!ensureDirectoryExists(std::filesystem::path(configPath).parent_path())) {
         return false;
@@ -242,6 +899,7 @@ bool GameDataManager::saveAllData(const std::string& dataDirectory) const {
 }
 
 ValidationResult GameDataManager::validateVersion() const {
+    ensureData();
     ValidationResult result;
     
     // Check if all data versions match the global version
@@ -277,37 +935,25 @@ ValidationResult GameDataManager::validateVersion() const {
 }
 
 ValidationResult GameDataManager::validateDataConsistency() const {
+    ensureData();
     ValidationResult result;
     
+    // Every reference is one lookup in the name index
+    auto materialNamed = [this](const std::string& name) {
+        return materialsByName.count(MaterialRegistry::instance().find(name)) > 0;
+    };
+    
     // Validate recipe dependencies
     for (const auto& recipe : recipes) {
         // Check if recipe ingredients exist in materials
         for (const auto& ingredient : recipe.ingredients) {
-            const std::string& materialName = ingredient.first;
-            bool found = false;
-            
-            for (const auto& material : materials) {
-                if (material.name == materialName) {
-                    found = true;
-                    break;
-                }
-            }
-            
-            if (!found) {
-                result.addError("Recipe '" + recipe.name + "' references non-existent material: " + materialName);
+            if (!materialNamed(ingredient.first)) {
+                result.addError("Recipe '" + recipe.name + "' references non-existent material: " + ingredient.first);
             }
         }
         
         // Check if recipe result exists in materials
-        bool resultFound = false;
-        for (const auto& material : materials) {
-            if (material.name == recipe.resultMaterial) {
-                resultFound = true;
-                break;
-            }
-        }
-        
-        if (!resultFound) {
+        if (!materialNamed(recipe.resultMaterial)) {
             result.addError("Recipe '" + recipe.name + "' produces non-existent material: " + recipe.resultMaterial);
         }
     }
@@ -316,46 +962,40 @@ ValidationResult GameDataManager::validateDataConsistency() const {
     for (const auto& event : events) {
         // Check reward materials
         for (const auto& rewardMaterial : event.rewardMaterials) {
-            bool found = false;
-            for (const auto& material : materials) {
-                if (material.name == rewardMaterial) {
-                    found = true;
-                    break;
-                }
-            }
-            if (!found) {
+            if (!materialNamed(rewardMaterial)) {
                 result.addWarning("Event '" + event.name + "' references non-existent reward material: " + rewardMaterial);
             }
         }
         
         // Check penalty materials
         for (const auto& penaltyMaterial : event.penaltyMaterials) {
-            bool found = false;
-            for (const auto& material : materials) {
-                if (material.name == penaltyMaterial) {
-                    found = true;
-                    break;
-                }
-            }
-            if (!found) {
+            if (!materialNamed(penaltyMaterial)) {
                 result.addWarning("Event '" + event.name + "' references non-existent penalty material: " + penaltyMaterial);
             }
         }
     }
     
+    // Loot references and table cycles are checked by compiling the tables
+    LootTables compiledLoot;
+    ValidationResult lootResult = compiledLoot.compile(*this);
+    for (const auto& error : lootResult.errors) {
+        result.addError(error);
+    }
+    
     return result;
 }
 
 ValidationResult GameDataManager::validateMaterials() const {
+    ensureData();
     ValidationResult result;
     
-    // Check for duplicate materials
-    std::unordered_map<std::string, int> materialCounts;
-    for (const auto& material : materials) {
-        std::string key = material.name + "_" + std::to_string(material.rarity);
-        materialCounts[key]++;
+    for (size_t i = 0; i < materials.size(); ++i) {
+        const auto& material = materials[i];
         
-        if (materialCounts[key] > 1) {
+        // Check for duplicate materials: the index holds the first of each key
+        CardId key{MaterialRegistry::instance().find(material.name), material.rarity};
+        auto first = materialIndex.find(key);
+        if (first != materialIndex.end() && first->second != i) {
             result.addError("Duplicate material found: " + material.name + " (rarity " + std::to_string(material.rarity) + ")");
         }
         
@@ -377,14 +1017,15 @@ ValidationResult GameDataManager::validateMaterials() const {
 }
 
 ValidationResult GameDataManager::validateRecipes() const {
+    ensureData();
     ValidationResult result;
     
-    // Check for duplicate recipe IDs
-    std::unordered_map<std::string, int> recipeIds;
-    for (const auto& recipe : recipes) {
-        recipeIds[recipe.id]++;
+    for (size_t i = 0; i < recipes.size(); ++i) {
+        const auto& recipe = recipes[i];
         
-        if (recipeIds[recipe.id] > 1) {
+        // Check for duplicate recipe IDs: the index holds the first of each
+        auto first = recipeIndex.find(recipe.id);
+        if (first != recipeIndex.end() && first->second != i) {
             result.addError("Duplicate recipe ID found: " + recipe.id);
         }
         
@@ -414,14 +1055,14 @@ ValidationResult GameDataManager::validateRecipes() const {
 }
 
 ValidationResult GameDataManager::validateEvents() const {
+    ensureData();
     ValidationResult result;
     
-    // Check for duplicate event names
-    std::unordered_map<std::string, int> eventNames;
+    // Check for duplicate event names; views into events, which outlive the set
+    std::unordered_set<std::string_view> eventNames;
+    eventNames.reserve(events.size());
     for (const auto& event : events) {
-        eventNames[event.name]++;
-        
-        if (eventNames[event.name] > 1) {
+        if (!eventNames.insert(event.name).second) {
             result.addError("Duplicate event name found: " + event.name);
         }
         
@@ -434,7 +1075,8 @@ ValidationResult GameDataManager::validateEvents() const {
             result.addWarning("Event '" + event.name + "' has unusual probability: " + std::to_string(event.probability));
         }
         
-        if (event.rewardMaterials.empty() && event.penaltyMaterials.empty()) {
+        if (event.rewardMaterials.empty() && event.penaltyMaterials.empty() &&
+            event.rewards.empty() && event.penalties.empty()) {
             result.addWarning("Event '" + event.name + "' has no rewards or penalties");
         }
     }
@@ -443,27 +1085,38 @@ ValidationResult GameDataManager::validateEvents() const {
 }
 
 ValidationResult GameDataManager::validateAll() const {
+    ensureData();
     ValidationResult result;
     
-    // Combine all validation results
-    ValidationResult versionResult = validateVersion();
-    ValidationResult consistencyResult = validateDataConsistency();
-    ValidationResult materialsResult = validateMaterials();
-    ValidationResult recipesResult = validateRecipes();
-    ValidationResult eventsResult = validateEvents();
+    // The validators only read, so they run side by side; results are merged
+    // in a fixed order so the report does not depend on scheduling
+    using Validator = ValidationResult (GameDataManager::*)() const;
+    const Validator validators[] = {
+        &GameDataManager::validateVersion,
+        &GameDataManager::validateDataConsistency,
+        &GameDataManager::validateMaterials,
+        &GameDataManager::validateRecipes,
+        &GameDataManager::validateEvents,
+    };
+    constexpr size_t validatorCount = sizeof(validators) / sizeof(validators[0]);
+    ValidationResult results[validatorCount];
+    
+    JobSystem& jobs = JobSystem::instance();
+    std::vector<JobHandle> handles;
+    for (size_t i = 0; i < validatorCount; ++i) {
+        handles.push_back(jobs.submit([this, &validators, &results, i]() {
+            results[i] = (this->*validators[i])();
+        }));
+    }
+    jobs.waitAll(handles);
     
     // Merge results
-    result.errors.insert(result.errors.end(), versionResult.errors.begin(), versionResult.errors.end());
-    result.errors.insert(result.errors.end(), consistencyResult.errors.begin(), consistencyResult.errors.end());
-    result.errors.insert(result.errors.end(), materialsResult.errors.begin(), materialsResult.errors.end());
-    result.errors.insert(result.errors.end(), recipesResult.errors.begin(), recipesResult.errors.end());
-    result.errors.insert(result.errors.end(), eventsResult.errors.begin(), eventsResult.errors.end());
-    
-    result.warnings.insert(result.warnings.end(), versionResult.warnings.begin(), versionResult.warnings.end());
-    result.warnings.insert(result.warnings.end(), consistencyResult.warnings.begin(), consistencyResult.warnings.end());
-    result.warnings.insert(result.warnings.end(), materialsResult.warnings.begin(), materialsResult.warnings.end());
-    result.warnings.insert(result.warnings.end(), recipesResult.warnings.begin(), recipesResult.warnings.end());
-    result.warnings.insert(result.warnings.end(), eventsResult.warnings.begin(), eventsResult.warnings.end());
+    for (const auto& part : results) {
+        result.errors.insert(result.errors.end(), part.errors.begin(), part.errors.end());
+    }
+    for (const auto& part : results) {
+        result.warnings.insert(result.warnings.end(), part.warnings.begin(), part.warnings.end());
+    }
     
     result.isValid = result.errors.empty();
     
@@ -471,48 +1124,217 @@ ValidationResult GameDataManager::validateAll() const {
 }
 
 bool GameDataManager::materialExists(const std::string& name, int rarity) const {
-    return findMaterial(name, rarity) != nullptr;
+    return findMaterialIndex(name, rarity) >= 0;
 }
 
 MaterialData* GameDataManager::findMaterial(const std::string& name, int rarity) {
-    for (auto& material : materials) {
-        if (material.name == name && material.rarity == rarity) {
-            return &material;
+    int index = findMaterialIndex(name, rarity);
+    return index >= 0 ? &materials[index] : nullptr;
+}
+
+const MaterialData* GameDataManager::findMaterial(const std::string& name, int rarity) const {
+    int index = findMaterialIndex(name, rarity);
+    return index >= 0 ? &materials[index] : nullptr;
+}
+
+const MaterialData* GameDataManager::findMaterialByName(const std::string& name) const {
+    ensureData();
+    auto it = materialsByName.find(MaterialRegistry::instance().find(name));
+    return it != materialsByName.end() ? &materials[it->second.front()] : nullptr;
+}
+
+RecipeData* GameDataManager::findRecipe(const std::string& id) {
+    int index = findRecipeIndex(id);
+    return index >= 0 ? &recipes[index] : nullptr;
+}
+
+const RecipeData* GameDataManager::findRecipe(const std::string& id) const {
+    int index = findRecipeIndex(id);
+    return index >= 0 ? &recipes[index] : nullptr;
+}
+
+int GameDataManager::findMaterialIndex(const std::string& name, int rarity) const {
+    ensureData();
+    // Names never interned cannot belong to any material
+    MaterialId id = MaterialRegistry::instance().find(name);
+    if (id == INVALID_MATERIAL_ID) {
+        return -1;
+    }
+    auto it = materialIndex.find(CardId{id, rarity});
+    return it != materialIndex.end() ? static_cast<int>(it->second) : -1;
+}
+
+int GameDataManager::findRecipeIndex(const std::string& id) const {
+    ensureData();
+    auto it = recipeIndex.find(id);
+    return it != recipeIndex.end() ? static_cast<int>(it->second) : -1;
+}
+
+void GameDataManager::rebuildMaterialIndex() const {
+    materialIndex.clear();
+    materialsByName.clear();
+    materialIndex.reserve(materials.size());
+    for (size_t i = 0; i < materials.size(); ++i) {
+        indexMaterial(static_cast<uint32_t>(i));
+    }
+}
+
+void GameDataManager::rebuildRecipeIndex() const {
+    recipeIndex.clear();
+    recipeIndex.reserve(recipes.size());
+    for (size_t i = 0; i < recipes.size(); ++i) {
+        recipeIndex.try_emplace(recipes[i].id, static_cast<uint32_t>(i));
+    }
+}
+
+void GameDataManager::indexMaterial(uint32_t index) const {
+    const MaterialData& material = materials[index];
+    MaterialId id = MaterialRegistry::instance().intern(material.name);
+
+    auto& sameName = materialsByName[id];
+    sameName.insert(std::lower_bound(sameName.begin(), sameName.end(), index), index);
+
+    auto result = materialIndex.try_emplace(CardId{id, material.rarity}, index);
+    if (!result.second && index < result.first->second) {
+        result.first->second = index;
+    }
+}
+
+void GameDataManager::unindexMaterial(uint32_t index) {
+    const MaterialData& material = materials[index];
+    MaterialId id = MaterialRegistry::instance().find(material.name);
+    auto byName = materialsByName.find(id);
+    if (byName == materialsByName.end()) {
+        return;
+    }
+    auto& sameName = byName->second;
+    sameName.erase(std::remove(sameName.begin(), sameName.end(), index), sameName.end());
+
+    // A duplicate of the same key, if any, takes over
+    CardId key{id, material.rarity};
+    auto it = materialIndex.find(key);
+    if (it != materialIndex.end() && it->second == index) {
+        auto next = std::find_if(sameName.begin(), sameName.end(), [&](uint32_t other) {
+            return materials[other].rarity == material.rarity;
+        });
+        if (next != sameName.end()) {
+            it->second = *next;
+        } else {
+            materialIndex.erase(it);
         }
     }
-    return nullptr;
+    if (sameName.empty()) {
+        materialsByName.erase(byName);
+    }
 }
 
-const MaterialData* GameDataManager::findMaterial(const std::string& name, int rarity) const {
-    for (const auto& material : materials) {
-        if (material.name == name && material.rarity == rarity) {
-            return &material;
+void GameDataManager::addMaterial(const MaterialData& material) {
+    ensureData();
+    materials.push_back(material);
+    indexMaterial(static_cast<uint32_t>(materials.size() - 1));
+}
+
+bool GameDataManager::updateMaterial(const std::string& name, int rarity, const MaterialData& material) {
+    ensureData();
+    int index = findMaterialIndex(name, rarity);
+    if (index < 0) {
+        return false;
+    }
+    unindexMaterial(static_cast<uint32_t>(index));
+    materials[index] = material;
+    indexMaterial(static_cast<uint32_t>(index));
+    return true;
+}
+
+bool GameDataManager::removeMaterial(const std::string& name, int rarity) {
+    ensureData();
+    int index = findMaterialIndex(name, rarity);
+    if (index < 0) {
+        return false;
+    }
+    uint32_t removed = static_cast<uint32_t>(index);
+    unindexMaterial(removed);
+    materials.erase(materials.begin() + index);
+
+    // Everything after the removed material moved down by one
+    for (auto& entry : materialIndex) {
+        if (entry.second > removed) {
+            --entry.second;
         }
     }
-    return nullptr;
+    for (auto& entry : materialsByName) {
+        for (auto& other : entry.second) {
+            if (other > removed) {
+                --other;
+            }
+        }
+    }
+    return true;
 }
 
-RecipeData* GameDataManager::findRecipe(const std::string& id) {
-    for (auto& recipe : recipes) {
-        if (recipe.id == id) {
-            return &recipe;
+void GameDataManager::addRecipe(const RecipeData& recipe) {
+    ensureData();
+    recipes.push_back(recipe);
+    recipeIndex.try_emplace(recipe.id, static_cast<uint32_t>(recipes.size() - 1));
+}
+
+bool GameDataManager::updateRecipe(const std::string& id, const RecipeData& recipe) {
+    ensureData();
+    int index = findRecipeIndex(id);
+    if (index < 0) {
+        return false;
+    }
+    uint32_t updated = static_cast<uint32_t>(index);
+    if (recipe.id != id) {
+        unindexRecipe(updated);
+    }
+    recipes[index] = recipe;
+    auto result = recipeIndex.try_emplace(recipe.id, updated);
+    if (!result.second && updated < result.first->second) {
+        result.first->second = updated;
+    }
+    return true;
+}
+
+bool GameDataManager::removeRecipe(const std::string& id) {
+    ensureData();
+    int index = findRecipeIndex(id);
+    if (index < 0) {
+        return false;
+    }
+    uint32_t removed = static_cast<uint32_t>(index);
+    unindexRecipe(removed);
+    recipes.erase(recipes.begin() + index);
+
+    // Everything after the removed recipe moved down by one
+    for (auto& entry : recipeIndex) {
+        if (entry.second > removed) {
+            --entry.second;
         }
     }
-    return nullptr;
+    return true;
 }
 
-const RecipeData* GameDataManager::findRecipe(const std::string& id) const {
-    for (const auto& recipe : recipes) {
-        if (recipe.id == id) {
-            return &recipe;
+void GameDataManager::unindexRecipe(uint32_t index) {
+    const std::string& id = recipes[index].id;
+    auto it = recipeIndex.find(id);
+    if (it == recipeIndex.end() || it->second != index) {
+        return;
+    }
+    // A later recipe with the same id, if any, takes over
+    for (size_t i = index + 1; i < recipes.size(); ++i) {
+        if (recipes[i].id == id) {
+            it->second = static_cast<uint32_t>(i);
+            return;
         }
     }
-    return nullptr;
+    recipeIndex.erase(it);
 }
 
 // Continued in next part due to length...
 
 bool GameDataManager::applyToInventory(Inventory& inventory) const {
+    ensureData();
     // Clear existing inventory and add materials
     std::vector<Card> newCards;
     
@@ -527,6 +1349,7 @@ bool GameDataManager::applyToInventory(Inventory& inventory) const {
 }
 
 bool GameDataManager::applyToCraftingSystem(CraftingSystem& craftingSystem) const {
+    ensureData();
     // Load recipes from this DataManager into the CraftingSystem
     craftingSystem.loadRecipesFromDataManager(*this);
     std::cout << "Applied " << recipes.size() << " recipes to crafting system" << std::endl;
@@ -534,10 +1357,17 @@ bool GameDataManager::applyToCraftingSystem(CraftingSystem& craftingSystem) cons
 }
 
 bool GameDataManager::applyToController(Controller& controller) const {
-    // This would require extending Controller to accept event data
-    // For now, we'll log the action
-    std::cout << "Applied " << events.size() << " events to controller" << std::endl;
-    return true;
+    ensureData();
+    // Events and loot tables drive exploration
+    LootTables compiledLoot;
+    ValidationResult result = compiledLoot.compile(*this);
+    for (const auto& error : result.errors) {
+        std::cerr << "Loot table error: " << error << std::endl;
+    }
+    controller.setLootTables(compiledLoot);
+    std::cout << "Applied " << events.size() << " events and " << compiledLoot.tableCount()
+              << " loot tables to controller" << std::endl;
+    return result.isValid;
 }
 
 void GameDataManager::createDefaultGameConfig() {
@@ -550,6 +1380,7 @@ void GameDataManager::createDefaultGameConfig() {
 }
 
 void GameDataManager::createDefaultMaterials() {
+    ensureData();
     materials.clear();
     
     // Basic materials
@@ -637,9 +1468,11 @@ void GameDataManager::createDefaultMaterials() {
     tool.attributes[AttributeType::WEIGHT] = 2.0f;
     tool.attributes[AttributeType::TRADE_VALUE] = 25.0f;
     materials.push_back(tool);
+    rebuildMaterialIndex();
 }
 
 void GameDataManager::createDefaultRecipes() {
+    ensureData();
     recipes.clear();
     
     // Medkit recipe
@@ -677,9 +1510,11 @@ void GameDataManager::createDefaultRecipes() {
     tool.unlockLevel = 1;
     tool.isUnlocked = false;
     recipes.push_back(tool);
+    rebuildRecipeIndex();
 }
 
 void GameDataManager::createDefaultEvents() {
+    ensureData();
     events.clear();
     
     // Resource discovery event
@@ -740,28 +1575,24 @@ void GameDataManager::createDefaultDataFiles(const std::string& dataDirectory) {
 }
 
 // JSON parsing implementations
-bool GameDataManager::parseGameConfigJson(const std::string& jsonContent) {
+bool GameDataManager::parseGameConfigJson(const char* begin, const char* end) {
     try {
-        json j = json::parse(jsonContent);
-        
-        if (j.contains("version")) {
-            gameConfig.version = Version::fromString(j["version"]);
+        GameConfigReader reader;
+        if (!reader.parse(begin, end)) {
+            throw std::runtime_error(reader.getError());
         }
         
-        if (j.contains("config_name")) {
-            gameConfig.configName = j["config_name"];
+        if (reader.hasVersion) {
+            gameConfig.version = Version::fromString(reader.version);
         }
-        
-        if (j.contains("description")) {
-            gameConfig.description = j["description"];
+        if (reader.hasConfigName) {
+            gameConfig.configName = std::move(reader.configName);
         }
-        
-        if (j.contains("settings") && j["settings"].is_object()) {
-            for (auto& [key, value] : j["settings"].items()) {
-                if (value.is_string()) {
-                    gameConfig.settings[key] = value;
-                }
-            }
+        if (reader.hasDescription) {
+            gameConfig.description = std::move(reader.description);
+        }
+        for (auto& [key, value] : reader.settings) {
+            gameConfig.settings[key] = std::move(value);
         }
         
         std::cout << "Loaded game config version " << gameConfig.version.toString() << std::endl;
@@ -772,33 +1603,20 @@ bool GameDataManager::parseGameConfigJson(const std::string& jsonContent) {
     }
 }
 
-bool GameDataManager::parseMaterialsJson(const std::string& jsonContent) {
+bool GameDataManager::parseMaterialsJson(const char* begin, const char* end) {
+    ensureData();
     try {
-        json j = json::parse(jsonContent);
-        
-        if (j.contains("version")) {
-            materialsVersion = Version::fromString(j["version"]);
+        MaterialsReader reader;
+        if (!reader.parse(begin, end)) {
+            throw std::runtime_error(reader.getError());
         }
         
-        if (j.contains("materials") && j["materials"].is_array()) {
-            materials.clear();
-            
-            for (const auto& materialJson : j["materials"]) {
-                MaterialData material;
-                material.name = materialJson["name"];
-                material.rarity = materialJson["rarity"];
-                material.type = static_cast<CardType>(materialJson["type"]);
-                material.baseQuantity = materialJson.value("base_quantity", 1);
-                
-                if (materialJson.contains("attributes") && materialJson["attributes"].is_object()) {
-                    for (auto& [key, value] : materialJson["attributes"].items()) {
-                        int attrType = std::stoi(key);
-                        material.attributes[static_cast<AttributeType>(attrType)] = value;
-                    }
-                }
-                
-                materials.push_back(material);
-            }
+        if (reader.hasVersion) {
+            materialsVersion = Version::fromString(reader.version);
+        }
+        if (reader.hasMaterials) {
+            materials = std::move(reader.materials);
+            rebuildMaterialIndex();
         }
         
         std::cout << "Loaded " << materials.size() << " materials (version " << 
@@ -810,37 +1628,20 @@ bool GameDataManager::parseMaterialsJson(const std::string& jsonContent) {
     }
 }
 
-bool GameDataManager::parseRecipesJson(const std::string& jsonContent) {
+bool GameDataManager::parseRecipesJson(const char* begin, const char* end) {
+    ensureData();
     try {
-        json j = json::parse(jsonContent);
-        
-        if (j.contains("version")) {
-            recipesVersion = Version::fromString(j["version"]);
+        RecipesReader reader;
+        if (!reader.parse(begin, end)) {
+            throw std::runtime_error(reader.getError());
         }
         
-        if (j.contains("recipes") && j["recipes"].is_array()) {
-            recipes.clear();
-            
-            for (const auto& recipeJson : j["recipes"]) {
-                RecipeData recipe;
-                recipe.id = recipeJson["id"];
-                recipe.name = recipeJson["name"];
-                recipe.description = recipeJson["description"];
-                recipe.resultMaterial = recipeJson["result_material"];
-                recipe.successRate = recipeJson["success_rate"];
-                recipe.unlockLevel = recipeJson.value("unlock_level", 0);
-                recipe.isUnlocked = recipeJson.value("is_unlocked", true);
-                
-                if (recipeJson.contains("ingredients") && recipeJson["ingredients"].is_array()) {
-                    for (const auto& ingredient : recipeJson["ingredients"]) {
-                        std::string materialName = ingredient["material"];
-                        int quantity = ingredient["quantity"];
-                        recipe.ingredients.emplace_back(materialName, quantity);
-                    }
-                }
-                
-                recipes.push_back(recipe);
-            }
+        if (reader.hasVersion) {
+            recipesVersion = Version::fromString(reader.version);
+        }
+        if (reader.hasRecipes) {
+            recipes = std::move(reader.recipes);
+            rebuildRecipeIndex();
         }
         
         std::cout << "Loaded " << recipes.size() << " recipes (version " << 
@@ -852,48 +1653,21 @@ bool GameDataManager::parseRecipesJson(const std::string& jsonContent) {
     }
 }
 
-bool GameDataManager::parseEventsJson(const std::string& jsonContent) {
+bool GameDataManager::parseEventsJson(const char* begin, const char* end) {
+    ensureData();
     try {
-        json j = json::parse(jsonContent);
-        
-        if (j.contains("version")) {
-            eventsVersion = Version::fromString(j["version"]);
+        EventsReader reader;
+        if (!reader.parse(begin, end)) {
+            throw std::runtime_error(reader.getError());
         }
         
-        if (j.contains("events") && j["events"].is_array()) {
-            events.clear();
-            
-            for (const auto& eventJson : j["events"]) {
-                EventData event;
-                event.id = eventJson.value("id", "");
-                event.name = eventJson["name"];
-                event.description = eventJson["description"];
-                event.type = eventJson.value("type", "");
-                event.triggerCondition = eventJson.value("trigger_condition", "");
-                event.isActive = eventJson.value("is_active", true);
-                event.probability = eventJson["probability"];
-                
-                if (eventJson.contains("effects") && eventJson["effects"].is_array()) {
-                    for (const auto& effect : eventJson["effects"]) {
-                        event.effects.push_back(effect);
-                    }
-                }
-                
-                if (eventJson.contains("reward_materials") && eventJson["reward_materials"].is_array()) {
-                    for (const auto& reward : eventJson["reward_materials"]) {
-                        event.rewardMaterials.push_back(reward);
-                    }
-                }
-                
-                if (eventJson.contains("penalty_materials") && eventJson["penalty_materials"].is_array()) {
-                    for (const auto& penalty : eventJson["penalty_materials"]) {
-                        event.penaltyMaterials.push_back(penalty);
-                    }
-                }
-                
-                events.push_back(event);
-            }
+        if (reader.hasVersion) {
+            eventsVersion = Version::fromString(reader.version);
+        }
+        if (reader.hasEvents) {
+            events = std::move(reader.events);
         }
+        lootTables = std::move(reader.lootTables);
         
         std::cout << "Loaded " << events.size() << " events (version " << 
                      eventsVersion.toString() << ")" << std::endl;
@@ -916,6 +1690,7 @@ std::string GameDataManager::generateGameConfigJson() const {
 }
 
 std::string GameDataManager::generateMaterialsJson() const {
+    ensureData();
     json j;
     j["version"] = gameConfig.version.toString();
     j["materials"] = json::array();
@@ -940,6 +1715,7 @@ std::string GameDataManager::generateMaterialsJson() const {
 }
 
 std::string GameDataManager::generateRecipesJson() const {
+    ensureData();
     json j;
     j["version"] = gameConfig.version.toString();
     j["recipes"] = json::array();
@@ -970,6 +1746,7 @@ std::string GameDataManager::generateRecipesJson() const {
 }
 
 std::string GameDataManager::generateEventsJson() const {
+    ensureData();
     json j;
     j["version"] = gameConfig.version.toString();
     j["events"] = json::array();
@@ -986,27 +1763,30 @@ std::string GameDataManager::generateEventsJson() const {
         eventJson["probability"] = event.probability;
         eventJson["reward_materials"] = event.rewardMaterials;
         eventJson["penalty_materials"] = event.penaltyMaterials;
+        if (!event.rewards.empty()) {
+            eventJson["rewards"] = lootEntriesToJson(event.rewards);
+        }
+        if (!event.penalties.empty()) {
+            eventJson["penalties"] = lootEntriesToJson(event.penalties);
+        }
         
         j["events"].push_back(eventJson);
     }
     
-    return j.dump(4);
-}
-
-// File I/O helper implementations
-bool GameDataManager::readFileContent(const std::string& filePath, std::string& content) const {
-    std::ifstream file(filePath);
-    if (!file.is_open()) {
-        return false;
+    if (!lootTables.empty()) {
+        j["loot_tables"] = json::array();
+        for (const auto& table : lootTables) {
+            json tableJson;
+            tableJson["id"] = table.id;
+            tableJson["entries"] = lootEntriesToJson(table.entries);
+            j["loot_tables"].push_back(tableJson);
+        }
     }
     
-    std::ostringstream buffer;
-    buffer << file.rdbuf();
-    content = buffer.str();
-    
-    return true;
+    return j.dump(4);
 }
 
+// File I/O helper implementations
 bool GameDataManager::writeFileContent(const std::string& filePath, const std::string& content) const {
     std::ofstream file(filePath);
     if (!file.is_open()) {
@@ -0,0 +1,745 @@
+#include "Systems/DataPack.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <type_traits>
+#include <unordered_map>
+
+using namespace DataManagement;
+
+namespace {
+
+constexpr char MAGIC[8] = {'S', 'V', 'D', 'P', 'A', 'C', 'K', '\0'};
+constexpr uint32_t BYTE_ORDER_MARK = 0x01020304;
+constexpr uint32_t NIL = UINT32_MAX;
+constexpr size_t ALIGNMENT = 8;
+constexpr size_t SOURCE_COUNT = 4;
+
+enum SectionId {
+    STRINGS,            // Raw characters
+    STRING_LISTS,       // Str entries for event effects and legacy material lists
+    SETTINGS,
+    MATERIALS,
+    ATTRIBUTES,
+    RECIPES,
+    INGREDIENTS,
+    EVENTS,
+    LOOT_ENTRIES,       // Event rewards and penalties, then table entries
+    LOOT_TABLES,
+    MATERIAL_INDEX,
+    RECIPE_INDEX,
+    SECTION_COUNT
+};
+
+// A string in the STRINGS section
+struct Str {
+    uint32_t offset;
+    uint32_t length;
+};
+
+// A run of records in another section
+struct Range {
+    uint32_t begin;
+    uint32_t count;
+};
+
+struct VersionRecord {
+    int32_t major;
+    int32_t minor;
+    int32_t patch;
+};
+
+struct SettingRecord {
+    Str key;
+    Str value;
+};
+
+struct MaterialRecord {
+    Str name;
+    int32_t rarity;
+    int32_t type;
+    int32_t baseQuantity;
+    Range attributes;
+};
+
+struct AttributeRecord {
+    int32_t type;
+    float value;
+};
+
+struct RecipeRecord {
+    Str id;
+    Str name;
+    Str description;
+    Str resultMaterial;
+    float successRate;
+    int32_t unlockLevel;
+    uint32_t unlocked;
+    Range ingredients;
+};
+
+struct IngredientRecord {
+    Str material;
+    int32_t quantity;
+};
+
+struct EventRecord {
+    Str id;
+    Str name;
+    Str description;
+    Str type;
+    Str triggerCondition;
+    uint32_t active;
+    float probability;
+    Range effects;              // STRING_LISTS
+    Range rewardMaterials;      // STRING_LISTS
+    Range penaltyMaterials;     // STRING_LISTS
+    Range rewards;              // LOOT_ENTRIES
+    Range penalties;            // LOOT_ENTRIES
+};
+
+struct LootEntryRecord {
+    Str material;
+    int32_t rarity;
+    Str table;
+    Str event;
+    float weight;
+    int32_t minQuantity;
+    int32_t maxQuantity;
+    Str requiresMaterial;
+    int32_t requiresCount;
+};
+
+struct LootTableRecord {
+    Str id;
+    Range entries;
+};
+
+// Open addressing with linear probing; index is NIL in empty slots
+struct IndexSlot {
+    uint64_t hash;
+    uint32_t index;
+    uint32_t reserved;
+};
+
+struct SectionRecord {
+    uint64_t offset;
+    uint64_t count;
+};
+
+const size_t SECTION_RECORD_SIZE[SECTION_COUNT] = {
+    1,
+    sizeof(Str),
+    sizeof(SettingRecord),
+    sizeof(MaterialRecord),
+    sizeof(AttributeRecord),
+    sizeof(RecipeRecord),
+    sizeof(IngredientRecord),
+    sizeof(EventRecord),
+    sizeof(LootEntryRecord),
+    sizeof(LootTableRecord),
+    sizeof(IndexSlot),
+    sizeof(IndexSlot),
+};
+
+uint64_t fnv1a(const void* data, size_t length, uint64_t hash = 14695981039346656037ull) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < length; ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+uint64_t materialKey(std::string_view name, int rarity) {
+    uint64_t hash = fnv1a(name.data(), name.size());
+    return hash ^ (static_cast<uint64_t>(static_cast<uint32_t>(rarity)) * 0x9E3779B97F4A7C15ull);
+}
+
+uint64_t recipeKey(std::string_view id) {
+    return fnv1a(id.data(), id.size());
+}
+
+size_t indexCapacity(size_t count) {
+    // At most half full, so probe runs stay short
+    size_t capacity = 1;
+    while (capacity < count * 2) {
+        capacity <<= 1;
+    }
+    return count == 0 ? 0 : capacity;
+}
+
+/**
+ * Builds the sections in memory; strings are stored once however often
+ * they are referenced
+ */
+class PackBuilder {
+public:
+    std::vector<char> strings;
+    std::vector<Str> stringLists;
+    std::vector<SettingRecord> settings;
+    std::vector<MaterialRecord> materials;
+    std::vector<AttributeRecord> attributes;
+    std::vector<RecipeRecord> recipes;
+    std::vector<IngredientRecord> ingredients;
+    std::vector<EventRecord> events;
+    std::vector<LootEntryRecord> lootEntries;
+    std::vector<LootTableRecord> lootTables;
+    std::vector<IndexSlot> materialIndex;
+    std::vector<IndexSlot> recipeIndex;
+
+    Str intern(const std::string& value) {
+        auto it = stringOffsets.find(value);
+        if (it != stringOffsets.end()) {
+            return it->second;
+        }
+        Str str{static_cast<uint32_t>(strings.size()), static_cast<uint32_t>(value.size())};
+        strings.insert(strings.end(), value.begin(), value.end());
+        stringOffsets.emplace(value, str);
+        return str;
+    }
+
+    Range addStringList(const std::vector<std::string>& values) {
+        Range range{static_cast<uint32_t>(stringLists.size()), static_cast<uint32_t>(values.size())};
+        for (const auto& value : values) {
+            stringLists.push_back(intern(value));
+        }
+        return range;
+    }
+
+    Range addLootEntries(const std::vector<LootEntryData>& entries) {
+        Range range{static_cast<uint32_t>(lootEntries.size()), static_cast<uint32_t>(entries.size())};
+        for (const auto& entry : entries) {
+            lootEntries.push_back({intern(entry.material), entry.rarity, intern(entry.table), intern(entry.event),
+                                   entry.weight, entry.minQuantity, entry.maxQuantity,
+                                   intern(entry.requiresMaterial), entry.requiresCount});
+        }
+        return range;
+    }
+
+    // Inserts key -> index unless the key is already present (first one wins)
+    template <typename SameKey>
+    static void insert(std::vector<IndexSlot>& table, uint64_t hash, uint32_t index, SameKey sameKey) {
+        size_t mask = table.size() - 1;
+        for (size_t slot = hash & mask;; slot = (slot + 1) & mask) {
+            if (table[slot].index == NIL) {
+                table[slot] = {hash, index, 0};
+                return;
+            }
+            if (table[slot].hash == hash && sameKey(table[slot].index)) {
+                return;
+            }
+        }
+    }
+
+private:
+    std::unordered_map<std::string, Str> stringOffsets;
+};
+
+template <typename T>
+void appendSection(std::vector<unsigned char>& out, SectionRecord& record, const std::vector<T>& items) {
+    static_assert(std::is_trivially_copyable<T>::value, "pack records must be trivially copyable");
+    out.resize((out.size() + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT, 0);
+    record.offset = out.size();
+    record.count = items.size();
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(items.data());
+    out.insert(out.end(), bytes, bytes + items.size() * sizeof(T));
+}
+
+bool readFile(const std::string& path, std::vector<char>& content) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return true;
+}
+
+Version toVersion(const VersionRecord& record) {
+    return Version(record.major, record.minor, record.patch);
+}
+
+VersionRecord fromVersion(const Version& version) {
+    return {version.major, version.minor, version.patch};
+}
+
+} // namespace
+
+struct DataPack::Header {
+    char magic[8];
+    uint32_t byteOrder;
+    uint32_t formatVersion;
+    uint64_t sourceHash;            // JSON the pack was compiled from
+    uint64_t payloadHash;           // Everything after the header
+    SourceStamp sources[SOURCE_COUNT];
+    VersionRecord versions[4];      // Config, materials, recipes, events
+    Str configName;
+    Str configDescription;
+    SectionRecord sections[SECTION_COUNT];
+};
+
+const std::vector<std::string>& DataPack::sourceFiles() {
+    static const std::vector<std::string> files = {
+        "game_config.json", "materials.json", "recipes.json", "events.json"};
+    return files;
+}
+
+bool DataPack::hashSources(const std::string& dataDirectory, uint64_t& hash) {
+    hash = fnv1a(nullptr, 0);
+    std::vector<char> content;
+    for (const auto& file : sourceFiles()) {
+        if (!readFile(dataDirectory + file, content)) {
+            return false;
+        }
+        // The length keeps the boundary between files part of the hash
+        uint64_t length = content.size();
+        hash = fnv1a(&length, sizeof(length), hash);
+        hash = fnv1a(content.data(), content.size(), hash);
+    }
+    return true;
+}
+
+bool DataPack::stampSources(const std::string& dataDirectory, std::vector<SourceStamp>& stamps) {
+    stamps.clear();
+    for (const auto& file : sourceFiles()) {
+        std::error_code error;
+        std::filesystem::path path(dataDirectory + file);
+        uint64_t size = std::filesystem::file_size(path, error);
+        if (error) {
+            return false;
+        }
+        auto modified = std::filesystem::last_write_time(path, error);
+        if (error) {
+            return false;
+        }
+        stamps.push_back({size, static_cast<int64_t>(modified.time_since_epoch().count())});
+    }
+    return true;
+}
+
+bool DataPack::write(const GameDataManager& data, uint64_t sourceHash, const std::vector<SourceStamp>& stamps,
+                     const std::string& path, std::string& error) {
+    if (stamps.size() != SOURCE_COUNT) {
+        error = "expected a stamp for each of the " + std::to_string(SOURCE_COUNT) + " source files";
+        return false;
+    }
+    PackBuilder pack;
+    const GameConfig& config = data.getGameConfig();
+
+    for (const auto& setting : config.settings) {
+        pack.settings.push_back({pack.intern(setting.first), pack.intern(setting.second)});
+    }
+
+    const auto& materials = data.getMaterials();
+    pack.materials.reserve(materials.size());
+    for (const auto& material : materials) {
+        Range attributes{static_cast<uint32_t>(pack.attributes.size()), 0};
+        for (const auto& attribute : material.attributes) {
+            pack.attributes.push_back({static_cast<int32_t>(attribute.first), attribute.second});
+            attributes.count++;
+        }
+        pack.materials.push_back({pack.intern(material.name), material.rarity,
+                                  static_cast<int32_t>(material.type), material.baseQuantity, attributes});
+    }
+
+    const auto& recipes = data.getRecipes();
+    pack.recipes.reserve(recipes.size());
+    for (const auto& recipe : recipes) {
+        Range ingredients{static_cast<uint32_t>(pack.ingredients.size()),
+                          static_cast<uint32_t>(recipe.ingredients.size())};
+        for (const auto& ingredient : recipe.ingredients) {
+            pack.ingredients.push_back({pack.intern(ingredient.first), ingredient.second});
+        }
+        pack.recipes.push_back({pack.intern(recipe.id), pack.intern(recipe.name), pack.intern(recipe.description),
+                                pack.intern(recipe.resultMaterial), recipe.successRate, recipe.unlockLevel,
+                                recipe.isUnlocked ? 1u : 0u, ingredients});
+    }
+
+    for (const auto& event : data.getEvents()) {
+        EventRecord record{};
+        record.id = pack.intern(event.id);
+        record.name = pack.intern(event.name);
+        record.description = pack.intern(event.description);
+        record.type = pack.intern(event.type);
+        record.triggerCondition = pack.intern(event.triggerCondition);
+        record.active = event.isActive ? 1u : 0u;
+        record.probability = event.probability;
+        record.effects = pack.addStringList(event.effects);
+        record.rewardMaterials = pack.addStringList(event.rewardMaterials);
+        record.penaltyMaterials = pack.addStringList(event.penaltyMaterials);
+        record.rewards = pack.addLootEntries(event.rewards);
+        record.penalties = pack.addLootEntries(event.penalties);
+        pack.events.push_back(record);
+    }
+
+    for (const auto& table : data.getLootTables()) {
+        pack.lootTables.push_back({pack.intern(table.id), pack.addLootEntries(table.entries)});
+    }
+
+    pack.materialIndex.assign(indexCapacity(materials.size()), IndexSlot{0, NIL, 0});
+    for (size_t i = 0; i < materials.size(); ++i) {
+        PackBuilder::insert(pack.materialIndex, materialKey(materials[i].name, materials[i].rarity),
+                            static_cast<uint32_t>(i), [&](uint32_t other) {
+                                return materials[other].name == materials[i].name &&
+                                       materials[other].rarity == materials[i].rarity;
+                            });
+    }
+    pack.recipeIndex.assign(indexCapacity(recipes.size()), IndexSlot{0, NIL, 0});
+    for (size_t i = 0; i < recipes.size(); ++i) {
+        PackBuilder::insert(pack.recipeIndex, recipeKey(recipes[i].id), static_cast<uint32_t>(i),
+                            [&](uint32_t other) { return recipes[other].id == recipes[i].id; });
+    }
+
+    if (pack.strings.size() > UINT32_MAX) {
+        error = "string table exceeds 4 GiB";
+        return false;
+    }
+
+    Header header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.formatVersion = FORMAT_VERSION;
+    header.sourceHash = sourceHash;
+    std::copy(stamps.begin(), stamps.end(), header.sources);
+    header.versions[0] = fromVersion(config.version);
+    header.versions[1] = fromVersion(data.getMaterialsVersion());
+    header.versions[2] = fromVersion(data.getRecipesVersion());
+    header.versions[3] = fromVersion(data.getEventsVersion());
+    header.configName = pack.intern(config.configName);
+    header.configDescription = pack.intern(config.description);
+
+    std::vector<unsigned char> out(sizeof(Header), 0);
+    appendSection(out, header.sections[STRINGS], pack.strings);
+    appendSection(out, header.sections[STRING_LISTS], pack.stringLists);
+    appendSection(out, header.sections[SETTINGS], pack.settings);
+    appendSection(out, header.sections[MATERIALS], pack.materials);
+    appendSection(out, header.sections[ATTRIBUTES], pack.attributes);
+    appendSection(out, header.sections[RECIPES], pack.recipes);
+    appendSection(out, header.sections[INGREDIENTS], pack.ingredients);
+    appendSection(out, header.sections[EVENTS], pack.events);
+    appendSection(out, header.sections[LOOT_ENTRIES], pack.lootEntries);
+    appendSection(out, header.sections[LOOT_TABLES], pack.lootTables);
+    appendSection(out, header.sections[MATERIAL_INDEX], pack.materialIndex);
+    appendSection(out, header.sections[RECIPE_INDEX], pack.recipeIndex);
+    header.payloadHash = fnv1a(out.data() + sizeof(Header), out.size() - sizeof(Header));
+    std::memcpy(out.data(), &header, sizeof(Header));
+
+    // Replace the old pack only once the new one is complete
+    std::string tempPath = path + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.write(reinterpret_cast<const char*>(out.data()), out.size())) {
+            error = "cannot write " + tempPath;
+            return false;
+        }
+    }
+    // std::rename may refuse an existing target (Windows); this replaces it
+    std::error_code renameError;
+    std::filesystem::rename(tempPath, path, renameError);
+    if (renameError) {
+        std::error_code ignored;
+        std::filesystem::remove(tempPath, ignored);
+        error = "cannot replace " + path + ": " + renameError.message();
+        return false;
+    }
+    return true;
+}
+
+DataPack::~DataPack() {
+    close();
+}
+
+bool DataPack::open(const std::string& path, std::string& error) {
+    close();
+
+    if (!file.open(path)) {
+        error = "cannot map " + path;
+        return false;
+    }
+    if (file.size() < sizeof(Header)) {
+        file.close();
+        error = path + " is too small to be a data pack";
+        return false;
+    }
+    base = reinterpret_cast<const unsigned char*>(file.data());
+    size = file.size();
+
+    const Header& head = header();
+    if (std::memcmp(head.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        error = path + " is not a data pack";
+    } else if (head.byteOrder != BYTE_ORDER_MARK) {
+        error = path + " was compiled on a machine with another byte order";
+    } else if (head.formatVersion != FORMAT_VERSION) {
+        error = path + " has format version " + std::to_string(head.formatVersion) + ", expected " +
+                std::to_string(FORMAT_VERSION);
+    } else {
+        for (int id = 0; id < SECTION_COUNT && error.empty(); ++id) {
+            const SectionRecord& record = head.sections[id];
+            if (record.offset % ALIGNMENT != 0 || record.offset > size ||
+                record.count > (size - record.offset) / SECTION_RECORD_SIZE[id]) {
+                error = path + " has a section outside the file";
+            }
+        }
+        size_t materialSlots = sectionCount(MATERIAL_INDEX);
+        size_t recipeSlots = sectionCount(RECIPE_INDEX);
+        if ((materialSlots & (materialSlots - 1)) != 0 || (recipeSlots & (recipeSlots - 1)) != 0) {
+            error = path + " has a malformed index";
+        }
+    }
+    if (!error.empty()) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void DataPack::close() {
+    file.close();
+    base = nullptr;
+    size = 0;
+}
+
+const DataPack::Header& DataPack::header() const {
+    return *reinterpret_cast<const Header*>(base);
+}
+
+template <typename T>
+const T* DataPack::section(int id) const {
+    return reinterpret_cast<const T*>(base + header().sections[id].offset);
+}
+
+size_t DataPack::sectionCount(int id) const {
+    return isOpen() ? static_cast<size_t>(header().sections[id].count) : 0;
+}
+
+std::string_view DataPack::text(uint32_t offset, uint32_t length) const {
+    size_t available = sectionCount(STRINGS);
+    if (offset > available || length > available - offset) {
+        return std::string_view();
+    }
+    return std::string_view(section<char>(STRINGS) + offset, length);
+}
+
+bool DataPack::verify(std::string& error) const {
+    if (!isOpen()) {
+        error = "no data pack is open";
+        return false;
+    }
+    if (fnv1a(base + sizeof(Header), size - sizeof(Header)) != header().payloadHash) {
+        error = "data pack is damaged (payload hash mismatch)";
+        return false;
+    }
+    return true;
+}
+
+bool DataPack::isCurrent(const std::string& dataDirectory) const {
+    if (!isOpen()) {
+        return false;
+    }
+    std::vector<SourceStamp> stamps;
+    if (!stampSources(dataDirectory, stamps)) {
+        return false;
+    }
+    const Header& head = header();
+    bool unchanged = true;
+    for (size_t i = 0; i < SOURCE_COUNT; ++i) {
+        unchanged = unchanged && stamps[i].size == head.sources[i].size &&
+                    stamps[i].modified == head.sources[i].modified;
+    }
+    if (unchanged) {
+        return true;
+    }
+    // Touched or copied files may still hold the compiled content
+    uint64_t hash = 0;
+    return hashSources(dataDirectory, hash) && hash == head.sourceHash;
+}
+
+uint64_t DataPack::getSourceHash() const {
+    return isOpen() ? header().sourceHash : 0;
+}
+
+size_t DataPack::materialCount() const {
+    return sectionCount(MATERIALS);
+}
+
+size_t DataPack::recipeCount() const {
+    return sectionCount(RECIPES);
+}
+
+std::string_view DataPack::materialName(size_t index) const {
+    const MaterialRecord& record = section<MaterialRecord>(MATERIALS)[index];
+    return text(record.name.offset, record.name.length);
+}
+
+int DataPack::materialRarity(size_t index) const {
+    return section<MaterialRecord>(MATERIALS)[index].rarity;
+}
+
+std::string_view DataPack::recipeId(size_t index) const {
+    const RecipeRecord& record = section<RecipeRecord>(RECIPES)[index];
+    return text(record.id.offset, record.id.length);
+}
+
+int DataPack::findMaterial(std::string_view name, int rarity) const {
+    size_t capacity = sectionCount(MATERIAL_INDEX);
+    if (capacity == 0) {
+        return -1;
+    }
+    const IndexSlot* table = section<IndexSlot>(MATERIAL_INDEX);
+    uint64_t hash = materialKey(name, rarity);
+    for (size_t slot = hash & (capacity - 1), probes = 0; probes < capacity;
+         slot = (slot + 1) & (capacity - 1), ++probes) {
+        uint32_t index = table[slot].index;
+        if (index == NIL || index >= materialCount()) {
+            return -1;
+        }
+        if (table[slot].hash == hash && materialRarity(index) == rarity && materialName(index) == name) {
+            return static_cast<int>(index);
+        }
+    }
+    return -1;
+}
+
+int DataPack::findRecipe(std::string_view id) const {
+    size_t capacity = sectionCount(RECIPE_INDEX);
+    if (capacity == 0) {
+        return -1;
+    }
+    const IndexSlot* table = section<IndexSlot>(RECIPE_INDEX);
+    uint64_t hash = recipeKey(id);
+    for (size_t slot = hash & (capacity - 1), probes = 0; probes < capacity;
+         slot = (slot + 1) & (capacity - 1), ++probes) {
+        uint32_t index = table[slot].index;
+        if (index == NIL || index >= recipeCount()) {
+            return -1;
+        }
+        if (table[slot].hash == hash && recipeId(index) == id) {
+            return static_cast<int>(index);
+        }
+    }
+    return -1;
+}
+
+void DataPack::readConfig(GameConfig& config, Version versions[3]) const {
+    auto str = [this](const Str& value) {
+        return std::string(text(value.offset, value.length));
+    };
+    const Header& head = header();
+    config.version = toVersion(head.versions[0]);
+    config.configName = str(head.configName);
+    config.description = str(head.configDescription);
+    config.settings.clear();
+    for (size_t i = 0; i < sectionCount(SETTINGS); ++i) {
+        const SettingRecord& setting = section<SettingRecord>(SETTINGS)[i];
+        config.settings[str(setting.key)] = str(setting.value);
+    }
+    for (int i = 0; i < 3; ++i) {
+        versions[i] = toVersion(head.versions[i + 1]);
+    }
+}
+
+void DataPack::read(std::vector<MaterialData>& materials, std::vector<RecipeData>& recipes,
+                    std::vector<EventData>& events, std::vector<LootTableData>& lootTables) const {
+    auto str = [this](const Str& value) {
+        return std::string(text(value.offset, value.length));
+    };
+    // Ranges are clamped to their section, so a bad record cannot read past it
+    auto clamp = [this](const Range& range, int id) {
+        size_t count = sectionCount(id);
+        size_t begin = std::min<size_t>(range.begin, count);
+        return std::make_pair(begin, std::min<size_t>(begin + range.count, count));
+    };
+    auto strings = [&](const Range& range) {
+        std::vector<std::string> values;
+        auto bounds = clamp(range, STRING_LISTS);
+        for (size_t i = bounds.first; i < bounds.second; ++i) {
+            values.push_back(str(section<Str>(STRING_LISTS)[i]));
+        }
+        return values;
+    };
+    auto lootEntries = [&](const Range& range) {
+        std::vector<LootEntryData> entries;
+        auto bounds = clamp(range, LOOT_ENTRIES);
+        for (size_t i = bounds.first; i < bounds.second; ++i) {
+            const LootEntryRecord& record = section<LootEntryRecord>(LOOT_ENTRIES)[i];
+            LootEntryData entry;
+            entry.material = str(record.material);
+            entry.rarity = record.rarity;
+            entry.table = str(record.table);
+            entry.event = str(record.event);
+            entry.weight = record.weight;
+            entry.minQuantity = record.minQuantity;
+            entry.maxQuantity = record.maxQuantity;
+            entry.requiresMaterial = str(record.requiresMaterial);
+            entry.requiresCount = record.requiresCount;
+            entries.push_back(std::move(entry));
+        }
+        return entries;
+    };
+
+    materials.clear();
+    materials.reserve(materialCount());
+    for (size_t i = 0; i < materialCount(); ++i) {
+        const MaterialRecord& record = section<MaterialRecord>(MATERIALS)[i];
+        MaterialData material;
+        material.name = str(record.name);
+        material.rarity = record.rarity;
+        material.type = static_cast<CardType>(record.type);
+        material.baseQuantity = record.baseQuantity;
+        auto bounds = clamp(record.attributes, ATTRIBUTES);
+        for (size_t a = bounds.first; a < bounds.second; ++a) {
+            const AttributeRecord& attribute = section<AttributeRecord>(ATTRIBUTES)[a];
+            material.attributes[static_cast<AttributeType>(attribute.type)] = attribute.value;
+        }
+        materials.push_back(std::move(material));
+    }
+
+    recipes.clear();
+    recipes.reserve(recipeCount());
+    for (size_t i = 0; i < recipeCount(); ++i) {
+        const RecipeRecord& record = section<RecipeRecord>(RECIPES)[i];
+        RecipeData recipe;
+        recipe.id = str(record.id);
+        recipe.name = str(record.name);
+        recipe.description = str(record.description);
+        recipe.resultMaterial = str(record.resultMaterial);
+        recipe.successRate = record.successRate;
+        recipe.unlockLevel = record.unlockLevel;
+        recipe.isUnlocked = record.unlocked != 0;
+        auto bounds = clamp(record.ingredients, INGREDIENTS);
+        for (size_t n = bounds.first; n < bounds.second; ++n) {
+            const IngredientRecord& ingredient = section<IngredientRecord>(INGREDIENTS)[n];
+            recipe.ingredients.emplace_back(str(ingredient.material), ingredient.quantity);
+        }
+        recipes.push_back(std::move(recipe));
+    }
+
+    events.clear();
+    events.reserve(sectionCount(EVENTS));
+    for (size_t i = 0; i < sectionCount(EVENTS); ++i) {
+        const EventRecord& record = section<EventRecord>(EVENTS)[i];
+        EventData event;
+        event.id = str(record.id);
+        event.name = str(record.name);
+        event.description = str(record.description);
+        event.type = str(record.type);
+        event.triggerCondition = str(record.triggerCondition);
+        event.isActive = record.active != 0;
+        event.probability = record.probability;
+        event.effects = strings(record.effects);
+        event.rewardMaterials = strings(record.rewardMaterials);
+        event.penaltyMaterials = strings(record.penaltyMaterials);
+        event.rewards = lootEntries(record.rewards);
+        event.penalties = lootEntries(record.penalties);
+        events.push_back(std::move(event));
+    }
+
+    lootTables.clear();
+    lootTables.reserve(sectionCount(LOOT_TABLES));
+    for (size_t i = 0; i < sectionCount(LOOT_TABLES); ++i) {
+        const LootTableRecord& record = section<LootTableRecord>(LOOT_TABLES)[i];
+        lootTables.push_back({str(record.id), lootEntries(record.entries)});
+    }
+}
@@ -0,0 +1,85 @@
+#include "Systems/EventTriggers.h"
+#include "Core/Inventory.h"
+#include "Core/Random.h"
+
+void EventTriggers::reset(const CompiledEvents& compiled) {
+    events = &compiled;
+    triggerable.assign(compiled.eventCount(), 0);
+    pending.clear();
+    queued.assign(compiled.eventCount(), 0);
+    everything = true;
+    inventorySynced = false;
+}
+
+void EventTriggers::queue(const std::vector<uint32_t>& affected) {
+    for (uint32_t event : affected) {
+        if (!queued[event]) {
+            queued[event] = 1;
+            pending.push_back(event);
+        }
+    }
+}
+
+void EventTriggers::materialChanged(MaterialId material) {
+    if (!events || everything) {
+        return;
+    }
+    scratch.clear();
+    events->eventsReadingMaterial(material, scratch);
+    queue(scratch);
+}
+
+void EventTriggers::inputChanged(CompiledEvents::Input input) {
+    if (!events || everything) {
+        return;
+    }
+    queue(events->eventsReading(input));
+}
+
+void EventTriggers::syncInventory(const Inventory& inventory, EventState& state) {
+    deltas.clear();
+    if (!inventorySynced || inventory.getInstanceId() != inventoryInstance ||
+        !inventory.changesSince(inventoryVersion, deltas)) {
+        inventoryInstance = inventory.getInstanceId();
+        inventorySynced = true;
+        // Changes after this snapshot show up in the next sync
+        InventorySnapshot snapshot = inventory.snapshot();
+        inventoryVersion = snapshot->version;
+        state.readInventory(*snapshot);
+        if (events && !everything) {
+            queue(events->eventsReadingInventory());
+        }
+        return;
+    }
+
+    for (const auto& delta : deltas) {
+        MaterialId material = delta.id.material;
+        if (material >= state.counts.size()) {
+            state.counts.resize(material + 1, 0);
+        }
+        state.counts[material] += delta.newQuantity - delta.oldQuantity;
+        materialChanged(material);
+        inventoryVersion = delta.version;
+    }
+}
+
+size_t EventTriggers::update(const EventState& state, Rng& rng) {
+    if (!events) {
+        return 0;
+    }
+    size_t checked = 0;
+    if (everything) {
+        events->canTriggerAll(state, rng, triggerable);
+        checked = events->eventCount();
+        everything = false;
+    } else {
+        queue(events->eventsReading(CompiledEvents::Input::Chance));
+        events->canTriggerSome(pending, state, rng, triggerable);
+        checked = pending.size();
+    }
+    for (uint32_t event : pending) {
+        queued[event] = 0;
+    }
+    pending.clear();
+    return checked;
+}
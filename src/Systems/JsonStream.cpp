@@ -0,0 +1,166 @@
+#include "Systems/JsonStream.h"
+
+namespace {
+const std::string NO_NAME;
+}
+
+bool JsonStreamReader::parse(const char* begin, const char* end) {
+    frames.clear();
+    error.clear();
+    try {
+        if (begin == end) {
+            return fail("empty input");
+        }
+        bool parsed = nlohmann::json::sax_parse(begin, end, this);
+        if (!parsed && error.empty()) {
+            error = "rejected input";
+        }
+        return parsed;
+    } catch (const std::exception& e) {
+        // From a conversion inside a reader callback
+        return fail(e.what());
+    }
+}
+
+const std::string& JsonStreamReader::name(size_t level) const {
+    return level >= 1 && level <= frames.size() ? frames[level - 1].name : NO_NAME;
+}
+
+bool JsonStreamReader::isArray(size_t level) const {
+    return level >= 1 && level <= frames.size() && frames[level - 1].array;
+}
+
+const std::string& JsonStreamReader::currentKey() const {
+    return frames.empty() || frames.back().array ? NO_NAME : frames.back().key;
+}
+
+bool JsonStreamReader::fail(const std::string& message) {
+    error = message;
+    return false;
+}
+
+bool JsonStreamReader::wrongType(const char* expected) {
+    const std::string& key = currentKey();
+    return fail(std::string("expected ") + expected + (key.empty() ? std::string() : " for '" + key + "'"));
+}
+
+bool JsonStreamReader::scalar(Scalar& value) {
+    return onValue(currentKey(), value);
+}
+
+bool JsonStreamReader::null() {
+    Scalar value;
+    return scalar(value);
+}
+
+bool JsonStreamReader::boolean(bool b) {
+    Scalar value;
+    value.type = Scalar::Type::Boolean;
+    value.boolean = b;
+    return scalar(value);
+}
+
+bool JsonStreamReader::number_integer(number_integer_t number) {
+    Scalar value;
+    value.type = Scalar::Type::Integer;
+    value.integer = number;
+    return scalar(value);
+}
+
+bool JsonStreamReader::number_unsigned(number_unsigned_t number) {
+    Scalar value;
+    value.type = Scalar::Type::Unsigned;
+    value.unsignedValue = number;
+    return scalar(value);
+}
+
+bool JsonStreamReader::number_float(number_float_t number, const string_t&) {
+    Scalar value;
+    value.type = Scalar::Type::Float;
+    value.number = number;
+    return scalar(value);
+}
+
+bool JsonStreamReader::string(string_t& text) {
+    Scalar value;
+    value.type = Scalar::Type::String;
+    value.text = &text;
+    return scalar(value);
+}
+
+bool JsonStreamReader::binary(binary_t&) {
+    return fail("unexpected binary value");
+}
+
+bool JsonStreamReader::start_object(std::size_t) {
+    frames.push_back({false, currentKey(), std::string()});
+    return onBeginObject();
+}
+
+bool JsonStreamReader::key(string_t& value) {
+    frames.back().key = std::move(value);
+    return true;
+}
+
+bool JsonStreamReader::end_object() {
+    bool ok = onEndObject();
+    frames.pop_back();
+    return ok;
+}
+
+bool JsonStreamReader::start_array(std::size_t) {
+    frames.push_back({true, currentKey(), std::string()});
+    return onBeginArray();
+}
+
+bool JsonStreamReader::end_array() {
+    bool ok = onEndArray();
+    frames.pop_back();
+    return ok;
+}
+
+bool JsonStreamReader::parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& ex) {
+    return fail(ex.what());
+}
+
+bool JsonStreamReader::get(Scalar& value, std::string& out) {
+    if (value.type != Scalar::Type::String) {
+        return wrongType("a string");
+    }
+    out = std::move(*value.text);
+    return true;
+}
+
+bool JsonStreamReader::get(Scalar& value, int& out) {
+    switch (value.type) {
+        case Scalar::Type::Integer: out = static_cast<int>(value.integer); return true;
+        case Scalar::Type::Unsigned: out = static_cast<int>(value.unsignedValue); return true;
+        case Scalar::Type::Float: out = static_cast<int>(value.number); return true;
+        default: return wrongType("a number");
+    }
+}
+
+bool JsonStreamReader::get(Scalar& value, float& out) {
+    switch (value.type) {
+        case Scalar::Type::Integer: out = static_cast<float>(value.integer); return true;
+        case Scalar::Type::Unsigned: out = static_cast<float>(value.unsignedValue); return true;
+        case Scalar::Type::Float: out = static_cast<float>(value.number); return true;
+        default: return wrongType("a number");
+    }
+}
+
+bool JsonStreamReader::get(Scalar& value, bool& out) {
+    if (value.type != Scalar::Type::Boolean) {
+        return wrongType("a boolean");
+    }
+    out = value.boolean;
+    return true;
+}
+
+bool JsonStreamReader::get(Scalar& value, uint64_t& out) {
+    if (value.type != Scalar::Type::Unsigned) {
+        return wrongType("an unsigned number");
+    }
+    out = value.unsignedValue;
+    return true;
+}
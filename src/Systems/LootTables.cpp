@@ -0,0 +1,426 @@
+#include "Systems/LootTables.h"
+#include "Systems/DataManager.h"
+#include "Core/Inventory.h"
+#include "Core/Random.h"
+#include <algorithm>
+#include <functional>
+
+using namespace DataManagement;
+
+namespace {
+
+// Collects a roll into a LootResult
+struct ResultEmitter {
+    LootResult& result;
+    bool any = false;
+
+    void event(uint32_t event) { result.events.push_back(event); any = true; }
+    void item(uint32_t item, int quantity, bool gain) {
+        (gain ? result.gained : result.lost).push_back({item, quantity});
+        any = true;
+    }
+};
+
+// Adds rolls up without storing them
+struct TotalsEmitter {
+    LootTotals& totals;
+    bool any = false;
+
+    void event(uint32_t event) { ++totals.events[event]; any = true; }
+    void item(uint32_t item, int quantity, bool gain) {
+        (gain ? totals.gained : totals.lost)[item] += quantity;
+        any = true;
+    }
+};
+
+}
+
+void LootTables::clear() {
+    entries.clear();
+    aliasChance.clear();
+    aliasOther.clear();
+    tables.clear();
+    tableIds.clear();
+    events.clear();
+    items.clear();
+    itemIds.clear();
+}
+
+uint32_t LootTables::addItem(const Card& card) {
+    auto result = itemIds.try_emplace(card.getId(), static_cast<uint32_t>(items.size()));
+    if (result.second) {
+        items.push_back(card);
+        items.back().quantity = 1;
+    }
+    return result.first->second;
+}
+
+void LootTables::addTable(const std::string& id, const std::vector<Entry>& tableEntries,
+                          const std::vector<float>& weights) {
+    Table table;
+    table.first = static_cast<uint32_t>(entries.size());
+    entries.insert(entries.end(), tableEntries.begin(), tableEntries.end());
+
+    float total = 0.0f;
+    for (float weight : weights) {
+        total += std::max(weight, 0.0f);
+    }
+    if (tableEntries.empty() || total <= 0.0f) {
+        // Nothing can be picked: one "nothing" slot keeps sampling branch free
+        entries.resize(table.first);
+        entries.push_back(Entry());
+        aliasChance.push_back(1.0f);
+        aliasOther.push_back(0);
+        table.size = 1;
+        tableIds[id] = static_cast<uint32_t>(tables.size());
+        tables.push_back(table);
+        return;
+    }
+    table.size = static_cast<uint32_t>(tableEntries.size());
+
+    // Vose's alias method: scale weights to mean 1, then pair every slot under 1
+    // with one over 1 that tops it up
+    const uint32_t n = table.size;
+    std::vector<float> scaled(n);
+    std::vector<uint32_t> small;
+    std::vector<uint32_t> large;
+    for (uint32_t i = 0; i < n; ++i) {
+        scaled[i] = std::max(weights[i], 0.0f) * n / total;
+        (scaled[i] < 1.0f ? small : large).push_back(i);
+    }
+    aliasChance.resize(table.first + n, 1.0f);
+    aliasOther.resize(table.first + n, 0);
+    while (!small.empty() && !large.empty()) {
+        uint32_t less = small.back();
+        uint32_t more = large.back();
+        small.pop_back();
+        aliasChance[table.first + less] = scaled[less];
+        aliasOther[table.first + less] = more;
+        scaled[more] -= 1.0f - scaled[less];
+        if (scaled[more] < 1.0f) {
+            large.pop_back();
+            small.push_back(more);
+        }
+    }
+    // Whatever is left is 1 up to rounding error and keeps its own entry
+
+    tableIds[id] = static_cast<uint32_t>(tables.size());
+    tables.push_back(table);
+}
+
+void LootTables::addExplorationTable(const std::vector<float>& probabilities) {
+    std::vector<Entry> tableEntries;
+    std::vector<float> weights;
+    float total = 0.0f;
+    for (size_t i = 0; i < probabilities.size(); ++i) {
+        if (probabilities[i] <= 0.0f) {
+            continue;
+        }
+        Entry entry;
+        entry.kind = Kind::Event;
+        entry.target = static_cast<uint32_t>(i);
+        tableEntries.push_back(entry);
+        weights.push_back(probabilities[i]);
+        total += probabilities[i];
+    }
+    if (total < 1.0f) {
+        tableEntries.push_back(Entry());
+        weights.push_back(1.0f - total);
+    }
+    addTable(EXPLORATION, tableEntries, weights);
+}
+
+void LootTables::compileEvents(const std::vector<Event>& sourceEvents) {
+    clear();
+    std::vector<float> probabilities;
+    for (const auto& event : sourceEvents) {
+        CompiledEvent compiled;
+        compiled.description = event.description;
+        for (const auto& card : event.rewards) {
+            Entry entry;
+            entry.kind = Kind::Item;
+            entry.target = addItem(card);
+            entry.minQuantity = entry.maxQuantity = card.quantity;
+            compiled.rewards.push_back(entry);
+        }
+        for (const auto& card : event.penalties) {
+            Entry entry;
+            entry.kind = Kind::Item;
+            entry.target = addItem(card);
+            entry.minQuantity = entry.maxQuantity = card.quantity;
+            compiled.penalties.push_back(entry);
+        }
+        events.push_back(compiled);
+        probabilities.push_back(event.probability);
+    }
+    addExplorationTable(probabilities);
+}
+
+ValidationResult LootTables::compile(const GameDataManager& data) {
+    clear();
+    ValidationResult result;
+
+    const auto& tableData = data.getLootTables();
+    const auto& eventData = data.getEvents();
+
+    // Tables are numbered in file order so entries can refer to later ones;
+    // the automatic exploration table, if needed, comes last
+    std::unordered_map<std::string, uint32_t> pendingTables;
+    for (const auto& table : tableData) {
+        if (!pendingTables.try_emplace(table.id, static_cast<uint32_t>(pendingTables.size())).second) {
+            result.addError("Duplicate loot table id: " + table.id);
+        }
+    }
+    std::unordered_map<std::string, uint32_t> eventIds;
+    for (size_t i = 0; i < eventData.size(); ++i) {
+        eventIds.try_emplace(eventData[i].id, static_cast<uint32_t>(i));
+    }
+
+    auto convert = [&](const LootEntryData& source, const std::string& owner, bool allowEvent) {
+        Entry entry;
+        if (!source.material.empty()) {
+            const MaterialData* material = data.findMaterial(source.material, source.rarity);
+            if (!material) {
+                result.addError("Loot in '" + owner + "' references non-existent material: " +
+                                source.material + " (rarity " + std::to_string(source.rarity) + ")");
+                return entry;
+            }
+            entry.kind = Kind::Item;
+            entry.target = addItem(material->toCard());
+        } else if (!source.table.empty()) {
+            auto it = pendingTables.find(source.table);
+            if (it == pendingTables.end()) {
+                result.addError("Loot in '" + owner + "' references non-existent table: " + source.table);
+                return entry;
+            }
+            entry.kind = Kind::Table;
+            entry.target = it->second;
+        } else if (!source.event.empty()) {
+            auto it = eventIds.find(source.event);
+            if (!allowEvent) {
+                result.addError("Loot in '" + owner + "' references an event outside a table: " + source.event);
+                return entry;
+            }
+            if (it == eventIds.end()) {
+                result.addError("Loot in '" + owner + "' references non-existent event: " + source.event);
+                return entry;
+            }
+            entry.kind = Kind::Event;
+            entry.target = it->second;
+        }
+        entry.minQuantity = std::max(source.minQuantity, 0);
+        entry.maxQuantity = std::max(source.maxQuantity, entry.minQuantity);
+        if (!source.requiresMaterial.empty()) {
+            entry.requiredMaterial = MaterialRegistry::instance().intern(source.requiresMaterial);
+            entry.requiredCount = source.requiresCount;
+        }
+        return entry;
+    };
+
+    // Legacy reward/penalty lists name a material without rarity or quantity
+    auto convertLegacy = [&](const std::vector<std::string>& names, std::vector<Entry>& out) {
+        for (const auto& name : names) {
+            const MaterialData* material = data.findMaterialByName(name);
+            if (!material) {
+                continue;  // Reported as a warning by validateDataConsistency
+            }
+            Entry entry;
+            entry.kind = Kind::Item;
+            entry.target = addItem(material->toCard());
+            out.push_back(entry);
+        }
+    };
+
+    std::vector<float> probabilities;
+    for (const auto& source : eventData) {
+        CompiledEvent compiled;
+        compiled.description = source.description;
+        if (source.rewards.empty()) {
+            convertLegacy(source.rewardMaterials, compiled.rewards);
+        }
+        for (const auto& reward : source.rewards) {
+            compiled.rewards.push_back(convert(reward, source.name, false));
+        }
+        if (source.penalties.empty()) {
+            convertLegacy(source.penaltyMaterials, compiled.penalties);
+        }
+        for (const auto& penalty : source.penalties) {
+            compiled.penalties.push_back(convert(penalty, source.name, false));
+        }
+        events.push_back(compiled);
+        probabilities.push_back(source.isActive ? source.probability : 0.0f);
+    }
+
+    for (const auto& table : tableData) {
+        if (tableIds.count(table.id)) {
+            continue;  // Duplicate, already reported
+        }
+        std::vector<Entry> tableEntries;
+        std::vector<float> weights;
+        for (const auto& source : table.entries) {
+            tableEntries.push_back(convert(source, table.id, true));
+            weights.push_back(source.weight);
+        }
+        addTable(table.id, tableEntries, weights);
+    }
+    if (!tableIds.count(EXPLORATION)) {
+        addExplorationTable(probabilities);
+    }
+
+    breakCycles(result);
+    return result;
+}
+
+void LootTables::breakCycles(ValidationResult& result) {
+    // A table reachable from itself would roll forever: depth-first search over
+    // table and event references, cutting every edge back into the current path
+    enum class Mark : uint8_t { New, Open, Done };
+    std::vector<Mark> marks(tables.size(), Mark::New);
+    std::vector<Mark> eventMarks(events.size(), Mark::New);
+    std::vector<std::string> tableNames(tables.size());
+    for (const auto& id : tableIds) {
+        tableNames[id.second] = id.first;
+    }
+    std::function<void(uint32_t)> visitTable;
+    std::function<void(std::vector<Entry>&, const std::string&)> visitEntries;
+    visitEntries = [&](std::vector<Entry>& list, const std::string& owner) {
+        for (auto& entry : list) {
+            if (entry.kind == Kind::Table) {
+                if (marks[entry.target] == Mark::Open) {
+                    result.addError("Loot table cycle through '" + tableNames[entry.target] + "' in '" + owner + "'");
+                    entry = Entry();
+                } else {
+                    visitTable(entry.target);
+                }
+            } else if (entry.kind == Kind::Event && eventMarks[entry.target] != Mark::Done) {
+                uint32_t event = entry.target;
+                if (eventMarks[event] == Mark::Open) {
+                    result.addError("Loot event '" + events[event].description + "' contains itself");
+                    entry = Entry();
+                    continue;
+                }
+                eventMarks[event] = Mark::Open;
+                visitEntries(events[event].rewards, events[event].description);
+                visitEntries(events[event].penalties, events[event].description);
+                eventMarks[event] = Mark::Done;
+            }
+        }
+    };
+    visitTable = [&](uint32_t table) {
+        if (marks[table] != Mark::New) {
+            return;
+        }
+        marks[table] = Mark::Open;
+        std::vector<Entry> list(entries.begin() + tables[table].first,
+                                entries.begin() + tables[table].first + tables[table].size);
+        visitEntries(list, tableNames[table]);
+        std::copy(list.begin(), list.end(), entries.begin() + tables[table].first);
+        marks[table] = Mark::Done;
+    };
+    for (uint32_t table = 0; table < tables.size(); ++table) {
+        visitTable(table);
+    }
+    for (auto& event : events) {
+        visitEntries(event.rewards, event.description);
+        visitEntries(event.penalties, event.description);
+    }
+}
+
+uint32_t LootTables::findTable(const std::string& id) const {
+    auto it = tableIds.find(id);
+    return it != tableIds.end() ? it->second : NONE;
+}
+
+template <typename Emit>
+void LootTables::apply(const Entry& entry, bool gain, Rng& rng, const Inventory& inventory, Emit& emit) const {
+    if (entry.kind == Kind::Nothing) {
+        return;
+    }
+    if (entry.requiredMaterial != INVALID_MATERIAL_ID &&
+        inventory.countOfAnyRarity(entry.requiredMaterial) < entry.requiredCount) {
+        return;
+    }
+    switch (entry.kind) {
+        case Kind::Item: {
+            int quantity = entry.minQuantity == entry.maxQuantity
+                ? entry.minQuantity : rng.nextInt(entry.minQuantity, entry.maxQuantity);
+            if (quantity > 0) {
+                emit.item(entry.target, quantity, gain);
+            }
+            break;
+        }
+        case Kind::Table:
+            for (int rolls = entry.minQuantity == entry.maxQuantity
+                     ? entry.minQuantity : rng.nextInt(entry.minQuantity, entry.maxQuantity);
+                 rolls > 0; --rolls) {
+                roll(entry.target, gain, rng, inventory, emit);
+            }
+            break;
+        case Kind::Event: {
+            const CompiledEvent& event = events[entry.target];
+            emit.event(entry.target);
+            for (const auto& reward : event.rewards) {
+                apply(reward, gain, rng, inventory, emit);
+            }
+            for (const auto& penalty : event.penalties) {
+                apply(penalty, !gain, rng, inventory, emit);
+            }
+            break;
+        }
+        case Kind::Nothing:
+            break;
+    }
+}
+
+template <typename Emit>
+void LootTables::roll(uint32_t table, bool gain, Rng& rng, const Inventory& inventory, Emit& emit) const {
+    const Table& t = tables[table];
+    // One draw picks both the slot (high bits) and the alias coin (low 24 bits)
+    uint64_t bits = rng();
+    uint32_t slot = static_cast<uint32_t>(((bits >> 32) * t.size) >> 32);
+    float coin = static_cast<float>(bits & 0xFFFFFF) * (1.0f / 16777216.0f);
+    uint32_t pick = coin < aliasChance[t.first + slot] ? slot : aliasOther[t.first + slot];
+    apply(entries[t.first + pick], gain, rng, inventory, emit);
+}
+
+void LootTables::sample(uint32_t table, Rng& rng, const Inventory& inventory, LootResult& result) const {
+    if (table >= tables.size()) {
+        return;
+    }
+    ResultEmitter emit{result};
+    roll(table, true, rng, inventory, emit);
+}
+
+void LootTables::sampleN(uint32_t table, size_t n, Rng& rng, const Inventory& inventory, LootTotals& totals) const {
+    if (table >= tables.size()) {
+        return;
+    }
+    totals.gained.resize(std::max(totals.gained.size(), items.size()), 0);
+    totals.lost.resize(std::max(totals.lost.size(), items.size()), 0);
+    totals.events.resize(std::max(totals.events.size(), events.size()), 0);
+    TotalsEmitter emit{totals};
+    for (size_t i = 0; i < n; ++i) {
+        emit.any = false;
+        roll(table, true, rng, inventory, emit);
+        totals.empty += !emit.any;
+    }
+    totals.rolls += n;
+}
+
+bool LootTables::apply(uint32_t table, Rng& rng, Inventory& inventory, LootResult& result) const {
+    result.clear();
+    sample(table, rng, inventory, result);
+    if (result.gained.empty() && result.lost.empty()) {
+        return true;
+    }
+    InventoryBatch batch;
+    for (const auto& drop : result.gained) {
+        Card card = items[drop.item];
+        card.quantity = drop.quantity;
+        batch.add(card);
+    }
+    for (const auto& drop : result.lost) {
+        batch.remove(items[drop.item].getId(), drop.quantity);
+    }
+    return inventory.apply(batch);
+}
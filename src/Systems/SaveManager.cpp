@@ -1,7 +1,160 @@
 #include "Systems/SaveManager.h"
+#include "Core/Random.h"
+#include "Core/MappedFile.h"
+#include "Systems/JsonStream.h"
+#include <algorithm>
 #include <iostream>
 #include <filesystem>
 
+namespace {
+
+/**
+ * Streaming reader for save files. Cards are built as their objects close;
+ * the fields of a card may come in any order, so attributes wait in the
+ * pending card until then.
+ */
+class SaveFileReader : public JsonStreamReader {
+public:
+    std::string version;
+    bool hasVersion = false;
+    bool hasInventory = false;
+    std::vector<Card> cards;
+    uint64_t rngSeed = 0;
+    bool hasRngSeed = false;
+    std::vector<Rng::State> rngStreams;      // In RngStream order
+
+protected:
+    bool onValue(const std::string& key, Scalar& value) override {
+        if (depth() == 1) {
+            if (key == "version") {
+                hasVersion = true;
+                return get(value, version);
+            }
+            if (key == "inventory") {
+                hasInventory = true;
+            } else if (key == "rngSeed" && value.type == Scalar::Type::Unsigned) {
+                hasRngSeed = true;
+                return get(value, rngSeed);
+            }
+            return true;
+        }
+        if (inCards() && depth() == 3) {
+            return fail("expected an object in 'cards'");
+        }
+        if (inRngStreams() && depth() == 2) {
+            return fail("expected an array in 'rngStreams'");
+        }
+        if (inRngStreams() && depth() == 3 && isArray(3)) {
+            if (streamWords == rngStreams.back().size()) {
+                return fail("too many words in random stream " + std::to_string(rngStreams.size() - 1));
+            }
+            return get(value, rngStreams.back()[streamWords++]);
+        }
+        if (inCard()) {
+            if (key == "name") {
+                seen |= 1;
+                return get(value, pending.name);
+            }
+            if (key == "rarity") {
+                seen |= 2;
+                return get(value, pending.rarity);
+            }
+            if (key == "quantity") {
+                seen |= 4;
+                return get(value, pending.quantity);
+            }
+            if (key == "type") {
+                return get(value, pending.type);
+            }
+            return true;
+        }
+        if (depth() == 5 && inCards() && !isArray(4) && name(5) == "attributes" && !isArray(5)) {
+            float amount;
+            if (!get(value, amount)) {
+                return false;
+            }
+            pending.attributes.emplace_back(static_cast<AttributeType>(std::stoi(key)), amount);
+        }
+        return true;
+    }
+
+    bool onBeginObject() override {
+        if (depth() == 2 && name(2) == "inventory") {
+            hasInventory = true;
+        } else if (inCard()) {
+            pending = PendingCard();
+            seen = 0;
+        } else if (inRngStreams() && depth() == 3) {
+            return fail("expected an array in 'rngStreams'");
+        }
+        return true;
+    }
+
+    bool onBeginArray() override {
+        if (depth() == 2 && name(2) == "inventory") {
+            hasInventory = true;
+        } else if (inCards() && depth() == 4) {
+            return fail("expected an object in 'cards'");
+        } else if (inRngStreams() && depth() == 3) {
+            rngStreams.emplace_back();
+            streamWords = 0;
+        }
+        return true;
+    }
+
+    bool onEndArray() override {
+        if (inRngStreams() && depth() == 3 && streamWords != rngStreams.back().size()) {
+            return fail("random stream " + std::to_string(rngStreams.size() - 1) + " is incomplete");
+        }
+        return true;
+    }
+
+    bool onEndObject() override {
+        if (!inCard()) {
+            return true;
+        }
+        static const char* const REQUIRED[] = {"name", "rarity", "quantity"};
+        for (int i = 0; i < 3; ++i) {
+            if (!(seen & (1u << i))) {
+                return fail("card " + std::to_string(cards.size()) + " is missing '" + REQUIRED[i] + "'");
+            }
+        }
+        Card card(pending.name, pending.rarity, static_cast<CardType>(pending.type), pending.quantity);
+        for (const auto& [type, amount] : pending.attributes) {
+            card.setAttribute(type, amount);
+        }
+        cards.push_back(std::move(card));
+        return true;
+    }
+
+private:
+    struct PendingCard {
+        std::string name;
+        int rarity = 0;
+        int quantity = 0;
+        int type = static_cast<int>(CardType::MISC);    // Older saves have no type
+        std::vector<std::pair<AttributeType, float>> attributes;
+    };
+
+    PendingCard pending;
+    unsigned seen = 0;
+    size_t streamWords = 0;
+
+    // At or below the "cards" array of the inventory object
+    bool inCards() const {
+        return depth() >= 3 && name(2) == "inventory" && !isArray(2) && name(3) == "cards" && isArray(3);
+    }
+    bool inCard() const {
+        return depth() == 4 && inCards() && !isArray(4);
+    }
+    // At or below the top-level "rngStreams" array of stream states
+    bool inRngStreams() const {
+        return depth() >= 2 && name(2) == "rngStreams" && isArray(2);
+    }
+};
+
+}
+
 SaveManager::SaveManager(const std::string& saveFilePath) 
     : saveFilePath(saveFilePath) {
 }
@@ -21,6 +174,14 @@ bool SaveManager::saveGame(const Inventory& inventory) {
         gameData["version"] = "1.0";
         gameData["timestamp"] = std::time(nullptr);
         gameData["inventory"] = inventoryToJson(inventory);
+        // The seed restarts every random stream; the stream states then
+        // resume each one where it was, so draws continue from the save point
+        RandomService& random = RandomService::instance();
+        gameData["rngSeed"] = random.getSeed();
+        gameData["rngStreams"] = nlohmann::json::array();
+        for (size_t i = 0; i < static_cast<size_t>(RngStream::Count); ++i) {
+            gameData["rngStreams"].push_back(random.stream(static_cast<RngStream>(i)).getState());
+        }
         
         // Write to file
         fileHandler.getStream() << gameData.dump(4); // Pretty print with 4 spaces
@@ -41,48 +202,49 @@ bool SaveManager::loadGame(Inventory& inventory) {
             return false;
         }
         
-        // Use RAII to manage file
-        FileHandler fileHandler(saveFilePath, std::ios::in);
-        
-        if (!fileHandler.isOpen()) {
+        // Mapped rather than read, and parsed without building a DOM
+        MappedFile file;
+        if (!file.open(saveFilePath)) {
             logError("Unable to open save file for reading: " + saveFilePath);
             return false;
         }
         
-        // Read file content
-        std::string fileContent;
-        std::string line;
-        while (std::getline(fileHandler.getStream(), line)) {
-            fileContent += line + "\n";
-        }
-        
-        if (fileContent.empty()) {
+        if (file.size() == 0) {
             logError("Save file is empty");
             return false;
         }
         
-        // Parse JSON
-        nlohmann::json gameData = nlohmann::json::parse(fileContent);
+        SaveFileReader reader;
+        if (!reader.parse(file.begin(), file.end())) {
+            logError("JSON parse error: " + reader.getError());
+            return false;
+        }
         
         // Check version
-        if (gameData.contains("version")) {
-            std::string version = gameData["version"];
-            std::cout << "Loaded save version: " << version << std::endl;
+        if (reader.hasVersion) {
+            std::cout << "Loaded save version: " << reader.version << std::endl;
         }
         
-        // Load inventory
-        if (gameData.contains("inventory")) {
-            jsonToInventory(gameData["inventory"], inventory);
-            std::cout << "Game successfully loaded from: " << saveFilePath << std::endl;
-            return true;
-        } else {
+        if (!reader.hasInventory) {
             logError("Save file format error: missing inventory data");
             return false;
         }
         
-    } catch (const nlohmann::json::parse_error& e) {
-        logError("JSON parse error: " + std::string(e.what()));
-        return false;
+        // Everything parsed, so replace the inventory in a single update;
+        // a bad file leaves it untouched and readers never see a partial load
+        inventory.updateCards(reader.cards);
+        if (reader.hasRngSeed) {
+            // Saves without stream states restart the streams from the seed
+            RandomService& random = RandomService::instance();
+            random.reseed(reader.rngSeed);
+            size_t count = std::min(reader.rngStreams.size(), static_cast<size_t>(RngStream::Count));
+            for (size_t i = 0; i < count; ++i) {
+                random.stream(static_cast<RngStream>(i)).setState(reader.rngStreams[i]);
+            }
+        }
+        std::cout << "Game successfully loaded from: " << saveFilePath << std::endl;
+        return true;
+        
     } catch (const std::exception& e) {
         logError("Error occurred while loading: " + std::string(e.what()));
         return false;
@@ -137,53 +299,16 @@ nlohmann::json SaveManager::inventoryToJson(const Inventory& inventory) const {
     nlohmann::json inventoryJson;
     inventoryJson["cards"] = nlohmann::json::array();
     
-    const auto& cards = inventory.getCards();
-    for (const auto& card : cards) {
+    // Snapshot so a save on a worker thread never races inventory writers;
+    // the consistent one, so the save includes the latest change
+    InventorySnapshot snapshot = inventory.consistentSnapshot();
+    for (const auto& card : snapshot->cards) {
         inventoryJson["cards"].push_back(cardToJson(card));
     }
     
     return inventoryJson;
 }
 
-Card SaveManager::jsonToCard(const nlohmann::json& cardJson) const {
-    std::string name = cardJson["name"];
-    int rarity = cardJson["rarity"];
-    int quantity = cardJson["quantity"];
-    
-    // Handle type (backward compatibility)
-    CardType type = CardType::MISC;
-    if (cardJson.contains("type")) {
-        type = static_cast<CardType>(cardJson["type"]);
-    }
-    
-    Card card(name, rarity, type, quantity);
-
-    // Load attributes (backward compatibility)
-    if (cardJson.contains("attributes") && cardJson["attributes"].is_object()) {
-        for (const auto& attr : cardJson["attributes"].items()) {
-            AttributeType attrType = static_cast<AttributeType>(std::stoi(attr.key()));
-            float value = attr.value();
-            card.setAttribute(attrType, value);
-        }
-    }
-    
-    return card;
-}
-
-void SaveManager::jsonToInventory(const nlohmann::json& json, Inventory& inventory) const {
-    // Clear existing inventory
-    std::vector<Card> emptyCards;
-    inventory.updateCards(emptyCards);
-    
-    // Load cards
-    if (json.contains("cards") && json["cards"].is_array()) {
-        for (const auto& cardJson : json["cards"]) {
-            Card card = jsonToCard(cardJson);
-            inventory.addCard(card);
-        }
-    }
-}
-
 void SaveManager::logError(const std::string& message) const {
     std::cerr << "[SaveManager Error] " << message << std::endl;
 }
@@ -68,13 +68,8 @@ void TechTreeSystem::update(float deltaTime) {
         techTreeUI->update(deltaTime);
     }
     
-    if (currentResearchTech.empty()) {
-        return;
-    }
-    
-    auto tech = techTree->getTech(currentResearchTech);
-    if (!tech || tech->status != TechStatus::RESEARCHING) {
-        currentResearchTech.clear();
+    // With a timer wheel, research advances on its own recurring timer
+    if (timers || currentResearchTech.empty()) {
         return;
     }
     
@@ -83,24 +78,50 @@ void TechTreeSystem::update(float deltaTime) {
     
     // Update research progress once per second
     if (researchTimer >= 1.0f) {
-        int progressToAdd = researchRate;
-        int newProgress = tech->currentProgress + progressToAdd;
-        
-        // Update research progress
-        if (techTree->updateResearchProgress(currentResearchTech, newProgress)) {
-            // Research completed
-            currentResearchTech.clear();
-        }
-        
-        // Update UI display
-        if (techTreeUI) {
-            techTreeUI->updateTechDisplay(tech->id);
-        }
-        
+        advanceResearch();
         researchTimer = 0.0f;
     }
 }
 
+void TechTreeSystem::setTimerWheel(TimerWheel* wheel) {
+    cancelResearchTick();
+    timers = wheel;
+    if (timers && !currentResearchTech.empty()) {
+        researchTick = timers->scheduleEvery(1.0, [this]() { advanceResearch(); });
+    }
+}
+
+void TechTreeSystem::advanceResearch() {
+    auto tech = currentResearchTech.empty() ? nullptr : techTree->getTech(currentResearchTech);
+    if (!tech || tech->status != TechStatus::RESEARCHING) {
+        currentResearchTech.clear();
+        cancelResearchTick();
+        return;
+    }
+    
+    int progressToAdd = researchRate;
+    int newProgress = tech->currentProgress + progressToAdd;
+    
+    // Update research progress
+    if (techTree->updateResearchProgress(currentResearchTech, newProgress)) {
+        // Research completed
+        currentResearchTech.clear();
+        cancelResearchTick();
+    }
+    
+    // Update UI display
+    if (techTreeUI) {
+        techTreeUI->updateTechDisplay(tech->id);
+    }
+}
+
+void TechTreeSystem::cancelResearchTick() {
+    if (timers) {
+        timers->cancel(researchTick);
+    }
+    researchTick = TimerWheel::NONE;
+}
+
 bool TechTreeSystem::startResearch(const std::string& techId) {
     if (!techTree) {
         return false;
@@ -126,6 +147,10 @@ bool TechTreeSystem::startResearch(const std::string& techId) {
     // Try to start research
     if (techTree->startResearch(techId)) {
         currentResearchTech = techId;
+        researchTimer = 0.0f;
+        if (timers) {
+            researchTick = timers->scheduleEvery(1.0, [this]() { advanceResearch(); });
+        }
         
         // Consume resources
         if (onResourceConsume) {
@@ -148,6 +173,7 @@ void TechTreeSystem::stopResearch() {
             std::cout << "Stopped researching: " << tech->name << std::endl;
         }
         currentResearchTech.clear();
+        cancelResearchTick();
     }
 }
 
@@ -363,6 +389,7 @@ void TechTreeSystem::resetTechTree() {
     if (techTree) {
         techTree->resetAllTechs();
         currentResearchTech.clear();
+        cancelResearchTick();
         researchPoints = 0;
         researchRate = 1;
         researchTimer = 0.0f;
@@ -96,3 +96,83 @@ TEST_CASE("Card edge cases and validation", "[Card]") {
         REQUIRE(complexItem.getAttribute(AttributeType::WEIGHT) == 1.5f);
     }
 }
+
+
+TEST_CASE("Card identity interning", "[Card]") {
+    auto& registry = MaterialRegistry::instance();
+
+    SECTION("Cards with the same name share a material id") {
+        Card first("Interned Ore", 1, CardType::METAL);
+        Card second("Interned Ore", 3, CardType::METAL, 5);
+        Card other("Interned Wood", 1, CardType::BUILDING);
+
+        REQUIRE(first.materialId == second.materialId);
+        REQUIRE(first.materialId != other.materialId);
+        REQUIRE(registry.getName(first.materialId) == "Interned Ore");
+        REQUIRE(registry.find("Interned Ore") == first.materialId);
+    }
+
+    SECTION("CardId combines material and rarity") {
+        Card common("Interned Herb", 1, CardType::HERB);
+        Card rare("Interned Herb", 2, CardType::HERB);
+
+        REQUIRE(common.getId() != rare.getId());
+        REQUIRE(common.getId() == Card("Interned Herb", 1, CardType::HERB, 7).getId());
+        REQUIRE(std::hash<CardId>()(common.getId()) == std::hash<CardId>()(Card("Interned Herb", 1).getId()));
+    }
+
+    SECTION("Unknown names are not registered by lookups") {
+        size_t sizeBefore = registry.size();
+        REQUIRE(registry.find("Never Interned Material") == INVALID_MATERIAL_ID);
+        REQUIRE(registry.size() == sizeBefore);
+        REQUIRE(registry.getName(INVALID_MATERIAL_ID).empty());
+    }
+}
+
+
+TEST_CASE("Card inline attribute storage", "[Card]") {
+    SECTION("Iteration yields present attributes in enum order") {
+        Card card("Storage Test", 1, CardType::TOOL);
+        card.setAttribute(AttributeType::TRADE_VALUE, 4.0f);
+        card.setAttribute(AttributeType::WEIGHT, 1.5f);
+        card.setAttribute(AttributeType::DEFENSE, 0.0f);
+
+        std::vector<std::pair<AttributeType, float>> seen;
+        for (const auto& attr : card.attributes) {
+            seen.push_back(attr);
+        }
+
+        REQUIRE(card.attributes.size() == 3);
+        REQUIRE(seen.size() == 3);
+        REQUIRE(seen[0].first == AttributeType::WEIGHT);
+        REQUIRE(seen[1].first == AttributeType::DEFENSE);
+        REQUIRE(seen[1].second == 0.0f);
+        REQUIRE(seen[2].first == AttributeType::TRADE_VALUE);
+        REQUIRE(card.hasAttribute(AttributeType::DEFENSE));
+        REQUIRE_FALSE(card.hasAttribute(AttributeType::ATTACK));
+    }
+
+    SECTION("Copies are independent") {
+        Card original("Storage Copy", 2, CardType::METAL);
+        original.setAttribute(AttributeType::DURABILITY, 10.0f);
+
+        Card copy = original;
+        copy.setAttribute(AttributeType::DURABILITY, 20.0f);
+        copy.attributes.erase(AttributeType::DURABILITY);
+
+        REQUIRE(original.getAttribute(AttributeType::DURABILITY) == 10.0f);
+        REQUIRE_FALSE(copy.hasAttribute(AttributeType::DURABILITY));
+        REQUIRE(copy.attributes.empty());
+    }
+
+    SECTION("Out-of-range attribute types are ignored") {
+        Card card("Storage Range", 1, CardType::MISC);
+        AttributeType unknown = static_cast<AttributeType>(ATTRIBUTE_TYPE_COUNT + 3);
+        card.setAttribute(unknown, 5.0f);
+        card.attributes[unknown] = 6.0f;
+
+        REQUIRE_FALSE(card.hasAttribute(unknown));
+        REQUIRE(card.getAttribute(unknown, -1.0f) == -1.0f);
+        REQUIRE(card.attributes.empty());
+    }
+}
@@ -1,7 +1,13 @@
 #include "../lib/catch2/catch.hpp"
 #include "Systems/CraftingSystem.h"
+#include "Systems/CraftingQueue.h"
+#include "Systems/CraftingPlanner.h"
+#include "Core/BaseManager.h"
 #include "Core/Inventory.h"
 #include "Core/Card.h"
+#include "Core/Random.h"
+#include "Constants.h"
+#include <random>
 
 TEST_CASE("Recipe creation and validation", "[CraftingSystem][Recipe]") {
     SECTION("Basic recipe construction") {
@@ -160,6 +166,42 @@ TEST_CASE("Crafting availability checking", "[CraftingSystem]") {
         // Should have at least one available recipe with these materials
         REQUIRE(availableRecipes.size() > 0);
     }
+    
+    SECTION("Cached craftability follows inventory changes") {
+        const auto& recipes = craftingSystem.getAllRecipes();
+        size_t wall = 0;
+        while (recipes[wall].id != "wall") ++wall;
+        
+        // Wall needs 2 Wood and 1 Metal, at any rarity
+        REQUIRE_FALSE(craftingSystem.isCraftable(wall, inventory));
+        inventory.addCard(Card("Wood", 1, CardType::BUILDING, 3));
+        inventory.addCard(Card("Wood", 2, CardType::BUILDING, 2));
+        REQUIRE_FALSE(craftingSystem.isCraftable(wall, inventory));
+        inventory.addCard(Card("Metal", 2, CardType::METAL, 4));
+        REQUIRE(craftingSystem.isCraftable(wall, inventory));
+        REQUIRE(craftingSystem.getMaxCraftCount(wall, inventory) == 2);
+        
+        InventoryBatch batch;
+        batch.remove(Card("Wood", 1, CardType::BUILDING).getId(), 3);
+        REQUIRE(inventory.apply(batch));
+        REQUIRE(craftingSystem.getMaxCraftCount(wall, inventory) == 1);
+        inventory.removeCard("Wood", 2);
+        REQUIRE_FALSE(craftingSystem.isCraftable(wall, inventory));
+        REQUIRE(craftingSystem.getMaxCraftCount(wall, inventory) == 0);
+        
+        // Locked recipes are never craftable, whatever the inventory holds
+        size_t toolbox = 0;
+        while (recipes[toolbox].id != "toolbox") ++toolbox;
+        inventory.addCard(Constants::CardFactory::createWeapon());
+        REQUIRE_FALSE(craftingSystem.isCraftable(toolbox, inventory));
+        craftingSystem.unlockRecipe("toolbox");
+        REQUIRE(craftingSystem.isCraftable(toolbox, inventory));
+        
+        // A different inventory object is recounted, not patched with stale deltas
+        Inventory other;
+        REQUIRE_FALSE(craftingSystem.isCraftable(toolbox, other));
+        REQUIRE(craftingSystem.isCraftable(toolbox, inventory));
+    }
 }
 
 TEST_CASE("Crafting execution and results", "[CraftingSystem]") {
@@ -269,6 +311,25 @@ TEST_CASE("Crafting execution and results", "[CraftingSystem]") {
         // At least one successful craft should happen with 90% success rate
         REQUIRE(craftingAttempted == true);
     }
+    
+    SECTION("Crafting draws on other rarities when the exact one runs short") {
+        // Wall needs 2 Wood (rarity 1) and 1 Metal (rarity 2)
+        inventory.addCard(Card("Wood", 1, CardType::BUILDING, 1));
+        inventory.addCard(Card("Wood", 3, CardType::BUILDING, 4));
+        inventory.addCard(Card("Metal", 2, CardType::METAL, 1));
+        
+        const Recipe* wallRecipe = craftingSystem.getRecipe("wall");
+        REQUIRE(wallRecipe != nullptr);
+        REQUIRE(craftingSystem.canCraft(*wallRecipe, inventory));
+        
+        craftingSystem.craftItem(*wallRecipe, inventory);
+        
+        // Consumed regardless of the roll: the rarity 1 stack first, then one rarity 3
+        REQUIRE(inventory.findCard("Wood", 1) == nullptr);
+        REQUIRE(inventory.findCard("Wood", 3)->quantity == 3);
+        REQUIRE(inventory.findCard("Metal", 2) == nullptr);
+        REQUIRE_FALSE(craftingSystem.canCraft(*wallRecipe, inventory));
+    }
 }
 
 TEST_CASE("CraftingSystem edge cases", "[CraftingSystem]") {
@@ -325,3 +386,346 @@ TEST_CASE("CraftingSystem edge cases", "[CraftingSystem]") {
         REQUIRE(craftResult.success == false); // Should fail because recipe not in system
     }
 }
+
+TEST_CASE("Compiled recipes", "[CraftingSystem]") {
+    MaterialId wood = MaterialRegistry::instance().intern("Wood");
+    MaterialId metal = MaterialRegistry::instance().intern("Metal");
+    std::vector<Recipe> recipes = {
+        Recipe("fence", "Fence", "", {{Card("Wood", 1, CardType::BUILDING), 2},
+                                      {Card("Wood", 2, CardType::BUILDING), 1},
+                                      {Card("Metal", 2, CardType::METAL), 0}},
+               Card("Fence", 1, CardType::BUILDING)),
+        Recipe("nails", "Nails", "", {{Card("Metal", 2, CardType::METAL), 2}},
+               Card("Nails", 1, CardType::TOOL))
+    };
+    CompiledRecipes compiled;
+    compiled.compile(recipes);
+    
+    SECTION("Repeated materials are merged and zero quantities dropped") {
+        REQUIRE(compiled.recipeCount() == 2);
+        REQUIRE(compiled.endNeed(0) - compiled.firstNeed(0) == 1);
+        REQUIRE(compiled.needMaterialAt(compiled.firstNeed(0)) == wood);
+        REQUIRE(compiled.needQuantityAt(compiled.firstNeed(0)) == 3);
+        REQUIRE(compiled.needRarityAt(compiled.firstNeed(0)) == 1);
+        REQUIRE(compiled.materialSlots() > std::max(wood, metal));
+        REQUIRE(compiled.recipesUsingEnd(metal) - compiled.recipesUsingBegin(metal) == 1);
+        REQUIRE(*compiled.recipesUsingBegin(metal) == 1);
+    }
+    
+    SECTION("Bulk evaluation matches per-recipe evaluation") {
+        std::vector<int32_t> counts(compiled.materialSlots(), 0);
+        counts[wood] = 7;
+        counts[metal] = 1;
+        
+        std::vector<uint8_t> craftable;
+        std::vector<int32_t> maxCrafts;
+        compiled.canCraftAll(counts, craftable);
+        compiled.maxCraftsAll(counts, maxCrafts);
+        REQUIRE(craftable == std::vector<uint8_t>{1, 0});
+        REQUIRE(maxCrafts == std::vector<int32_t>{2, 0});
+        for (size_t i = 0; i < compiled.recipeCount(); ++i) {
+            REQUIRE(compiled.canCraft(i, counts) == (craftable[i] != 0));
+            REQUIRE(compiled.maxCrafts(i, counts) == maxCrafts[i]);
+        }
+        
+        std::vector<uint32_t> bottlenecks;
+        compiled.maxCraftsAll(counts, maxCrafts, bottlenecks);
+        REQUIRE(maxCrafts == std::vector<int32_t>{2, 0});
+        for (size_t i = 0; i < compiled.recipeCount(); ++i) {
+            REQUIRE(compiled.bottleneckNeed(i, counts) == bottlenecks[i]);
+        }
+        REQUIRE(compiled.needMaterialAt(bottlenecks[1]) == metal);
+    }
+}
+
+TEST_CASE("Max craft counts and bottlenecks", "[CraftingSystem]") {
+    CraftingSystem craftingSystem;
+    craftingSystem.clearRecipes();
+    Inventory inventory;
+    const Card wood("Wood", 1, CardType::BUILDING);
+    const Card metal("Metal", 1, CardType::METAL);
+    const Card cloth("Cloth", 1, CardType::MISC);
+    craftingSystem.addRecipe(Recipe("cart", "Cart", "", {{wood, 2}, {metal, 3}}, Card("Cart", 1, CardType::MISC)));
+    craftingSystem.addRecipe(Recipe("tent", "Tent", "", {{wood, 1}, {cloth, 4}}, Card("Tent", 1, CardType::MISC)));
+    craftingSystem.addRecipe(Recipe("gift", "Gift", "", {}, Card("Gift", 1, CardType::MISC)));
+    
+    SECTION("The least covered ingredient limits the count") {
+        REQUIRE(craftingSystem.getMaxCraftCount(0, inventory) == 0);
+        REQUIRE(craftingSystem.getBottleneckMaterial(0, inventory) == wood.materialId);
+        REQUIRE(craftingSystem.getBottleneckMaterial(2, inventory) == INVALID_MATERIAL_ID);
+        
+        inventory.addCard(Card("Wood", 1, CardType::BUILDING, 7));
+        inventory.addCard(Card("Metal", 2, CardType::METAL, 5));
+        REQUIRE(craftingSystem.getMaxCraftCount(0, inventory) == 1);
+        REQUIRE(craftingSystem.getBottleneckMaterial(0, inventory) == metal.materialId);
+        REQUIRE(craftingSystem.getBottleneckMaterial(1, inventory) == cloth.materialId);
+        
+        // Lifting the bottleneck moves it to the next tightest ingredient
+        inventory.addCard(Card("Metal", 1, CardType::METAL, 10));
+        REQUIRE(craftingSystem.getMaxCraftCount(0, inventory) == 3);
+        REQUIRE(craftingSystem.getBottleneckMaterial(0, inventory) == wood.materialId);
+    }
+    
+    SECTION("Incremental updates match a full recount") {
+        std::mt19937 gen(7);
+        std::uniform_int_distribution<int> pick(0, 2);
+        std::uniform_int_distribution<int> amount(1, 5);
+        const Card materials[] = {wood, metal, cloth};
+        std::vector<int32_t> counts;
+        std::vector<int32_t> expectedCrafts;
+        std::vector<uint32_t> expectedNeeds;
+        CompiledRecipes compiled;
+        compiled.compile(craftingSystem.getAllRecipes());
+        
+        for (int step = 0; step < 200; ++step) {
+            Card card = materials[pick(gen)];
+            card.quantity = amount(gen);
+            if (pick(gen) == 0) {
+                InventoryBatch batch;
+                batch.remove(card.getId(), card.quantity);
+                inventory.apply(batch);  // Refused when short; counts stay as they were
+            } else {
+                inventory.addCard(card);
+            }
+            
+            counts.assign(compiled.materialSlots(), 0);
+            for (const auto& stack : inventory.getCards()) {
+                if (stack.materialId < counts.size()) counts[stack.materialId] += stack.quantity;
+            }
+            compiled.maxCraftsAll(counts, expectedCrafts, expectedNeeds);
+            for (size_t r = 0; r < 2; ++r) {
+                REQUIRE(craftingSystem.getMaxCraftCount(r, inventory) == expectedCrafts[r]);
+                REQUIRE(craftingSystem.getBottleneckMaterial(r, inventory) ==
+                        compiled.needMaterialAt(expectedNeeds[r]));
+            }
+        }
+    }
+}
+
+TEST_CASE("Crafting queue", "[CraftingSystem]") {
+    CraftingSystem craftingSystem;
+    Inventory inventory;
+    BaseManager baseManager;
+    craftingSystem.addRecipe(Recipe("plank", "Plank", "Cut wood",
+                                    {{Card("Wood", 1, CardType::BUILDING), 2}},
+                                    Card("Plank", 1, CardType::BUILDING), 1.0f));
+    inventory.addCard(Card("Wood", 1, CardType::BUILDING, 5));
+    inventory.addCard(Card("Wood", 2, CardType::BUILDING, 2));
+    CraftingQueue queue(craftingSystem, inventory, &baseManager);
+    const CardId plank = Card("Plank", 1, CardType::BUILDING).getId();
+    
+    SECTION("Materials for the whole job are reserved at once") {
+        uint64_t before = inventory.getVersion();
+        REQUIRE(queue.enqueue("plank", 3) != 0);
+        REQUIRE(inventory.getVersion() == before + 1);
+        REQUIRE(inventory.countOfAnyRarity("Wood") == 1);
+        
+        REQUIRE(queue.enqueue("plank", 1) == 0);
+        REQUIRE(queue.enqueue("missing_recipe", 1) == 0);
+        REQUIRE(queue.getJobs().size() == 1);
+    }
+    
+    SECTION("Items complete over simulated time") {
+        uint32_t job = queue.enqueue("plank", 3);
+        float lastProgress = 0.0f;
+        int itemsDone = 0;
+        int jobsDone = 0;
+        queue.setOnProgress([&](const CraftingJob&, float progress) { lastProgress = progress; });
+        queue.setOnItemCompleted([&](const CraftingJob&, bool success) { itemsDone += success; });
+        queue.setOnJobFinished([&](const CraftingJob& finished) {
+            ++jobsDone;
+            REQUIRE(finished.succeeded == 3);
+        });
+        
+        queue.update(Constants::CRAFT_TIME_SECONDS * 0.5f);
+        REQUIRE(lastProgress == Approx(0.5f));
+        REQUIRE(inventory.countOf(plank) == 0);
+        REQUIRE(queue.getJob(job)->started == 1);
+        
+        queue.update(Constants::CRAFT_TIME_SECONDS * 0.5f);
+        REQUIRE(inventory.countOf(plank) == 1);
+        
+        // A long frame finishes several items, and the results arrive in one change
+        uint64_t before = inventory.getVersion();
+        queue.update(Constants::CRAFT_TIME_SECONDS * 2.0f);
+        REQUIRE(inventory.getVersion() == before + 1);
+        REQUIRE(inventory.countOf(plank) == 3);
+        REQUIRE(itemsDone == 3);
+        REQUIRE(jobsDone == 1);
+        REQUIRE(queue.isIdle());
+    }
+    
+    SECTION("Each operational workshop adds a station") {
+        REQUIRE(queue.getStationCount() == 1);
+        inventory.addCard(Constants::CardFactory::createMetal());
+        REQUIRE(baseManager.placeBuilding(2, 2, "Metal", inventory));
+        REQUIRE(queue.getStationCount() == 2);
+        
+        queue.enqueue("plank", 3);
+        queue.update(Constants::CRAFT_TIME_SECONDS);
+        REQUIRE(inventory.countOf(plank) == 2);
+    }
+    
+    SECTION("Cancelling returns the materials of unfinished items") {
+        uint32_t job = queue.enqueue("plank", 3);
+        queue.update(Constants::CRAFT_TIME_SECONDS);
+        REQUIRE(inventory.countOf(plank) == 1);
+        
+        // The finished item used two rarity 1 Wood; the rest comes back as it was taken
+        REQUIRE(queue.cancel(job));
+        REQUIRE(inventory.countOf(Card("Wood", 1, CardType::BUILDING).getId()) == 3);
+        REQUIRE(inventory.countOf(Card("Wood", 2, CardType::BUILDING).getId()) == 2);
+        REQUIRE_FALSE(queue.cancel(job));
+        REQUIRE(queue.isIdle());
+    }
+}
+
+TEST_CASE("Seeded random streams", "[CraftingSystem]") {
+    RandomService& random = RandomService::instance();
+    CraftingSystem craftingSystem;
+    craftingSystem.clearRecipes();
+    const Recipe coinFlip("flip", "Flip", "", {{Card("Wood", 1, CardType::BUILDING), 1}},
+                          Card("Plank", 1, CardType::BUILDING), 0.5f);
+    craftingSystem.addRecipe(coinFlip);
+
+    auto craftRun = [&]() {
+        Inventory inventory;
+        inventory.addCard(Card("Wood", 1, CardType::BUILDING, 40));
+        std::vector<bool> outcomes;
+        for (int i = 0; i < 40; ++i) {
+            outcomes.push_back(craftingSystem.craftItem(coinFlip, inventory).success);
+        }
+        return outcomes;
+    };
+
+    SECTION("The same seed replays the same crafts") {
+        random.reseed(1234);
+        std::vector<bool> first = craftRun();
+        random.reseed(1234);
+        REQUIRE(craftRun() == first);
+        random.reseed(4321);
+        REQUIRE(craftRun() != first);
+    }
+
+    SECTION("Draws in one stream leave the others untouched") {
+        random.reseed(99);
+        float exploration = random.stream(RngStream::Exploration).nextFloat();
+        random.reseed(99);
+        craftRun();
+        REQUIRE(random.stream(RngStream::Exploration).nextFloat() == exploration);
+    }
+
+    SECTION("Worker generators are reproducible and independent") {
+        random.reseed(7);
+        Rng a = random.forThread(RngStream::Inventory, 0);
+        Rng b = random.forThread(RngStream::Inventory, 0);
+        Rng other = random.forThread(RngStream::Inventory, 1);
+        uint64_t first = a();
+        REQUIRE(b() == first);
+        REQUIRE(other() != first);
+
+        // A reseed to the same seed still tells workers to derive again
+        uint64_t generation = random.getGeneration();
+        random.reseed(7);
+        REQUIRE(random.getGeneration() != generation);
+        REQUIRE(random.forThread(RngStream::Inventory, 0)() == first);
+    }
+
+    SECTION("Helpers stay in range") {
+        Rng rng(5);
+        for (int i = 0; i < 1000; ++i) {
+            float f = rng.nextFloat();
+            REQUIRE(f >= 0.0f);
+            REQUIRE(f < 1.0f);
+            int n = rng.nextInt(-2, 3);
+            REQUIRE(n >= -2);
+            REQUIRE(n <= 3);
+        }
+        REQUIRE(rng.nextInt(4, 4) == 4);
+    }
+}
+
+TEST_CASE("Crafting planner", "[CraftingSystem]") {
+    CraftingSystem craftingSystem;
+    craftingSystem.clearRecipes();
+    Inventory inventory;
+    const Card wood("Wood", 1, CardType::BUILDING);
+    const Card iron("Iron", 1, CardType::METAL);
+    const Card plank("Plank", 1, CardType::BUILDING);
+    const Card nail("Nail", 1, CardType::METAL);
+    craftingSystem.addRecipe(Recipe("plank", "Plank", "Cut wood", {{wood, 2}}, plank, 1.0f));
+    craftingSystem.addRecipe(Recipe("nails", "Nails", "Forge nails", {{iron, 1}}, Card("Nail", 1, CardType::METAL, 2), 1.0f));
+    craftingSystem.addRecipe(Recipe("crate", "Crate", "Nail planks together",
+                                    {{plank, 3}, {nail, 2}}, Card("Crate", 1, CardType::MISC), 1.0f));
+    // Closes a cycle: crates can be broken back down into planks
+    craftingSystem.addRecipe(Recipe("salvage", "Salvage", "Break a crate",
+                                    {{Card("Crate", 1, CardType::MISC), 1}}, Card("Plank", 1, CardType::BUILDING, 2), 1.0f));
+    CraftingPlanner planner(craftingSystem);
+    
+    auto crafts = [](const CraftingPlan& plan, const std::string& recipeId) {
+        for (const auto& step : plan.steps) {
+            if (step.recipeId == recipeId) {
+                return step.crafts;
+            }
+        }
+        return 0;
+    };
+    
+    SECTION("Intermediate recipes are expanded down to raw materials") {
+        const CraftingPlan& plan = planner.plan("crate", 1, inventory);
+        REQUIRE_FALSE(plan.feasible);
+        REQUIRE(crafts(plan, "plank") == 3);
+        REQUIRE(crafts(plan, "nails") == 1);
+        REQUIRE(crafts(plan, "salvage") == 0);
+        REQUIRE(plan.steps.back().recipeId == "crate");
+        REQUIRE(plan.missing.size() == 2);
+        
+        inventory.addCard(Card("Wood", 1, CardType::BUILDING, 6));
+        inventory.addCard(iron);
+        const CraftingPlan& ready = planner.plan("crate", 1, inventory);
+        REQUIRE(ready.feasible);
+        REQUIRE(ready.missing.empty());
+        REQUIRE(ready.totalCrafts == 5);
+    }
+    
+    SECTION("Stock is used before crafting") {
+        inventory.addCard(Card("Plank", 2, CardType::BUILDING, 2));
+        inventory.addCard(Card("Nail", 1, CardType::METAL, 2));
+        inventory.addCard(Card("Wood", 1, CardType::BUILDING, 2));
+        const CraftingPlan& plan = planner.plan("crate", 1, inventory);
+        REQUIRE(plan.feasible);
+        REQUIRE(crafts(plan, "plank") == 1);
+        REQUIRE(crafts(plan, "nails") == 0);
+        REQUIRE(plan.totalCrafts == 2);
+    }
+    
+    SECTION("Costs follow the cheapest recipe and ignore the cycle") {
+        REQUIRE(planner.unitCost(wood.materialId) == Approx(1.0f));
+        REQUIRE(planner.unitCost(plank.materialId) == Approx(3.0f));
+        REQUIRE(planner.unitCost(nail.materialId) == Approx(1.0f));
+        REQUIRE(planner.unitCost(Card("Crate", 1, CardType::MISC).materialId) == Approx(12.0f));
+    }
+    
+    SECTION("Locked recipes are neither planned nor used as producers") {
+        craftingSystem.addRecipe(Recipe("log", "Log", "Grow a log", {}, wood, 1.0f, 1, false));
+        craftingSystem.addRecipe(Recipe("box", "Box", "Plank box", {{plank, 4}}, Card("Box", 1, CardType::MISC), 1.0f, 1, false));
+        const CraftingPlan& box = planner.plan("box", 1, inventory);
+        REQUIRE_FALSE(box.feasible);
+        REQUIRE(box.steps.empty());
+        
+        const CraftingPlan& plan = planner.plan("plank", 1, inventory);
+        REQUIRE(plan.missing.size() == 1);
+        REQUIRE(plan.missing[0].first == wood.materialId);
+        
+        // Unlocking bumps the recipe generation and the graph is rebuilt
+        craftingSystem.unlockRecipe("log");
+        REQUIRE(planner.plan("plank", 1, inventory).feasible);
+        REQUIRE(crafts(planner.plan("plank", 1, inventory), "log") == 2);
+    }
+    
+    SECTION("Cached plans are refreshed when the inventory changes") {
+        REQUIRE_FALSE(planner.plan("plank", 2, inventory).feasible);
+        inventory.addCard(Card("Wood", 1, CardType::BUILDING, 4));
+        REQUIRE(planner.plan("plank", 2, inventory).feasible);
+    }
+}
@@ -1,7 +1,14 @@
 #include "../lib/catch2/catch.hpp"
 #include "Systems/DataManager.h"
+#include "Systems/LootTables.h"
+#include "Systems/DataPack.h"
+#include "Core/Inventory.h"
+#include "Core/Random.h"
+#include <chrono>
 #include <filesystem>
+#include <iterator>
 #include <fstream>
+#include <thread>
 
 using namespace DataManagement;
 
@@ -102,6 +109,53 @@ TEST_CASE("GameDataManager basic operations", "[DataManager][GameDataManager]")
         const RecipeData* nonExistent = manager.findRecipe("nonexistent");
         REQUIRE(nonExistent == nullptr);
     }
+    
+    SECTION("Lookups follow single-item edits") {
+        manager.createDefaultMaterials();
+        size_t count = manager.getMaterials().size();
+        
+        MaterialData plank{"Plank", 1, CardType::BUILDING, 1, {}};
+        manager.addMaterial(plank);
+        REQUIRE(manager.materialExists("Plank", 1));
+        
+        // Renaming moves the material to its new key
+        MaterialData renamed = plank;
+        renamed.name = "Board";
+        renamed.rarity = 2;
+        REQUIRE(manager.updateMaterial("Plank", 1, renamed));
+        REQUIRE(!manager.materialExists("Plank", 1));
+        REQUIRE(manager.findMaterial("Board", 2) != nullptr);
+        REQUIRE(manager.findMaterialByName("Board")->rarity == 2);
+        
+        // Removing shifts later materials without losing them
+        REQUIRE(manager.removeMaterial("Wood", 1));
+        REQUIRE(!manager.materialExists("Wood", 1));
+        REQUIRE(manager.getMaterials().size() == count);
+        for (const auto& material : manager.getMaterials()) {
+            REQUIRE(manager.findMaterial(material.name, material.rarity) == &material);
+        }
+        REQUIRE(!manager.removeMaterial("Wood", 1));
+        
+        // With duplicates the first one wins, and the next takes over
+        MaterialData first{"Resin", 1, CardType::MISC, 1, {}};
+        MaterialData second{"Resin", 1, CardType::MISC, 7, {}};
+        manager.addMaterial(first);
+        manager.addMaterial(second);
+        REQUIRE(manager.findMaterial("Resin", 1)->baseQuantity == 1);
+        REQUIRE(manager.removeMaterial("Resin", 1));
+        REQUIRE(manager.findMaterial("Resin", 1)->baseQuantity == 7);
+        
+        manager.createDefaultRecipes();
+        RecipeData recipe = *manager.findRecipe("medkit");
+        recipe.id = "field_medkit";
+        REQUIRE(manager.updateRecipe("medkit", recipe));
+        REQUIRE(manager.findRecipe("medkit") == nullptr);
+        REQUIRE(manager.findRecipe("field_medkit") != nullptr);
+        REQUIRE(manager.removeRecipe("field_medkit"));
+        for (const auto& other : manager.getRecipes()) {
+            REQUIRE(manager.findRecipe(other.id) == &other);
+        }
+    }
 }
 
 TEST_CASE("Data validation", "[DataManager][Validation]") {
@@ -180,6 +234,32 @@ TEST_CASE("Data validation", "[DataManager][Validation]") {
         std::string summary = result.getSummary();
         REQUIRE(summary.find("PASSED") != std::string::npos);
     }
+    
+    SECTION("Large data sets report each problem once, in a stable order") {
+        manager.createDefaultDataFiles();
+        std::vector<MaterialData> materials = manager.getMaterials();
+        std::vector<RecipeData> recipes = manager.getRecipes();
+        for (int i = 0; i < 20000; ++i) {
+            materials.push_back({"Bulk" + std::to_string(i), 1 + i % 3, CardType::MISC, 1, {}});
+        }
+        materials.push_back(materials[100]);
+        for (int i = 0; i < 5000; ++i) {
+            RecipeData recipe = recipes[0];
+            recipe.id = "bulk_" + std::to_string(i);
+            recipe.ingredients = {{"Bulk" + std::to_string(i), 1}, {"Bulk" + std::to_string(i * 3), 2}};
+            recipe.resultMaterial = "Bulk" + std::to_string(i + 1);
+            recipes.push_back(recipe);
+        }
+        recipes.back().ingredients.push_back({"Missing", 1});
+        manager.setMaterials(materials);
+        manager.setRecipes(recipes);
+        
+        ValidationResult result = manager.validateAll();
+        REQUIRE(result.errors.size() == 2);
+        REQUIRE(result.errors[0].find("non-existent material: Missing") != std::string::npos);
+        REQUIRE(result.errors[1].find("Duplicate material found") != std::string::npos);
+        REQUIRE(manager.validateAll().errors == result.errors);
+    }
 }
 
 TEST_CASE("File I/O operations", "[DataManager][FileIO]") {
@@ -235,12 +315,444 @@ TEST_CASE("File I/O operations", "[DataManager][FileIO]") {
         REQUIRE(newManager.getMaterials().size() == manager.getMaterials().size());
         REQUIRE(newManager.getRecipes().size() == manager.getRecipes().size());
         REQUIRE(newManager.getEvents().size() == manager.getEvents().size());
+        REQUIRE(newManager.findMaterial("Wood", 1) != nullptr);
+        
+        // Every file is timed, in load order
+        const auto& timings = newManager.getLoadTimings();
+        REQUIRE(timings.size() == 4);
+        REQUIRE(timings[1].file == "materials.json");
+        for (const auto& timing : timings) {
+            REQUIRE(timing.loaded);
+            REQUIRE(timing.milliseconds >= 0.0);
+        }
+        
+        // A missing file fails the load and skips validation
+        std::filesystem::remove(testDir + "recipes.json");
+        GameDataManager partialManager;
+        REQUIRE(!partialManager.loadAllData(testDir));
+        REQUIRE(!partialManager.getLoadTimings()[2].loaded);
+        REQUIRE(partialManager.getLoadTimings()[3].loaded);
         
         // Cleanup
         std::filesystem::remove_all(testDir);
     }
 }
 
+TEST_CASE("Streaming JSON parsing", "[DataManager][FileIO]") {
+    const std::string testDir = "test_stream_temp/";
+    std::filesystem::remove_all(testDir);
+    std::filesystem::create_directories(testDir);
+    auto writeFile = [&](const std::string& name, const std::string& content) {
+        std::ofstream file(testDir + name);
+        file << content;
+        return testDir + name;
+    };
+    
+    SECTION("Fields may come in any order and unknown keys are skipped") {
+        std::string path = writeFile("materials.json", R"({
+            "extra": {"nested": [1, 2, {"name": "ignored"}]},
+            "materials": [
+                {"attributes": {"0": 2.5, "1": 4}, "type": 0, "rarity": 2, "comment": [true], "name": "Copper"},
+                {"name": "Tin", "rarity": 1, "type": 0, "base_quantity": 3}
+            ],
+            "version": "1.2.0"
+        })");
+        GameDataManager manager;
+        REQUIRE(manager.loadMaterials(path));
+        REQUIRE(manager.getMaterials().size() == 2);
+        const MaterialData* copper = manager.findMaterial("Copper", 2);
+        REQUIRE(copper != nullptr);
+        REQUIRE(copper->baseQuantity == 1);
+        REQUIRE(copper->attributes.size() == 2);
+        REQUIRE(manager.findMaterial("Tin", 1)->baseQuantity == 3);
+        
+        path = writeFile("events.json", R"({
+            "events": [{"name": "Storm", "description": "Rain", "probability": 0.5,
+                        "effects": ["wet"], "rewards": [{"material": "Tin", "min": 2}]}],
+            "loot_tables": [{"entries": [{"table": "inner", "max": 3}], "id": "outer"}]
+        })");
+        REQUIRE(manager.loadEvents(path));
+        REQUIRE(manager.getEvents().size() == 1);
+        REQUIRE(manager.getEvents()[0].isActive);
+        REQUIRE(manager.getEvents()[0].effects == std::vector<std::string>{"wet"});
+        REQUIRE(manager.getEvents()[0].rewards[0].maxQuantity == 2);
+        REQUIRE(manager.getLootTables()[0].id == "outer");
+        REQUIRE(manager.getLootTables()[0].entries[0].maxQuantity == 3);
+    }
+    
+    SECTION("Bad files are rejected and leave the loaded data alone") {
+        GameDataManager manager;
+        manager.createDefaultDataFiles();
+        size_t materialCount = manager.getMaterials().size();
+        size_t recipeCount = manager.getRecipes().size();
+        
+        REQUIRE(!manager.loadMaterials(writeFile("missing.json",
+            R"({"materials": [{"name": "Copper", "rarity": 1, "type": 0}, {"name": "Tin", "type": 0}]})")));
+        REQUIRE(!manager.loadMaterials(writeFile("wrong_type.json",
+            R"({"materials": [{"name": "Copper", "rarity": "rare", "type": 0}]})")));
+        REQUIRE(!manager.loadMaterials(writeFile("truncated.json",
+            R"({"materials": [{"name": "Copper", "rarity": 1, "type": 0})")));
+        REQUIRE(!manager.loadMaterials(writeFile("empty.json", "")));
+        REQUIRE(!manager.loadRecipes(writeFile("ingredient.json",
+            R"({"recipes": [{"id": "r", "name": "R", "description": "", "result_material": "Wood",
+                "success_rate": 1, "ingredients": [{"material": "Wood"}]}]})")));
+        REQUIRE(manager.getMaterials().size() == materialCount);
+        REQUIRE(manager.getRecipes().size() == recipeCount);
+        REQUIRE(manager.findMaterial("Wood", 1) != nullptr);
+        REQUIRE(manager.findMaterial("Copper", 1) == nullptr);
+    }
+    
+    SECTION("Large files load completely") {
+        const int count = 20000;
+        std::string content = "{\"version\": \"1.0.0\", \"materials\": [";
+        for (int i = 0; i < count; ++i) {
+            content += (i ? ",\n" : "\n");
+            content += "{\"name\": \"Material" + std::to_string(i) + "\", \"rarity\": " +
+                       std::to_string(i % 5 + 1) + ", \"type\": 0, \"attributes\": {\"0\": " +
+                       std::to_string(i) + "}}";
+        }
+        content += "]}";
+        
+        GameDataManager manager;
+        REQUIRE(manager.loadMaterials(writeFile("large.json", content)));
+        REQUIRE(manager.getMaterials().size() == count);
+        const MaterialData* last = manager.findMaterial("Material19999", 19999 % 5 + 1);
+        REQUIRE(last != nullptr);
+        REQUIRE(last->attributes.get(static_cast<AttributeType>(0)) == 19999.0f);
+    }
+    
+    std::filesystem::remove_all(testDir);
+}
+
+TEST_CASE("Compiled data pack", "[DataManager][DataPack]") {
+    const std::string testDir = "test_pack_temp/";
+    std::filesystem::remove_all(testDir);
+    
+    GameDataManager manager;
+    manager.createDefaultDataFiles();
+    std::vector<LootTableData> tables(1);
+    tables[0].id = "scavenge";
+    tables[0].entries.push_back({"Wood", 1, "", "", 3.0f, 1, 4, "Metal", 2});
+    manager.setLootTables(tables);
+    REQUIRE(manager.saveAllData(testDir));
+    REQUIRE(manager.compileDataPack(testDir));
+    
+    SECTION("A current pack replaces the JSON") {
+        GameDataManager packed;
+        REQUIRE(packed.loadAllData(testDir));
+        const DataPack* pack = packed.getDataPack();
+        REQUIRE(pack != nullptr);
+        REQUIRE(packed.getLoadTimings().size() == 1);
+        REQUIRE(packed.getLoadTimings()[0].file == DataPack::FILE_NAME);
+        
+        REQUIRE(packed.getMaterials().size() == manager.getMaterials().size());
+        for (size_t i = 0; i < manager.getMaterials().size(); ++i) {
+            const auto& expected = manager.getMaterials()[i];
+            const auto& actual = packed.getMaterials()[i];
+            REQUIRE(actual.name == expected.name);
+            REQUIRE(actual.rarity == expected.rarity);
+            REQUIRE(actual.type == expected.type);
+            REQUIRE(actual.attributes == expected.attributes);
+            REQUIRE(pack->findMaterial(expected.name, expected.rarity) == static_cast<int>(i));
+        }
+        REQUIRE(pack->findMaterial("Wood", 5) == -1);
+        
+        REQUIRE(packed.getRecipes().size() == manager.getRecipes().size());
+        for (size_t i = 0; i < manager.getRecipes().size(); ++i) {
+            const auto& expected = manager.getRecipes()[i];
+            const auto& actual = packed.getRecipes()[i];
+            REQUIRE(actual.id == expected.id);
+            REQUIRE(actual.ingredients == expected.ingredients);
+            REQUIRE(actual.successRate == expected.successRate);
+            REQUIRE(pack->findRecipe(expected.id) == static_cast<int>(i));
+        }
+        REQUIRE(pack->findRecipe("nonexistent") == -1);
+        
+        REQUIRE(packed.getEvents().size() == manager.getEvents().size());
+        REQUIRE(packed.getEvents()[0].rewardMaterials == manager.getEvents()[0].rewardMaterials);
+        REQUIRE(packed.getLootTables().size() == 1);
+        REQUIRE(packed.getLootTables()[0].entries[0].requiresMaterial == "Metal");
+        REQUIRE(packed.getLootTables()[0].entries[0].maxQuantity == 4);
+        REQUIRE(packed.getGameConfig().version == manager.getGameConfig().version);
+        REQUIRE(packed.findMaterial("Wood", 1) != nullptr);
+        REQUIRE(packed.validateAll().isValid);
+    }
+
+    SECTION("The lists are built from the pack on first use") {
+        GameDataManager packed;
+        REQUIRE(packed.loadAllData(testDir));
+        REQUIRE(packed.getGameConfig().configName == manager.getGameConfig().configName);
+
+        // Lookups and edits see the pack's data without a getter call first
+        REQUIRE(packed.findMaterialByName("Wood") != nullptr);
+        REQUIRE(packed.removeRecipe(manager.getRecipes()[0].id));
+        REQUIRE(packed.getRecipes().size() == manager.getRecipes().size() - 1);
+        REQUIRE(packed.getMaterials().size() == manager.getMaterials().size());
+
+        // First access from several threads reads the pack once
+        GameDataManager shared;
+        REQUIRE(shared.loadAllData(testDir));
+        std::vector<std::thread> readers;
+        std::vector<size_t> counts(4);
+        for (size_t i = 0; i < counts.size(); ++i) {
+            readers.emplace_back([&shared, &counts, i]() {
+                counts[i] = shared.getMaterials().size();
+            });
+        }
+        for (auto& reader : readers) {
+            reader.join();
+        }
+        for (size_t count : counts) {
+            REQUIRE(count == manager.getMaterials().size());
+        }
+    }
+
+    SECTION("The pack holds the JSON on disk, not unsaved edits") {
+        size_t savedCount = manager.getMaterials().size();
+        manager.addMaterial(MaterialData{"Plank", 1, CardType::BUILDING, 1, {}});
+        REQUIRE(manager.compileDataPack(testDir));
+
+        GameDataManager packed;
+        REQUIRE(packed.loadAllData(testDir));
+        REQUIRE(packed.getDataPack() != nullptr);
+        REQUIRE(packed.getMaterials().size() == savedCount);
+        REQUIRE(!packed.materialExists("Plank", 1));
+    }
+
+    SECTION("Editing the JSON makes the pack stale") {
+        {
+            std::ofstream recipes(testDir + "recipes.json", std::ios::app);
+            recipes << "\n";
+        }
+        GameDataManager reloaded;
+        REQUIRE(reloaded.loadAllData(testDir));
+        REQUIRE(reloaded.getDataPack() == nullptr);
+        REQUIRE(reloaded.getLoadTimings().size() == 4);
+    }
+    
+    SECTION("Rewriting the JSON with the same content keeps the pack") {
+        std::string path = testDir + "materials.json";
+        std::string content;
+        {
+            std::ifstream in(path);
+            content.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        }
+        auto compiled = std::filesystem::last_write_time(path);
+        {
+            std::ofstream out(path, std::ios::trunc);
+            out << content;
+        }
+        std::filesystem::last_write_time(path, compiled + std::chrono::hours(1));
+        GameDataManager reloaded;
+        REQUIRE(reloaded.loadAllData(testDir));
+        REQUIRE(reloaded.getDataPack() != nullptr);
+    }
+    
+    SECTION("A damaged pack fails verification") {
+        DataPack intact;
+        std::string error;
+        REQUIRE(intact.open(testDir + DataPack::FILE_NAME, error));
+        REQUIRE(intact.verify(error));
+        intact.close();
+        
+        {
+            std::fstream pack(testDir + DataPack::FILE_NAME, std::ios::in | std::ios::out | std::ios::binary);
+            pack.seekp(-1, std::ios::end);
+            pack.put('\x7f');
+        }
+        // Opening checks only the header, the payload hash is for tools
+        DataPack pack;
+        REQUIRE(pack.open(testDir + DataPack::FILE_NAME, error));
+        REQUIRE(!pack.verify(error));
+        REQUIRE(error.find("damaged") != std::string::npos);
+        
+        // Truncation is caught by the section bounds when opening
+        pack.close();
+        std::filesystem::resize_file(testDir + DataPack::FILE_NAME, 200);
+        REQUIRE(!pack.open(testDir + DataPack::FILE_NAME, error));
+        GameDataManager reloaded;
+        REQUIRE(reloaded.loadAllData(testDir));
+        REQUIRE(reloaded.getDataPack() == nullptr);
+    }
+    
+    std::filesystem::remove_all(testDir);
+}
+
+TEST_CASE("Loot tables", "[DataManager][LootTables]") {
+    GameDataManager manager;
+    manager.createDefaultDataFiles();
+    Inventory inventory;
+    Rng rng(11);
+    
+    LootEntryData wood;
+    wood.material = "Wood";
+    wood.weight = 3.0f;
+    wood.minQuantity = 2;
+    wood.maxQuantity = 4;
+    LootEntryData metal;
+    metal.material = "Metal";
+    metal.rarity = 2;
+    LootEntryData gated;
+    gated.material = "Medicine";
+    gated.rarity = 2;
+    gated.requiresMaterial = "Bandage";
+    LootEntryData nested;
+    nested.table = "salvage";
+    nested.minQuantity = 2;
+    nested.maxQuantity = 2;
+    
+    SECTION("Weights decide how often each entry comes up") {
+        manager.setLootTables({{"salvage", {wood, metal}}});
+        LootTables loot;
+        REQUIRE(loot.compile(manager).isValid);
+        
+        LootTotals totals;
+        loot.sampleN(loot.findTable("salvage"), 40000, rng, inventory, totals);
+        uint64_t woodRolls = 0;
+        uint64_t metalRolls = 0;
+        for (size_t i = 0; i < loot.itemCount(); ++i) {
+            if (loot.getItem(i).name == "Wood") woodRolls = totals.gained[i];
+            if (loot.getItem(i).name == "Metal") metalRolls = totals.gained[i];
+        }
+        // Wood averages 3 units a pick, Metal 1
+        REQUIRE(woodRolls / 3.0 / 40000 == Approx(0.75).margin(0.01));
+        REQUIRE(metalRolls / 40000.0 == Approx(0.25).margin(0.01));
+        REQUIRE(totals.rolls == 40000);
+        REQUIRE(totals.empty == 0);
+    }
+    
+    SECTION("Quantities stay in range and nested tables roll their count") {
+        manager.setLootTables({{"salvage", {wood}}, {"cache", {nested}}});
+        LootTables loot;
+        REQUIRE(loot.compile(manager).isValid);
+        
+        for (int i = 0; i < 200; ++i) {
+            LootResult result;
+            loot.sample(loot.findTable("cache"), rng, inventory, result);
+            REQUIRE(result.gained.size() == 2);
+            for (const auto& drop : result.gained) {
+                REQUIRE(drop.quantity >= 2);
+                REQUIRE(drop.quantity <= 4);
+            }
+        }
+    }
+    
+    SECTION("Conditional entries need the required material") {
+        manager.setLootTables({{"clinic", {gated}}});
+        LootTables loot;
+        REQUIRE(loot.compile(manager).isValid);
+        
+        LootResult result;
+        loot.sample(loot.findTable("clinic"), rng, inventory, result);
+        REQUIRE(result.gained.empty());
+        
+        inventory.addCard(Card("Bandage", 1, CardType::HERB));
+        loot.sample(loot.findTable("clinic"), rng, inventory, result);
+        REQUIRE(result.gained.size() == 1);
+        REQUIRE(loot.getItem(result.gained[0].item).name == "Medicine");
+    }
+    
+    SECTION("Events roll their rewards and the exploration table picks events") {
+        auto events = manager.getEvents();
+        for (auto& event : events) {
+            event.probability = 0.0f;
+        }
+        events[0].probability = 1.0f;
+        events[0].rewards = {nested};
+        manager.setEvents(events);
+        manager.setLootTables({{"salvage", {wood}}});
+        LootTables loot;
+        REQUIRE(loot.compile(manager).isValid);
+        
+        LootResult result;
+        loot.sample(loot.findTable(LootTables::EXPLORATION), rng, inventory, result);
+        REQUIRE(result.events == std::vector<uint32_t>{0});
+        REQUIRE(result.gained.size() == 2);
+        REQUIRE(loot.getEventDescription(0) == events[0].description);
+    }
+    
+    SECTION("Exploring a material-only table adds its stacks") {
+        // What Controller::handleExplore runs; no event fires here
+        manager.setLootTables({{LootTables::EXPLORATION, {wood}}, {"salvage", {metal}}, {"cache", {nested}}});
+        LootTables loot;
+        REQUIRE(loot.compile(manager).isValid);
+
+        LootResult result;
+        REQUIRE(loot.apply(loot.findTable(LootTables::EXPLORATION), rng, inventory, result));
+        REQUIRE(result.events.empty());
+        REQUIRE(result.gained.size() == 1);
+        REQUIRE(inventory.countOfAnyRarity("Wood") == result.gained[0].quantity);
+
+        // Nested tables apply the same way
+        REQUIRE(loot.apply(loot.findTable("cache"), rng, inventory, result));
+        REQUIRE(result.gained.size() == 2);
+        REQUIRE(inventory.countOfAnyRarity("Metal") == 2);
+    }
+
+    SECTION("Bad references and cycles are reported and cut") {
+        LootEntryData back;
+        back.table = "salvage";
+        LootEntryData forward;
+        forward.table = "cache";
+        LootEntryData unknown;
+        unknown.material = "Unobtainium";
+        manager.setLootTables({{"salvage", {forward, unknown}}, {"cache", {back}}});
+        LootTables loot;
+        ValidationResult result = loot.compile(manager);
+        REQUIRE_FALSE(result.isValid);
+        REQUIRE(result.errors.size() == 2);
+        REQUIRE_FALSE(manager.validateDataConsistency().isValid);
+        
+        // Sampling still terminates
+        LootTotals totals;
+        loot.sampleN(loot.findTable("salvage"), 100, rng, inventory, totals);
+        REQUIRE(totals.empty == 100);
+    }
+    
+    SECTION("Loot survives a save and load of events.json") {
+        const std::string testDir = "test_loot_temp/";
+        std::filesystem::remove_all(testDir);
+        auto events = manager.getEvents();
+        events[0].rewards = {wood, nested};
+        manager.setEvents(events);
+        manager.setLootTables({{"salvage", {wood, metal, gated}}});
+        REQUIRE(manager.saveEvents(testDir + "events.json"));
+        
+        GameDataManager loaded;
+        loaded.createDefaultMaterials();
+        REQUIRE(loaded.loadEvents(testDir + "events.json"));
+        REQUIRE(loaded.getLootTables().size() == 1);
+        const auto& entries = loaded.getLootTables()[0].entries;
+        REQUIRE(entries.size() == 3);
+        REQUIRE(entries[0].maxQuantity == 4);
+        REQUIRE(entries[1].rarity == 2);
+        REQUIRE(entries[2].requiresMaterial == "Bandage");
+        REQUIRE(loaded.getEvents()[0].rewards.size() == 2);
+        REQUIRE(loaded.getEvents()[0].rewards[1].table == "salvage");
+        
+        std::filesystem::remove_all(testDir);
+    }
+}
+
+TEST_CASE("Legacy exploration events", "[DataManager][LootTables]") {
+    std::vector<Event> events = {
+        Event("Found wood", {Card("Wood", 1, CardType::BUILDING, 2)}, {}, 0.5f),
+        Event("Lost food", {}, {Card("Food", 1, CardType::FOOD, 1)}, 0.25f)
+    };
+    LootTables loot;
+    loot.compileEvents(events);
+    Inventory inventory;
+    Rng rng(3);
+    
+    LootTotals totals;
+    loot.sampleN(loot.findTable(LootTables::EXPLORATION), 40000, rng, inventory, totals);
+    REQUIRE(totals.events[0] / 40000.0 == Approx(0.5).margin(0.01));
+    REQUIRE(totals.events[1] / 40000.0 == Approx(0.25).margin(0.01));
+    REQUIRE(totals.empty / 40000.0 == Approx(0.25).margin(0.01));
+    REQUIRE(totals.gained[0] == 2 * static_cast<int64_t>(totals.events[0]));
+    REQUIRE(totals.lost[1] == totals.events[1]);
+}
+
 TEST_CASE("ValidationResult functionality", "[DataManager][ValidationResult]") {
     SECTION("Error and warning handling") {
         ValidationResult result;
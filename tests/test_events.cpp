@@ -0,0 +1,347 @@
+#include "../lib/catch2/catch.hpp"
+#include "Systems/CompiledEvents.h"
+#include "Systems/EventTriggers.h"
+#include "Core/GameEvents.h"
+#include "Interface/editor/GameData.h"
+#include "Core/Inventory.h"
+#include "Core/Random.h"
+#include <chrono>
+#include <thread>
+
+namespace {
+
+EventCondition makeCondition(ConditionType type, const std::string& target, float value, const std::string& op = "") {
+    EventCondition condition;
+    condition.type = type;
+    condition.target = target;
+    condition.value = value;
+    condition.operator_ = op;
+    return condition;
+}
+
+EventTemplate makeEvent(const std::string& id, const std::vector<EventCondition>& conditions) {
+    EventTemplate event;
+    event.id = id;
+    event.name = id;
+    event.conditions = conditions;
+    event.isRepeatable = true;
+    event.priority = 0;
+    return event;
+}
+
+} // namespace
+
+TEST_CASE("Compiled event conditions", "[Events][CompiledEvents]") {
+    Inventory inventory;
+    inventory.addCard(Card("Wood", 1, CardType::BUILDING, 5));
+    inventory.addCard(Card("Wood", 2, CardType::BUILDING, 1));
+    inventory.addCard(Card("Stone", 1, CardType::BUILDING, 2));
+
+    EventState state;
+    state.readInventory(*inventory.snapshot());
+    state.turn = 10;
+    state.playerHealth = 40.0f;
+    state.location = "forest";
+    Rng rng(1);
+
+    std::vector<EventTemplate> events = {
+        makeEvent("no_conditions", {}),
+        makeEvent("has_wood", {makeCondition(ConditionType::INVENTORY_HAS, "Wood", 0.0f)}),
+        makeEvent("six_wood", {makeCondition(ConditionType::INVENTORY_COUNT, "Wood", 6.0f, "==")}),
+        makeEvent("lots_of_stone", {makeCondition(ConditionType::INVENTORY_COUNT, "Stone", 3.0f, ">=")}),
+        makeEvent("no_iron", {makeCondition(ConditionType::INVENTORY_COUNT, "Iron", 0.0f, "==")}),
+        makeEvent("forest_late", {makeCondition(ConditionType::TIME, "", 5.0f, ">"),
+                                  makeCondition(ConditionType::LOCATION, "forest", 0.0f)}),
+        makeEvent("not_forest", {makeCondition(ConditionType::LOCATION, "forest", 0.0f, "!=")}),
+        makeEvent("cave", {makeCondition(ConditionType::LOCATION, "cave", 0.0f)}),
+        makeEvent("wounded", {makeCondition(ConditionType::PLAYER_HEALTH, "", 50.0f, "<")}),
+        makeEvent("never", {makeCondition(ConditionType::RANDOM_CHANCE, "", 0.0f)}),
+        makeEvent("always", {makeCondition(ConditionType::RANDOM_CHANCE, "", 100.0f)}),
+        makeEvent("bad_operator", {makeCondition(ConditionType::TIME, "", 1.0f, "~")})
+    };
+
+    CompiledEvents compiled;
+    compiled.compile(events);
+    REQUIRE(compiled.eventCount() == events.size());
+    REQUIRE(compiled.getErrors().size() == 1);
+
+    std::vector<uint8_t> result;
+    compiled.canTriggerAll(state, rng, result);
+    std::vector<uint8_t> expected = {1, 1, 1, 0, 1, 1, 0, 0, 1, 0, 1, 0};
+    REQUIRE(result == expected);
+
+    for (size_t i = 0; i < events.size(); ++i) {
+        REQUIRE(compiled.canTrigger(i, state, rng) == (expected[i] != 0));
+    }
+
+    // Single conditions give the same answers uncompiled
+    REQUIRE(CompiledEvents::evaluate(events[2].conditions[0], state, rng));
+    REQUIRE_FALSE(CompiledEvents::evaluate(events[7].conditions[0], state, rng));
+
+    state.location = "cave";
+    compiled.canTriggerAll(state, rng, result);
+    REQUIRE(result[5] == 0);
+    REQUIRE(result[6] == 1);
+    REQUIRE(result[7] == 1);
+}
+
+TEST_CASE("Compiled event chances", "[Events][CompiledEvents]") {
+    std::vector<EventTemplate> events = {
+        makeEvent("quarter", {makeCondition(ConditionType::RANDOM_CHANCE, "", 0.25f)}),
+        makeEvent("percent", {makeCondition(ConditionType::RANDOM_CHANCE, "", 50.0f)}),
+        // The failing inventory check comes first, so no number is drawn
+        makeEvent("gated", {makeCondition(ConditionType::RANDOM_CHANCE, "", 0.5f),
+                            makeCondition(ConditionType::INVENTORY_HAS, "Unobtainium", 1.0f)})
+    };
+    CompiledEvents compiled;
+    compiled.compile(events);
+
+    EventState state;
+    Rng rng(7);
+    Rng untouched(7);
+    for (int i = 0; i < 100; ++i) {
+        REQUIRE_FALSE(compiled.canTrigger(2, state, rng));
+    }
+    REQUIRE(rng() == untouched());
+
+    int quarter = 0;
+    int percent = 0;
+    for (int i = 0; i < 40000; ++i) {
+        quarter += compiled.canTrigger(0, state, rng);
+        percent += compiled.canTrigger(1, state, rng);
+    }
+    REQUIRE(quarter / 40000.0 == Approx(0.25).margin(0.01));
+    REQUIRE(percent / 40000.0 == Approx(0.5).margin(0.01));
+}
+
+TEST_CASE("Compiled events scale per tick", "[Events][CompiledEvents][Performance]") {
+    const char* materials[] = {"Wood", "Stone", "Food", "Water", "Metal"};
+    std::vector<EventTemplate> events;
+    Rng rng(11);
+    for (int i = 0; i < 5000; ++i) {
+        events.push_back(makeEvent("event_" + std::to_string(i), {
+            makeCondition(ConditionType::RANDOM_CHANCE, "", 0.5f),
+            makeCondition(ConditionType::INVENTORY_COUNT, materials[i % 5], static_cast<float>(rng.nextInt(0, 10)), ">="),
+            makeCondition(ConditionType::TIME, "", static_cast<float>(rng.nextInt(0, 100)), "<=")
+        }));
+    }
+    CompiledEvents compiled;
+    compiled.compile(events);
+
+    Inventory inventory;
+    inventory.addCard(Card("Wood", 1, CardType::BUILDING, 5));
+    inventory.addCard(Card("Stone", 1, CardType::BUILDING, 8));
+    EventState state;
+    state.readInventory(*inventory.snapshot());
+    state.turn = 50;
+
+    std::vector<uint8_t> result;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int tick = 0; tick < 10; ++tick) {
+        compiled.canTriggerAll(state, rng, result);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+    REQUIRE(duration.count() / 10 < 1000);
+}
+
+TEST_CASE("Event trigger index", "[Events][EventTriggers]") {
+    std::vector<EventTemplate> events = {
+        makeEvent("wood", {makeCondition(ConditionType::INVENTORY_COUNT, "Wood", 3.0f, ">=")}),
+        makeEvent("stone", {makeCondition(ConditionType::INVENTORY_HAS, "Stone", 1.0f)}),
+        makeEvent("wood_and_stone", {makeCondition(ConditionType::INVENTORY_HAS, "Wood", 1.0f),
+                                     makeCondition(ConditionType::INVENTORY_HAS, "Stone", 1.0f)}),
+        makeEvent("late", {makeCondition(ConditionType::TIME, "", 10.0f, ">=")}),
+        makeEvent("wounded", {makeCondition(ConditionType::PLAYER_HEALTH, "", 50.0f, "<")}),
+        makeEvent("lucky", {makeCondition(ConditionType::RANDOM_CHANCE, "", 0.5f)}),
+        makeEvent("never", {makeCondition(ConditionType::RANDOM_CHANCE, "", 0.0f),
+                            makeCondition(ConditionType::INVENTORY_HAS, "Wood", 1.0f)})
+    };
+    CompiledEvents compiled;
+    compiled.compile(events);
+
+    std::vector<uint32_t> readers;
+    compiled.eventsReadingMaterial(MaterialRegistry::instance().find("Wood"), readers);
+    REQUIRE(readers == std::vector<uint32_t>{0, 2});
+    REQUIRE(compiled.eventsReading(CompiledEvents::Input::Turn) == std::vector<uint32_t>{3});
+    REQUIRE(compiled.eventsReading(CompiledEvents::Input::Chance) == std::vector<uint32_t>{5});
+
+    Inventory inventory;
+    EventState state;
+    Rng rng(5);
+    EventTriggers triggers;
+    triggers.reset(compiled);
+    triggers.syncInventory(inventory, state);
+    REQUIRE(triggers.update(state, rng) == events.size());
+    REQUIRE_FALSE(triggers.canTrigger(0));
+    REQUIRE_FALSE(triggers.canTrigger(3));
+
+    // Only events reading Wood, plus the chance event
+    inventory.addCard(Card("Wood", 1, CardType::BUILDING, 4));
+    triggers.syncInventory(inventory, state);
+    REQUIRE(triggers.update(state, rng) == 3);
+    REQUIRE(triggers.canTrigger(0));
+    REQUIRE_FALSE(triggers.canTrigger(2));
+
+    inventory.addCard(Card("Stone", 2, CardType::BUILDING, 1));
+    triggers.syncInventory(inventory, state);
+    REQUIRE(triggers.update(state, rng) == 3);
+    REQUIRE(triggers.canTrigger(1));
+    REQUIRE(triggers.canTrigger(2));
+
+    state.turn = 12;
+    triggers.inputChanged(CompiledEvents::Input::Turn);
+    REQUIRE(triggers.update(state, rng) == 2);
+    REQUIRE(triggers.canTrigger(3));
+
+    // Nothing changed: only the chance event is re-rolled
+    REQUIRE(triggers.update(state, rng) == 1);
+    REQUIRE_FALSE(triggers.canTrigger(6));
+}
+
+TEST_CASE("Event triggers match full polling", "[Events][EventTriggers]") {
+    const char* materials[] = {"Wood", "Stone", "Food", "Water", "Metal", "Cloth"};
+    Rng rng(21);
+    std::vector<EventTemplate> events;
+    for (int i = 0; i < 2000; ++i) {
+        std::vector<EventCondition> conditions;
+        conditions.push_back(makeCondition(ConditionType::INVENTORY_COUNT, materials[rng.nextInt(0, 5)],
+                                           static_cast<float>(rng.nextInt(0, 6)), rng.nextInt(0, 1) ? ">=" : "<"));
+        if (rng.nextInt(0, 2) == 0) {
+            conditions.push_back(makeCondition(ConditionType::PLAYER_HEALTH, "", static_cast<float>(rng.nextInt(10, 90)), "<="));
+        }
+        if (rng.nextInt(0, 2) == 0) {
+            conditions.push_back(makeCondition(ConditionType::TIME, "", static_cast<float>(rng.nextInt(0, 50)), ">"));
+        }
+        events.push_back(makeEvent("event_" + std::to_string(i), conditions));
+    }
+    CompiledEvents compiled;
+    compiled.compile(events);
+
+    Inventory inventory;
+    EventState state;
+    EventTriggers triggers;
+    triggers.reset(compiled);
+    std::vector<uint8_t> polled;
+    size_t incremental = 0;
+    for (int tick = 0; tick < 60; ++tick) {
+        for (int change = 0; change < 2; ++change) {
+            const char* material = materials[rng.nextInt(0, 5)];
+            if (rng.nextInt(0, 1)) {
+                inventory.addCard(Card(material, 1, CardType::MISC, rng.nextInt(1, 3)));
+            } else {
+                inventory.removeCard(material, 1);
+            }
+        }
+        if (tick % 7 == 0) {
+            state.playerHealth = static_cast<float>(rng.nextInt(0, 100));
+            triggers.inputChanged(CompiledEvents::Input::Health);
+        }
+        state.turn = tick;
+        triggers.inputChanged(CompiledEvents::Input::Turn);
+
+        triggers.syncInventory(inventory, state);
+        incremental += triggers.update(state, rng);
+        compiled.canTriggerAll(state, rng, polled);
+        REQUIRE(triggers.getTriggerable() == polled);
+    }
+    REQUIRE(incremental < 60 * events.size());
+}
+
+TEST_CASE("Event bus delivers on drain", "[Events][EventBus]") {
+    EventBus bus;
+    std::vector<int> decayed;
+    std::vector<std::string> messages;
+    bus.subscribe<BuildingsDecayedEvent>([&](const BuildingsDecayedEvent& event) {
+        decayed.push_back(event.damagedBuildings);
+    });
+    EventBus::SubscriptionId notifications = bus.subscribe<NotificationEvent>([&](const NotificationEvent& event) {
+        messages.push_back(event.message.str());
+    });
+
+    bus.publish(BuildingsDecayedEvent{3});
+    bus.publish(BuildingsDecayedEvent{5});
+    NotificationEvent note;
+    note.message = std::string(300, 'x');
+    bus.publish(note);
+    // Nothing runs until the main loop drains
+    REQUIRE(decayed.empty());
+    REQUIRE(bus.drain() == 3);
+    REQUIRE(decayed == std::vector<int>{3, 5});
+    REQUIRE(messages.size() == 1);
+    REQUIRE(messages[0].size() == 127);
+
+    // No subscriber: publishing is a no-op
+    bus.publish(BuildingPlacedEvent{1, 2, BuildingType::WALL});
+    REQUIRE(bus.drain() == 0);
+
+    bus.unsubscribe(notifications);
+    bus.publish(note);
+    bus.drain();
+    REQUIRE(messages.size() == 1);
+}
+
+TEST_CASE("Event bus handlers may subscribe during a drain", "[Events][EventBus]") {
+    EventBus bus;
+    int received = 0;
+    bus.subscribe<BuildingsDecayedEvent>([&](const BuildingsDecayedEvent&) {
+        // Enough new subscriptions to reallocate the list being drained
+        for (size_t i = 0; i < EventBus::MAX_SUBSCRIBERS; ++i) {
+            REQUIRE(bus.subscribe<NotificationEvent>([&](const NotificationEvent&) { ++received; }) != 0);
+        }
+    });
+    bus.publish(BuildingsDecayedEvent{1});
+    REQUIRE(bus.drain() == 1);
+
+    // The new subscribers take part from the next drain on
+    bus.publish(NotificationEvent{});
+    REQUIRE(bus.drain() == EventBus::MAX_SUBSCRIBERS);
+    REQUIRE(received == static_cast<int>(EventBus::MAX_SUBSCRIBERS));
+}
+
+TEST_CASE("Event bus drops when a queue is full", "[Events][EventBus]") {
+    EventBus bus;
+    int received = 0;
+    bus.subscribe<BuildingsDecayedEvent>([&](const BuildingsDecayedEvent&) { ++received; }, 4);
+    for (int i = 0; i < 10; ++i) {
+        bus.publish(BuildingsDecayedEvent{i});
+    }
+    REQUIRE(bus.drain() == 4);
+    REQUIRE(received == 4);
+    REQUIRE(bus.getDroppedCount() == 6);
+}
+
+TEST_CASE("MPSC queue with concurrent producers", "[Events][EventBus]") {
+    const int producers = 4;
+    const int perProducer = 20000;
+    MpscQueue<BuildingPlacedEvent> queue(1024);
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&queue, p, perProducer]() {
+            for (int i = 0; i < perProducer; ++i) {
+                // x is the producer, y its sequence number
+                while (!queue.tryPush(BuildingPlacedEvent{p, i, BuildingType::WALL})) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    std::vector<int> lastSeen(producers, -1);
+    bool ordered = true;
+    int received = 0;
+    BuildingPlacedEvent event;
+    while (received < producers * perProducer) {
+        if (queue.tryPop(event)) {
+            ordered = ordered && event.y == lastSeen[event.x] + 1;
+            lastSeen[event.x] = event.y;
+            ++received;
+        }
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    REQUIRE(ordered);
+    REQUIRE_FALSE(queue.tryPop(event));
+}
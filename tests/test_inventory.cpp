@@ -1,8 +1,13 @@
 #include "../lib/catch2/catch.hpp"
 #include "Core/Inventory.h"
 #include "Core/Card.h"
+#include "Core/Random.h"
+#include "Systems/SaveManager.h"
+#include <filesystem>
+#include <fstream>
 #include <thread>
 #include <chrono>
+#include <atomic>
 
 TEST_CASE("Inventory basic operations", "[Inventory]") {
     Inventory inventory;
@@ -251,3 +256,494 @@ TEST_CASE("Inventory edge cases", "[Inventory]") {
         REQUIRE(inventory.getCards().size() <= numCards); // But not more than original
     }
 }
+
+
+TEST_CASE("Inventory indexed lookup", "[Inventory]") {
+    Inventory inventory;
+
+    SECTION("Finding cards by name and rarity") {
+        inventory.addCard(Card("Wood", 1, CardType::BUILDING, 3));
+        inventory.addCard(Card("Wood", 2, CardType::BUILDING, 1));
+
+        const Card* common = inventory.findCard("Wood", 1);
+        const Card* rare = inventory.findCard("Wood", 2);
+        REQUIRE(common != nullptr);
+        REQUIRE(rare != nullptr);
+        REQUIRE(common->quantity == 3);
+        REQUIRE(rare->quantity == 1);
+        REQUIRE(inventory.findCard("Wood", 3) == nullptr);
+        REQUIRE(inventory.findCard("Stone", 1) == nullptr);
+    }
+
+    SECTION("Removing a stack preserves order and index") {
+        inventory.addCard(Card("A", 1, CardType::MISC, 1));
+        inventory.addCard(Card("B", 1, CardType::MISC, 1));
+        inventory.addCard(Card("C", 1, CardType::MISC, 1));
+        inventory.addCard(Card("D", 1, CardType::MISC, 1));
+
+        inventory.removeCard("B", 1);
+
+        const auto& cards = inventory.getCards();
+        REQUIRE(cards.size() == 3);
+        REQUIRE(cards[0].name == "A");
+        REQUIRE(cards[1].name == "C");
+        REQUIRE(cards[2].name == "D");
+
+        // Shifted stacks are still found and merged in place
+        inventory.addCard(Card("D", 1, CardType::MISC, 4));
+        REQUIRE(inventory.findCard("D", 1) == &inventory.getCards()[2]);
+        REQUIRE(inventory.getCards()[2].quantity == 5);
+
+        inventory.addCard(Card("B", 1, CardType::MISC, 1));
+        REQUIRE(inventory.getCards().back().name == "B");
+    }
+
+    SECTION("Updating cards merges duplicate stacks") {
+        std::vector<Card> newCards = {
+            Card("Metal", 2, CardType::METAL, 2),
+            Card("Food", 1, CardType::FOOD, 1),
+            Card("Metal", 2, CardType::METAL, 3)
+        };
+        inventory.updateCards(newCards);
+
+        const auto& cards = inventory.getCards();
+        REQUIRE(cards.size() == 2);
+        REQUIRE(cards[0].name == "Metal");
+        REQUIRE(cards[0].quantity == 5);
+        REQUIRE(inventory.findCard("Food", 1) == &cards[1]);
+    }
+}
+
+
+TEST_CASE("Inventory snapshots", "[Inventory][threading]") {
+    Inventory inventory;
+
+    SECTION("Snapshots are immutable and shared per version") {
+        inventory.addCard(Card("Wood", 1, CardType::BUILDING, 2));
+        InventorySnapshot first = inventory.snapshot();
+        REQUIRE(first->cards.size() == 1);
+        REQUIRE(first->version == inventory.getVersion());
+        REQUIRE(inventory.snapshot() == first);  // Unchanged: same snapshot object
+
+        inventory.addCard(Card("Wood", 1, CardType::BUILDING, 3));
+        inventory.addCard(Card("Metal", 2, CardType::METAL, 1));
+        InventorySnapshot second = inventory.snapshot();
+
+        REQUIRE(second != first);
+        REQUIRE(second->version > first->version);
+        REQUIRE(first->cards.size() == 1);
+        REQUIRE(first->cards[0].quantity == 2);
+        REQUIRE(second->cards.size() == 2);
+        REQUIRE(second->cards[0].quantity == 5);
+    }
+
+    SECTION("Consistent snapshots never lag behind a writer") {
+        std::atomic<bool> done{false};
+        std::thread writer([&]() {
+            for (int i = 0; i < 2000; ++i) {
+                inventory.addCard(Card("Wood", 1, CardType::BUILDING, 1));
+            }
+            done = true;
+        });
+        bool lagged = false;
+        while (!done) {
+            uint64_t before = inventory.getVersion();
+            lagged = lagged || inventory.consistentSnapshot()->version < before;
+        }
+        writer.join();
+        REQUIRE_FALSE(lagged);
+
+        InventorySnapshot last = inventory.consistentSnapshot();
+        REQUIRE(last->version == inventory.getVersion());
+        REQUIRE(last->cards[0].quantity == 2000);
+        REQUIRE(inventory.snapshot() == last);
+    }
+
+    SECTION("Removing a missing card does not change the version") {
+        uint64_t before = inventory.getVersion();
+        inventory.removeCard("Missing", 1);
+        REQUIRE(inventory.getVersion() == before);
+    }
+
+    SECTION("Conditional update only applies to the expected version") {
+        inventory.addCard(Card("Food", 1, CardType::FOOD, 1));
+        InventorySnapshot snapshot = inventory.snapshot();
+
+        inventory.addCard(Card("Water", 1, CardType::FOOD, 1));
+        REQUIRE_FALSE(inventory.updateCards({}, snapshot->version));
+        REQUIRE(inventory.getCards().size() == 2);
+
+        REQUIRE(inventory.updateCards({Card("Coal", 1, CardType::FUEL, 4)}, inventory.getVersion()));
+        REQUIRE(inventory.getCards().size() == 1);
+        REQUIRE(inventory.getCards()[0].name == "Coal");
+    }
+
+    SECTION("Readers take snapshots while a writer modifies") {
+        const int numCards = 2000;
+        std::atomic<bool> done{false};
+        bool consistent = true;
+
+        std::thread reader([&]() {
+            uint64_t lastVersion = 0;
+            while (!done) {
+                InventorySnapshot snapshot = inventory.snapshot();
+                if (snapshot->version < lastVersion || snapshot->cards.size() > static_cast<size_t>(numCards)) {
+                    consistent = false;
+                }
+                for (const auto& card : snapshot->cards) {
+                    if (card.quantity != 1) consistent = false;
+                }
+                lastVersion = snapshot->version;
+            }
+        });
+
+        for (int i = 0; i < numCards; ++i) {
+            inventory.addCard(Card("Snap" + std::to_string(i), 1, CardType::MISC, 1));
+        }
+        done = true;
+        reader.join();
+
+        REQUIRE(consistent);
+        REQUIRE(inventory.snapshot()->cards.size() == static_cast<size_t>(numCards));
+    }
+}
+
+TEST_CASE("Inventory change deltas", "[Inventory]") {
+    Inventory inventory;
+
+    SECTION("Adds and removes are logged with old and new quantities") {
+        uint64_t start = inventory.getVersion();
+        inventory.addCard(Card("Wood", 1, CardType::BUILDING, 3));
+        inventory.addCard(Card("Wood", 1, CardType::BUILDING, 2));
+        inventory.removeCard("Wood", 1);
+
+        std::vector<InventoryDelta> deltas;
+        REQUIRE(inventory.changesSince(start, deltas));
+        REQUIRE(deltas.size() == 3);
+        REQUIRE(deltas[0].oldQuantity == 0);
+        REQUIRE(deltas[0].newQuantity == 3);
+        REQUIRE(deltas[1].oldQuantity == 3);
+        REQUIRE(deltas[1].newQuantity == 5);
+        REQUIRE(deltas[2].oldQuantity == 5);
+        REQUIRE(deltas[2].newQuantity == 4);
+        REQUIRE(deltas[2].version == inventory.getVersion());
+        REQUIRE(deltas[0].id == inventory.getCards()[0].getId());
+    }
+
+    SECTION("Consumers only receive changes after their version") {
+        inventory.addCard(Card("Stone", 1, CardType::BUILDING, 1));
+        uint64_t seen = inventory.getVersion();
+        inventory.removeCard("Stone", 1);
+
+        std::vector<InventoryDelta> deltas;
+        REQUIRE(inventory.changesSince(seen, deltas));
+        REQUIRE(deltas.size() == 1);
+        REQUIRE(deltas[0].oldQuantity == 1);
+        REQUIRE(deltas[0].newQuantity == 0);
+
+        deltas.clear();
+        REQUIRE(inventory.changesSince(inventory.getVersion(), deltas));
+        REQUIRE(deltas.empty());
+    }
+
+    SECTION("Replacing cards logs only quantity differences") {
+        inventory.addCard(Card("Wood", 1, CardType::BUILDING, 2));
+        inventory.addCard(Card("Stone", 1, CardType::BUILDING, 1));
+        uint64_t seen = inventory.getVersion();
+
+        // Same stacks in another order, plus one removed and one new
+        inventory.updateCards({Card("Stone", 1, CardType::BUILDING, 1), Card("Coal", 1, CardType::FUEL, 4)});
+
+        std::vector<InventoryDelta> deltas;
+        REQUIRE(inventory.changesSince(seen, deltas));
+        REQUIRE(deltas.size() == 2);
+        REQUIRE(deltas[0].id.material == MaterialRegistry::instance().find("Coal"));
+        REQUIRE(deltas[0].newQuantity == 4);
+        REQUIRE(deltas[1].id.material == MaterialRegistry::instance().find("Wood"));
+        REQUIRE(deltas[1].oldQuantity == 2);
+        REQUIRE(deltas[1].newQuantity == 0);
+    }
+
+    SECTION("Consumers that fall too far behind must rescan") {
+        uint64_t start = inventory.getVersion();
+        for (size_t i = 0; i <= Inventory::MAX_DELTA_LOG; ++i) {
+            inventory.addCard(Card("Wood", 1, CardType::BUILDING, 1));
+        }
+
+        std::vector<InventoryDelta> deltas;
+        REQUIRE_FALSE(inventory.changesSince(start, deltas));
+        REQUIRE(inventory.changesSince(inventory.getVersion() - 1, deltas));
+        REQUIRE(deltas.size() == 1);
+    }
+}
+
+TEST_CASE("Inventory batches", "[Inventory]") {
+    Inventory inventory;
+    inventory.addCard(Card("Wood", 1, CardType::BUILDING, 3));
+    inventory.addCard(Card("Wood", 2, CardType::BUILDING, 2));
+    inventory.addCard(Card("Stone", 1, CardType::BUILDING, 1));
+    MaterialId wood = MaterialRegistry::instance().find("Wood");
+
+    SECTION("A valid batch applies every operation under one version") {
+        uint64_t before = inventory.getVersion();
+        InventoryBatch batch;
+        batch.removeAnyRarity(wood, 4, 1);
+        batch.remove(CardId{MaterialRegistry::instance().find("Stone"), 1});
+        batch.add(Card("Plank", 1, CardType::BUILDING, 2));
+
+        REQUIRE(inventory.canApply(batch));
+        REQUIRE(inventory.apply(batch));
+        REQUIRE(inventory.getVersion() == before + 1);
+
+        // Rarity 1 was drained and erased, the rest came from rarity 2
+        const auto& cards = inventory.getCards();
+        REQUIRE(cards.size() == 2);
+        REQUIRE(cards[0].name == "Wood");
+        REQUIRE(cards[0].rarity == 2);
+        REQUIRE(cards[0].quantity == 1);
+        REQUIRE(cards[1].name == "Plank");
+        REQUIRE(inventory.findCard("Wood", 1) == nullptr);
+        REQUIRE(inventory.findCard("Stone", 1) == nullptr);
+        REQUIRE(inventory.findCard("Plank", 1)->quantity == 2);
+
+        std::vector<InventoryDelta> deltas;
+        REQUIRE(inventory.changesSince(before, deltas));
+        REQUIRE(deltas.size() == 4);
+    }
+
+    SECTION("An invalid batch leaves the inventory untouched") {
+        uint64_t before = inventory.getVersion();
+        InventoryBatch batch;
+        batch.add(Card("Plank", 1, CardType::BUILDING, 2));
+        batch.removeAnyRarity(wood, 3, 1);
+        batch.removeAnyRarity(wood, 3, 1);  // Only 5 Wood in total
+
+        REQUIRE_FALSE(inventory.canApply(batch));
+        REQUIRE_FALSE(inventory.apply(batch));
+        REQUIRE(inventory.getVersion() == before);
+        REQUIRE(inventory.getCards().size() == 3);
+        REQUIRE(inventory.findCard("Plank", 1) == nullptr);
+        REQUIRE(inventory.findCard("Wood", 1)->quantity == 3);
+    }
+
+    SECTION("Removals can consume cards added earlier in the batch") {
+        InventoryBatch batch;
+        batch.add(Card("Stone", 1, CardType::BUILDING, 2));
+        batch.remove(CardId{MaterialRegistry::instance().find("Stone"), 1}, 3);
+
+        REQUIRE(inventory.apply(batch));
+        REQUIRE(inventory.findCard("Stone", 1) == nullptr);
+        REQUIRE(inventory.getCards().size() == 2);
+    }
+
+    SECTION("Removing a missing stack or a negative amount is rejected") {
+        InventoryBatch missing;
+        missing.remove(CardId{wood, 3});
+        REQUIRE_FALSE(inventory.apply(missing));
+
+        InventoryBatch negative;
+        negative.remove(CardId{wood, 1}, -1);
+        REQUIRE_FALSE(inventory.apply(negative));
+        REQUIRE(inventory.findCard("Wood", 1)->quantity == 3);
+    }
+
+    SECTION("Adding a negative amount is rejected") {
+        uint64_t before = inventory.getVersion();
+        InventoryBatch negative;
+        negative.add(Card("Wood", 1, CardType::BUILDING, -5));
+        REQUIRE_FALSE(inventory.canApply(negative));
+        REQUIRE_FALSE(inventory.apply(negative));
+        REQUIRE(inventory.getVersion() == before);
+        REQUIRE(inventory.findCard("Wood", 1)->quantity == 3);
+    }
+}
+
+TEST_CASE("Inventory card handles", "[Inventory]") {
+    Inventory inventory;
+    inventory.addCard(Card("Wood", 1, CardType::BUILDING, 1));
+    inventory.addCard(Card("Stone", 1, CardType::BUILDING, 2));
+    inventory.addCard(Card("Coal", 1, CardType::FUEL, 1));
+    CardHandle stone = inventory.handleOf(inventory.getCards()[1].getId());
+
+    SECTION("Handles keep resolving after earlier stacks are removed") {
+        REQUIRE(stone);
+        inventory.removeCard("Wood", 1);
+        REQUIRE(inventory.isValid(stone));
+        REQUIRE(inventory.resolve(stone)->name == "Stone");
+        REQUIRE(inventory.snapshot()->resolve(stone)->name == "Stone");
+        REQUIRE(inventory.snapshot()->handles[0] == stone);
+    }
+
+    SECTION("Handles of removed stacks stop resolving, even once the slot is reused") {
+        inventory.removeCard("Stone", 1);
+        REQUIRE(inventory.isValid(stone));
+        inventory.removeCard("Stone", 1);
+        REQUIRE_FALSE(inventory.isValid(stone));
+        REQUIRE(inventory.resolve(stone) == nullptr);
+
+        inventory.addCard(Card("Iron", 1, CardType::METAL, 1));
+        CardHandle iron = inventory.handleOf(inventory.getCards().back().getId());
+        REQUIRE(iron.index == stone.index);
+        REQUIRE(iron != stone);
+        REQUIRE(inventory.snapshot()->resolve(stone) == nullptr);
+    }
+
+    SECTION("Reordering keeps handles, replacing a stack invalidates them") {
+        CardHandle coal = inventory.handleOf(inventory.getCards()[2].getId());
+        inventory.updateCards({Card("Coal", 1, CardType::FUEL, 1), Card("Stone", 1, CardType::BUILDING, 2)});
+
+        REQUIRE(inventory.resolve(stone) == &inventory.getCards()[1]);
+        REQUIRE(inventory.resolve(coal) == &inventory.getCards()[0]);
+
+        InventoryBatch batch;
+        batch.remove(inventory.getCards()[0].getId());
+        REQUIRE(inventory.apply(batch));
+        REQUIRE_FALSE(inventory.isValid(coal));
+        REQUIRE(inventory.resolve(stone)->name == "Stone");
+    }
+
+    SECTION("A null handle never resolves") {
+        CardHandle none;
+        REQUIRE_FALSE(none);
+        REQUIRE_FALSE(inventory.isValid(none));
+        REQUIRE(inventory.snapshot()->resolve(none) == nullptr);
+        REQUIRE_FALSE(inventory.handleOf(CardId{}));
+    }
+}
+
+TEST_CASE("Inventory queries", "[Inventory]") {
+    Inventory inventory;
+    Card wood("Wood", 1, CardType::BUILDING, 3);
+    wood.setAttribute(AttributeType::WEIGHT, 2.0f);
+    Card fineWood("Wood", 2, CardType::BUILDING, 1);
+    fineWood.setAttribute(AttributeType::WEIGHT, 2.0f);
+    Card iron("Iron", 1, CardType::METAL, 2);
+    iron.setAttribute(AttributeType::WEIGHT, 5.0f);
+    inventory.addCard(wood);
+    inventory.addCard(iron);
+    inventory.addCard(fineWood);
+
+    auto namesOfType = [&inventory](CardType type) {
+        std::vector<std::string> names;
+        inventory.forEachOfType(type, [&names](const Card& card) {
+            names.push_back(card.name + "/" + std::to_string(card.rarity));
+        });
+        return names;
+    };
+
+    SECTION("Counts and membership come from the indices") {
+        REQUIRE(inventory.countOf(wood.getId()) == 3);
+        REQUIRE(inventory.countOf(Card("Wood", 3, CardType::BUILDING).getId()) == 0);
+        REQUIRE(inventory.countOfAnyRarity("Wood") == 4);
+        REQUIRE(inventory.countOfAnyRarity("Unobtainium") == 0);
+        REQUIRE(inventory.contains(iron.getId()));
+        REQUIRE_FALSE(inventory.contains(Card("Iron", 2, CardType::METAL).getId()));
+        REQUIRE(inventory.totalWeight() == Approx(18.0f));
+    }
+
+    SECTION("Type and material visits follow inventory order") {
+        REQUIRE(namesOfType(CardType::BUILDING) == std::vector<std::string>{"Wood/1", "Wood/2"});
+        REQUIRE(namesOfType(CardType::METAL) == std::vector<std::string>{"Iron/1"});
+        REQUIRE(namesOfType(CardType::FOOD).empty());
+
+        int stacks = 0;
+        inventory.forEachOfMaterial(wood.materialId, [&stacks](const Card&) { ++stacks; });
+        REQUIRE(stacks == 2);
+    }
+
+    SECTION("Indices follow removals, batches and replacements") {
+        inventory.removeCard("Wood", 2);
+        REQUIRE(namesOfType(CardType::BUILDING) == std::vector<std::string>{"Wood/1"});
+        REQUIRE(inventory.countOfAnyRarity("Wood") == 3);
+        REQUIRE(inventory.totalWeight() == Approx(16.0f));
+
+        InventoryBatch batch;
+        batch.remove(iron.getId(), 2);
+        batch.add(fineWood);
+        REQUIRE(inventory.apply(batch));
+        REQUIRE(namesOfType(CardType::METAL).empty());
+        REQUIRE(namesOfType(CardType::BUILDING) == std::vector<std::string>{"Wood/1", "Wood/2"});
+        REQUIRE(inventory.totalWeight() == Approx(8.0f));
+
+        inventory.updateCards({fineWood, iron});
+        REQUIRE(namesOfType(CardType::BUILDING) == std::vector<std::string>{"Wood/2"});
+        REQUIRE(inventory.countOfAnyRarity("Wood") == 1);
+        REQUIRE(inventory.countOfAnyRarity("Iron") == 2);
+        REQUIRE(inventory.totalWeight() == Approx(12.0f));
+    }
+}
+
+TEST_CASE("Inventory save files", "[Inventory][SaveManager]") {
+    const std::string path = "test_save_temp.json";
+    SaveManager saveManager(path);
+    auto writeFile = [&](const std::string& content) {
+        std::ofstream file(path);
+        file << content;
+    };
+
+    SECTION("A saved inventory and seed load back") {
+        Inventory inventory;
+        Card sword("Sword", 2, CardType::WEAPON, 1);
+        sword.setAttribute(AttributeType::ATTACK, 7.5f);
+        inventory.addCard(sword);
+        inventory.addCard(Card("Wood", 1, CardType::BUILDING, 12));
+        RandomService& random = RandomService::instance();
+        random.reseed(1234);
+        Rng& crafting = random.stream(RngStream::Crafting);
+        for (int i = 0; i < 10; ++i) {
+            crafting();
+        }
+        REQUIRE(saveManager.saveGame(inventory));
+        std::vector<uint64_t> expected;
+        for (int i = 0; i < 5; ++i) {
+            expected.push_back(crafting());
+        }
+
+        random.reseed(1);
+        Inventory loaded;
+        REQUIRE(saveManager.loadGame(loaded));
+        REQUIRE(random.getSeed() == 1234);
+        // Draws continue from the save point rather than the start of the game
+        std::vector<uint64_t> resumed;
+        for (int i = 0; i < 5; ++i) {
+            resumed.push_back(crafting());
+        }
+        REQUIRE(resumed == expected);
+        const auto& cards = loaded.getCards();
+        REQUIRE(cards.size() == 2);
+        REQUIRE(cards[0].name == "Sword");
+        REQUIRE(cards[0].type == CardType::WEAPON);
+        REQUIRE(cards[0].getAttribute(AttributeType::ATTACK) == 7.5f);
+        REQUIRE(cards[1].quantity == 12);
+    }
+
+    SECTION("Older saves without types or seeds still load") {
+        writeFile(R"({"inventory": {"cards": [{"attributes": {}, "quantity": 3, "rarity": 1, "name": "Stone"}]}})");
+        Inventory loaded;
+        REQUIRE(saveManager.loadGame(loaded));
+        REQUIRE(loaded.getCards().size() == 1);
+        REQUIRE(loaded.getCards()[0].type == CardType::MISC);
+        REQUIRE(loaded.getCards()[0].quantity == 3);
+    }
+
+    SECTION("Bad saves leave the inventory untouched") {
+        Inventory inventory;
+        inventory.addCard(Card("Wood", 1, CardType::BUILDING, 5));
+        const char* badSaves[] = {
+            "",
+            R"({"version": "1.0"})",
+            R"({"inventory": {"cards": [{"name": "Stone", "rarity": 1}]}})",
+            R"({"inventory": {"cards": [{"name": "Stone", "rarity": 1, "quantity": "many"}]}})",
+            R"({"inventory": {"cards": [{"name": "Stone", "rarity": 1, "quantity": 3})",
+            R"({"inventory": {"cards": []}, "rngSeed": 5, "rngStreams": [[1, 2, 3]]})",
+        };
+        for (const char* content : badSaves) {
+            writeFile(content);
+            REQUIRE(!saveManager.loadGame(inventory));
+            REQUIRE(inventory.getCards().size() == 1);
+            REQUIRE(inventory.getCards()[0].name == "Wood");
+        }
+    }
+
+    std::filesystem::remove(path);
+}
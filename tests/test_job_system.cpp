@@ -0,0 +1,225 @@
+#include "../lib/catch2/catch.hpp"
+#include "Core/JobSystem.h"
+#include "Core/TimerWheel.h"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+TEST_CASE("Jobs run and can be waited on", "[JobSystem]") {
+    JobSystem jobs(3);
+    REQUIRE(jobs.getWorkerCount() == 3);
+
+    std::atomic<int> counter{0};
+    std::vector<JobHandle> handles;
+    for (int i = 0; i < 1000; ++i) {
+        handles.push_back(jobs.submit([&counter]() { counter.fetch_add(1); }));
+    }
+    jobs.waitAll(handles);
+    REQUIRE(counter.load() == 1000);
+    for (const auto& handle : handles) {
+        REQUIRE(handle.isDone());
+    }
+
+    // An empty handle is always done
+    JobHandle empty;
+    REQUIRE(empty.isDone());
+    jobs.wait(empty);
+}
+
+TEST_CASE("Job dependencies", "[JobSystem]") {
+    JobSystem jobs(4);
+    std::mutex mutex;
+    std::vector<int> order;
+    auto record = [&](int step) {
+        return [&, step]() {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(step);
+        };
+    };
+
+    JobHandle first = jobs.submit([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        record(1)();
+    });
+    JobHandle second = jobs.submit(record(2), {first});
+    JobHandle third = jobs.submit(record(3), {second, JobHandle()});
+    jobs.wait(third);
+    REQUIRE(order == std::vector<int>{1, 2, 3});
+
+    // Depending on a finished job queues at once
+    JobHandle late = jobs.submit(record(4), {first});
+    jobs.wait(late);
+    REQUIRE(order.back() == 4);
+}
+
+TEST_CASE("Task graph runs nodes after their dependencies", "[JobSystem]") {
+    JobSystem jobs(4);
+    std::atomic<int> loaded{0};
+    std::atomic<bool> resolvedAfterLoads{false};
+    std::atomic<bool> validatedLast{false};
+
+    TaskGraph graph;
+    std::vector<TaskGraph::Node> loads;
+    for (int i = 0; i < 4; ++i) {
+        loads.push_back(graph.add([&loaded]() { loaded.fetch_add(1); }));
+    }
+    TaskGraph::Node resolve = graph.add([&]() { resolvedAfterLoads = loaded.load() == 4; }, loads);
+    graph.add([&]() { validatedLast = resolvedAfterLoads.load(); }, {resolve});
+
+    // Graphs can be run again, e.g. once per frame
+    for (int frame = 0; frame < 20; ++frame) {
+        loaded = 0;
+        resolvedAfterLoads = false;
+        validatedLast = false;
+        graph.run(jobs);
+        REQUIRE(validatedLast.load());
+    }
+}
+
+TEST_CASE("Parallel for covers every index once", "[JobSystem]") {
+    JobSystem jobs(4);
+    std::vector<int> hits(10007, 0);
+    jobs.parallelFor(hits.size(), 100, [&hits](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            hits[i]++;
+        }
+    });
+    for (int hit : hits) {
+        REQUIRE(hit == 1);
+    }
+}
+
+TEST_CASE("Failing jobs still complete", "[JobSystem]") {
+    JobSystem jobs(2);
+    bool ranAfter = false;
+    JobHandle failing = jobs.submit([]() { throw std::runtime_error("test failure"); });
+    JobHandle after = jobs.submit([&ranAfter]() { ranAfter = true; }, {failing});
+    jobs.wait(after);
+    REQUIRE(failing.isDone());
+    REQUIRE(ranAfter);
+
+    JobHandle slow = jobs.submit([]() { std::this_thread::sleep_for(std::chrono::milliseconds(100)); });
+    REQUIRE_FALSE(jobs.waitFor(slow, std::chrono::milliseconds(1)));
+    REQUIRE(jobs.waitFor(slow, std::chrono::milliseconds(5000)));
+}
+
+TEST_CASE("Timers fire on the game clock", "[TimerWheel]") {
+    TimerWheel timers(0.01);
+    int once = 0;
+    int every = 0;
+    TimerWheel::TimerId oneShot = timers.schedule(0.05, [&once]() { once++; });
+    timers.scheduleEvery(0.1, [&every]() { every++; });
+    REQUIRE(timers.activeCount() == 2);
+
+    timers.advance(0.04);
+    REQUIRE(once == 0);
+    timers.advance(0.01);
+    REQUIRE(once == 1);
+    REQUIRE_FALSE(timers.isScheduled(oneShot));
+
+    // Recurring timers keep their period across uneven frames
+    for (int frame = 0; frame < 19; ++frame) {
+        timers.advance(0.05);
+    }
+    REQUIRE(every == 10);
+    REQUIRE(timers.activeCount() == 1);
+
+    // A paused clock holds every timer where it is
+    timers.setPaused(true);
+    timers.advance(10.0);
+    REQUIRE(every == 10);
+    timers.setPaused(false);
+    timers.advance(0.1);
+    REQUIRE(every == 11);
+}
+
+TEST_CASE("Timers can be cancelled, also from their own callback", "[TimerWheel]") {
+    TimerWheel timers(0.01);
+    int fired = 0;
+    TimerWheel::TimerId cancelled = timers.schedule(0.5, [&fired]() { fired++; });
+    timers.cancel(cancelled);
+    REQUIRE_FALSE(timers.isScheduled(cancelled));
+    // Stale ids are ignored, even once the slot is reused
+    TimerWheel::TimerId reused = timers.schedule(0.5, [&fired]() { fired += 10; });
+    timers.cancel(cancelled);
+    REQUIRE(timers.isScheduled(reused));
+
+    TimerWheel::TimerId self = TimerWheel::NONE;
+    int selfCount = 0;
+    self = timers.scheduleEvery(0.1, [&]() {
+        if (++selfCount == 3) {
+            timers.cancel(self);
+            // New timers count from the next tick
+            timers.schedule(0.01, [&fired]() { fired += 100; });
+        }
+    });
+    timers.advance(1.0);
+    REQUIRE(selfCount == 3);
+    REQUIRE(fired == 110);
+    REQUIRE(timers.activeCount() == 0);
+}
+
+TEST_CASE("Timers fire in expiry order across wheel levels", "[TimerWheel]") {
+    TimerWheel timers(0.01);
+    std::vector<int> order;
+    // Delays from one tick to several hours, out of order
+    std::vector<double> delays = {7200.0, 0.01, 300.0, 2.55, 2.56, 2.57, 655.35, 655.36, 45.0, 0.5};
+    for (size_t i = 0; i < delays.size(); ++i) {
+        timers.schedule(delays[i], [&order, i]() { order.push_back(static_cast<int>(i)); });
+    }
+    double elapsed = 0.0;
+    while (elapsed < 7300.0) {
+        timers.advance(0.25);
+        elapsed += 0.25;
+    }
+    REQUIRE(order == std::vector<int>{1, 9, 3, 4, 5, 8, 2, 6, 7, 0});
+
+    // The clock itself moves on even with nothing scheduled
+    REQUIRE(timers.now() == Approx(7300.0).epsilon(1e-6));
+}
+
+TEST_CASE("Idle ticks are skipped without changing when timers fire", "[TimerWheel]") {
+    // One wheel steps every tick, the other jumps in large frames
+    auto run = [](int frames) {
+        TimerWheel timers(0.01);
+        std::vector<double> fired;
+        timers.scheduleEvery(1.0, [&]() { fired.push_back(timers.now()); });
+        timers.schedule(3.33, [&]() { fired.push_back(timers.now()); });
+        timers.schedule(7.0, [&]() {
+            fired.push_back(timers.now());
+            timers.schedule(0.05, [&]() { fired.push_back(timers.now()); });
+        });
+        for (int frame = 0; frame < frames; ++frame) {
+            timers.advance(12.0 / frames);
+        }
+        REQUIRE(timers.now() == Approx(12.0).epsilon(1e-6));
+        return fired;
+    };
+    std::vector<double> stepped = run(1200);
+    REQUIRE(stepped.size() == 15);
+    REQUIRE(run(3) == stepped);
+    REQUIRE(run(37) == stepped);
+}
+
+TEST_CASE("Job timers run on the job system without piling up", "[TimerWheel]") {
+    TimerWheel timers(0.01);
+    std::atomic<int> runs{0};
+    std::atomic<bool> release{false};
+    TimerWheel::TimerId id = timers.scheduleEvery(0.01, [&]() {
+        runs.fetch_add(1);
+        while (!release.load()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }, TimerWheel::Dispatch::Job);
+
+    // Expiries while the first run is still busy are skipped
+    timers.advance(0.5);
+    JobHandle running = timers.cancel(id);
+    REQUIRE(running.valid());
+    release = true;
+    JobSystem::instance().wait(running);
+    REQUIRE(runs.load() == 1);
+}